@@ -210,6 +210,8 @@ group "core"
                 '{COPYDIR} "%{wks.location}\\config" "%{wks.location}\\bin\\' .. outputs .. '\\%{prj.name}\\config"',
             }
 
+        filter { "system:windows", "toolset:msc*" }
+            buildoptions { "/Zc:preprocessor" }                 -- conforming preprocessor, needed for __VA_OPT__ (MACRO_FOR_EACH)
         
         filter { "system:windows", "action:gmake2" }  -- MinGW specific settings
             links
@@ -275,6 +277,8 @@ group "tests"
             "src/util/data_structures/deletion_queue.cpp",
             "src/util/data_structures/type_deletion_queue.h",
             "src/util/data_structures/type_deletion_queue.cpp",
+            "src/util/data_structures/thread_pool.h",
+            "src/util/data_structures/thread_pool.cpp",
 
             "src/util/math/random.cpp",
             "src/util/math/math.cpp",
@@ -286,12 +290,58 @@ group "tests"
             "src/util/io/serializer_yaml.cpp",
             "src/util/io/serializer_binary.h",
             "src/util/io/serializer_binary.cpp",
+            "src/util/io/mapped_file.h",
+            "src/util/io/mapped_file.cpp",
+            "src/util/io/compression.h",
+            "src/util/io/compression.cpp",
+            "src/util/io/checksum.h",
+            "src/util/io/checksum.cpp",
+            "src/util/io/atomic_file_writer.h",
+            "src/util/io/atomic_file_writer.cpp",
+            "src/util/io/file_watcher.h",
+            "src/util/io/file_watcher.cpp",
+            "src/util/io/directory_crawler.h",
+            "src/util/io/directory_crawler.cpp",
+            "src/util/io/yaml_reader.h",
+            "src/util/io/yaml_reader.cpp",
+            "src/util/io/package.h",
+            "src/util/io/package.cpp",
+
+            "src/project/project.h",
+            "src/project/project_index.h",
+            "src/project/project_index.cpp",
+            "src/project/project_search.h",
+            "src/project/project_search.cpp",
+            "src/project/project_query.h",
+            "src/project/project_query.cpp",
+            "src/project/project_store.h",
+            "src/project/project_store.cpp",
+            "src/project/project_conflicts.h",
+            "src/project/project_conflicts.cpp",
+            "src/project/project_creator.h",
+            "src/project/project_creator.cpp",
+            "src/project/project_statistics.h",
+            "src/project/project_statistics.cpp",
+            "src/project/project_archiver.h",
+            "src/project/project_archiver.cpp",
+            "src/project/dependency_graph.h",
+            "src/project/dependency_graph.cpp",
+            "src/util/data_structures/UUID.h",
+            "src/util/data_structures/UUID.cpp",
+            "src/util/data_structures/string_pool.h",
+            "src/util/data_structures/string_pool.cpp",
+            "src/util/data_structures/lru_list.h",
 
 
             "src/util/data_structures/string_manipulation.cpp",
             "src/util/system.cpp",
         }
 
+        removefiles
+        {
+            "testing/fuzz/**",                                  -- built by the [yaml_fuzz] project
+        }
+
         includedirs
         {
             "src",
@@ -394,6 +444,84 @@ group "tests"
                 "%{vendor_path.glew}/lib/Release/x64",
             }
 
+        filter { "system:windows", "toolset:msc*" }
+            buildoptions { "/Zc:preprocessor" }                 -- conforming preprocessor, needed for __VA_OPT__ (MACRO_FOR_EACH)
+
+        filter "configurations:Debug"
+            defines "DEBUG"
+            runtime "Debug"
+            symbols "on"
+
+        filter "configurations:RelWithDebInfo"
+            defines "RELEASE_WITH_DEBUG_INFO"
+            runtime "Release"
+            symbols "on"
+            optimize "on"
+
+        filter "configurations:Release"
+            defines "RELEASE"
+            runtime "Release"
+            symbols "off"
+            optimize "on"
+
+    project "yaml_fuzz"                                         -- fuzz and differential harness for serializer::yaml, see testing/fuzz/yaml_fuzz.cpp
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++20"
+        staticruntime "on"
+
+        targetdir ("%{wks.location}/bin/" .. outputs .. "/%{prj.name}")
+        objdir ("%{wks.location}/bin-int/" .. outputs .. "/%{prj.name}")
+
+        files
+        {
+            "testing/fuzz/**.h",
+            "testing/fuzz/**.cpp",
+
+            "src/util/timing/stopwatch.cpp",
+            "src/util/data_structures/string_manipulation.cpp",
+            "src/util/data_structures/thread_pool.cpp",
+            "src/util/io/io.cpp",
+            "src/util/io/atomic_file_writer.cpp",
+            "src/util/io/logger.cpp",
+            "src/util/io/serializer_yaml.cpp",
+            "src/util/system.cpp",
+        }
+
+        includedirs
+        {
+            "src",
+            "testing",
+            "%{IncludeDir.glm}",
+            "%{IncludeDir.ImGui}",
+        }
+
+        filter "system:linux"
+            systemversion "latest"
+            defines "PLATFORM_LINUX"
+            links { "pthread", "Qt5Core", "Qt5Widgets", "Qt5Gui" }   -- Qt is used by util/system.cpp
+            buildoptions { "-msse4.1", "-fPIC", "-Wall", "-Wno-dangling-else" }
+            externalincludedirs
+            {
+                "/usr/include/x86_64-linux-gnu/qt5",
+                "/usr/include/x86_64-linux-gnu/qt5/QtCore",
+                "/usr/include/x86_64-linux-gnu/qt5/QtWidgets",
+                "/usr/include/x86_64-linux-gnu/qt5/QtGui",
+            }
+
+        filter { "system:linux", "toolset:clang" }              -- libFuzzer target, otherwise the deterministic driver in main() is used
+            defines "AT_LIBFUZZER"
+            buildoptions { "-fsanitize=fuzzer,address,undefined" }
+            linkoptions { "-fsanitize=fuzzer,address,undefined" }
+
+        filter "system:windows"
+            systemversion "latest"
+            defines { "PLATFORM_WINDOWS", "UNICODE", "_UNICODE" }
+            links { "comdlg32", "shell32" }
+
+        filter { "system:windows", "toolset:msc*" }
+            buildoptions { "/Zc:preprocessor" }
+
         filter "configurations:Debug"
             defines "DEBUG"
             runtime "Debug"
@@ -36,13 +36,29 @@ namespace AT {
         ASSERT(!s_instance, "", "Application already exists");
         LOG_INIT
         s_instance = this;
+
+        // ----------- settings (both sections are loaded in parallel while the platform is initialized) -----------
+        window_attrib window_attributes{};
+        std::future<void> settings_loading = std::async(std::launch::async, [this, &window_attributes]() {
+
+            const std::filesystem::path executable_path = util::get_executable_path();
+            serializer::load_many({
+                { config::get_filepath_from_configtype(executable_path, config::file::app_settings), "general_settings", [this, &window_attributes](serializer::yaml& yaml) {
+                    yaml.entry("long_startup_process", m_long_startup_process)
+                        .entry("display_name", window_attributes.title)
+                        .entry("logo_path", window_attributes.logo_path);
+                } },
+                { config::get_filepath_from_configtype(executable_path, config::file::ui), "theme", [](serializer::yaml& yaml) { UI::imgui_config::serialize_theme(yaml); } },
+            });
+        });
     
         // ----------- general subsystems -----------
     #if defined(PLATFORM_LINUX)
         util::init_qt();
     #endif
         set_fps_settings(m_target_fps);
-        s_window = std::make_shared<window>();
+        settings_loading.wait();                // the window needs its title and icon, the imgui_config the theme
+        s_window = std::make_shared<window>(window_attributes);
         s_window->set_event_callback(BIND_FUNCTION(application::on_event));
 
         // ----------- general subsystems -----------
@@ -64,6 +80,7 @@ namespace AT {
         PROFILE_APPLICATION_FUNCTION();
 
         m_dashboard.reset();
+        config::shutdown();                  // write config changes that are still waiting for the background flush
         AT::crash_handler::unsubscribe(m_crash_subscription);
 		m_imgui_config.reset();
         
@@ -82,10 +99,7 @@ namespace AT {
         PROFILE_APPLICATION_FUNCTION();
 
         // ---------------------------------------- finished setup ----------------------------------------
-        bool long_startup_process = false;
-		AT::serializer::yaml(config::get_filepath_from_configtype(util::get_executable_path(), config::file::app_settings), "general_settings", AT::serializer::option::load_from_file)
-			.entry(KEY_VALUE(long_startup_process));
-
+        const bool long_startup_process = m_long_startup_process;
         LOG(Info, "long_startup_process [" << util::to_string(long_startup_process) << "]")
 
         s_running = true;
@@ -133,6 +147,7 @@ namespace AT {
 
             // PROFILE_SCOPE("run")
             s_window->poll_events();                        // update internal state
+            m_imgui_config->update();                       // reapply the UI theme if its config file changed on disk
             m_dashboard->update(m_delta_time);
             m_renderer->draw_frame(m_delta_time);
             limit_fps();
@@ -158,6 +158,7 @@ namespace AT {
         static bool					        s_running;
 
         ref<dashboard>                      m_dashboard;
+        bool                                m_long_startup_process = false;     // loaded with the other startup settings, see [serializer::load_many]
         u64                                 m_crash_subscription = 0;
         bool						        m_focus = true;
         bool                                m_is_titlebar_hovered = false;
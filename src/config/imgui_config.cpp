@@ -30,7 +30,7 @@
 namespace AT::UI {
 
 
-	GETTER_REF_FUNC_IMPL(ImVec4, main_color);
+	GETTER_REF_FUNC_IMPL2(ImVec4, main_color, ImVec4(.0f, .4088f, 1.0f, 1.f));
 	GETTER_REF_FUNC_IMPL(ImVec4, main_titlebar_color);
 
 	GETTER_REF_FUNC_IMPL(ImVec4, action_color_00_faded);
@@ -123,28 +123,20 @@ namespace AT::UI {
 		application::get().get_renderer()->imgui_init();
 		
 
-		main_color = { .0f,	.4088f,	1.0f,	1.f };
-		g_window_border = false;
-		g_highlighted_window_bg = LERP_GRAY(0.57f);
-
-		serialize(serializer::option::load_from_file);
-
-		main_titlebar_color = LERP_MAIN_COLOR_DARK(.5f);			// lerp after loading main color
-		action_color_00_faded = LERP_MAIN_COLOR_DARK(0.5f);
-		action_color_00_weak = LERP_MAIN_COLOR_DARK(0.6f);
-		action_color_00_default = LERP_MAIN_COLOR_DARK(0.7f);
-		action_color_00_hover = LERP_MAIN_COLOR_DARK(0.85f);
-		action_color_00_active = LERP_MAIN_COLOR_DARK(1.f);
+		update_main_color_variants();								// lerp the main color of the theme the application loaded
 	
 		load_fonts();
 		update_UI_theme();
 
+		m_config_subscription = config::subscribe(config::file::ui, [this](config::file) { m_reload_theme = true; });
+
 		LOG_INIT 
 	}
 
 
 	imgui_config::~imgui_config() { 
 				
+		config::unsubscribe(m_config_subscription);
 		application::get().get_renderer()->imgui_shutdown();
 		ImGui::DestroyContext(m_context_imgui);
 		ImPlot::DestroyContext(m_context_implot);
@@ -154,6 +146,36 @@ namespace AT::UI {
 	}
 
 
+	void imgui_config::update() {
+
+		if (!m_reload_theme.exchange(false))
+			return;
+
+		LOG(Trace, "UI config changed on disk, reapplying theme");
+		const std::array<f32, 5> previous_font_sizes = { g_font_size, g_big_font_size, g_font_size_header_0, g_font_size_header_1, g_font_size_header_2 };
+		serialize(serializer::option::load_from_file);
+		update_main_color_variants();
+
+		const std::array<f32, 5> font_sizes = { g_font_size, g_big_font_size, g_font_size_header_0, g_font_size_header_1, g_font_size_header_2 };
+		if (font_sizes != previous_font_sizes)
+			load_fonts();
+
+		update_UI_theme();
+		enable_window_border(g_window_border);
+	}
+
+
+	void imgui_config::update_main_color_variants() {
+
+		main_titlebar_color = LERP_MAIN_COLOR_DARK(.5f);
+		action_color_00_faded = LERP_MAIN_COLOR_DARK(0.5f);
+		action_color_00_weak = LERP_MAIN_COLOR_DARK(0.6f);
+		action_color_00_default = LERP_MAIN_COLOR_DARK(0.7f);
+		action_color_00_hover = LERP_MAIN_COLOR_DARK(0.85f);
+		action_color_00_active = LERP_MAIN_COLOR_DARK(1.f);
+	}
+
+
 	ImFont* imgui_config::get_font(const font_type type) {
 
 		if (m_fonts.contains(type))
@@ -165,8 +187,14 @@ namespace AT::UI {
 
 	void imgui_config::serialize(serializer::option option) {
 
-		AT::serializer::yaml(config::get_filepath_from_configtype(util::get_executable_path(), config::file::ui), "theme", option)			// load general appearance settings
-			.entry(KEY_VALUE(g_font_size))
+		AT::serializer::yaml yaml(config::get_filepath_from_configtype(util::get_executable_path(), config::file::ui), "theme", option);
+		serialize_theme(yaml);
+	}
+
+
+	void imgui_config::serialize_theme(AT::serializer::yaml& yaml) {
+
+		yaml.entry(KEY_VALUE(g_font_size))			// general appearance settings
 			.entry(KEY_VALUE(g_font_size_header_0))
 			.entry(KEY_VALUE(g_font_size_header_1))
 			.entry(KEY_VALUE(g_font_size_header_2))
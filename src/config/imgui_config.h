@@ -7,6 +7,8 @@
 #include "util/io/serializer_data.h"
 #include "util/io/config.h"
 
+namespace AT::serializer { class yaml; }
+
 
 namespace AT::UI {
 
@@ -60,7 +62,7 @@ namespace AT::UI {
 	inline f32 g_big_font_size = 18.f; 							// Font size for emphasized text.
 	inline theme_selection g_UI_theme = theme_selection::dark; 	// Currently selected UI theme.
 	inline bool g_window_border = false; 						// Whether window borders are enabled.
-	inline ImVec4 g_highlighted_window_bg; 						// Highlighted background color for selected windows.
+	inline ImVec4 g_highlighted_window_bg = LERP_GRAY(0.57f);	// Highlighted background color for selected windows.
 
 	GETTER_REF_FUNC(ImVec4, main_color);
 	GETTER_REF_FUNC(ImVec4, main_titlebar_color);
@@ -119,6 +121,16 @@ namespace AT::UI {
 		// @param option Choose between loading or saving settings.
 		void serialize(AT::serializer::option option);
 
+		// Reads or writes the entries of the [theme] section of [config::file::ui]. The application loads them together with
+		// its other startup settings (see serializer::load_many()) before the imgui_config is created.
+		static void serialize_theme(AT::serializer::yaml& yaml);
+
+
+		// Applies theme changes made to the UI config file on disk (by another launcher instance or an editor).
+		// The file is watched on a background thread, the change is applied here so ImGui is only touched by the main thread.
+		// @note !! IMPORTANT !! - Do not call during rendering. Call it during update
+		void update();
+
 
 		// Resizes fonts based on a single base size.
 		// @note !! IMPORTANT !! - Do not call during rendering. Call it during update
@@ -150,10 +162,16 @@ namespace AT::UI {
 		void load_fonts();
 
 
+		// Derives the titlebar and action colors from [main_color].
+		void update_main_color_variants();
+
+
 		// ------------------------- General -------------------------
 		ImGuiContext* 								m_context_imgui{}; 		// Pointer to the ImGui context.
 		ImPlotContext* 								m_context_implot{}; 	// Pointer to the ImPlot context.
 		std::unordered_map<font_type, ImFont*> 		m_fonts{}; 				// Loaded fonts mapped by name.
+		u32											m_config_subscription = 0;	// Watches the UI config file for changes on disk.
+		std::atomic<bool>							m_reload_theme = false;		// Set by the watcher thread, handled in update().
 
 
 		// ------------------------- Performance display -------------------------
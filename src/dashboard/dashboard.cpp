@@ -16,6 +16,7 @@
 #include "application.h"
 #include "render/image.h"
 #include "project/project.h"
+#include "project/project_store.h"
 
 #include "dashboard.h"
 
@@ -31,6 +32,18 @@ namespace AT {
 	#define FONT_MONOSPACE              application::get().get_imgui_config_ref()->get_font(UI::font_type::monospace_regular)
 
 
+	// e.g. "1.4 GB"
+	static void format_bytes(const u64 bytes, char* buffer, const size_t size) {
+
+		static constexpr const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+		f64 value = static_cast<f64>(bytes);
+		u32 unit = 0;
+		for (; value >= 1024. && unit < IM_ARRAYSIZE(units) - 1; unit++)
+			value /= 1024.;
+		std::snprintf(buffer, size, unit ? "%.1f %s" : "%.0f %s", value, units[unit]);
+	}
+
+
     dashboard::dashboard() {
 		
 		const std::filesystem::path icon_path = ASSET_PATH / "icons";
@@ -97,7 +110,10 @@ namespace AT {
 
         PROFILE_APPLICATION_FUNCTION();
 
-		create_dummy_projects();
+		load_project_index();					// projects of the last session, shown right away
+		load_dependency_catalog();				// plugins, libraries and engines the projects are resolved against
+		start_project_discovery();				// picks up new, changed and deleted projects in the background
+		start_project_watching();				// and keeps the list current while the launcher is open
 
 		// ------ DEV-ONLY ------
 		m_current_section = ui_section::user;
@@ -111,6 +127,13 @@ namespace AT {
     bool dashboard::shutdown() {
 
         PROFILE_APPLICATION_FUNCTION();
+
+		stop_project_creation();
+		stop_project_package();
+		stop_project_statistics();
+		stop_project_watching();
+		stop_project_discovery();
+		save_project_index();
         LOG_SHUTDOWN
         return true;
     }
@@ -125,6 +148,10 @@ namespace AT {
     void dashboard::update(f32 delta_time) {
 
         PROFILE_APPLICATION_FUNCTION();
+
+		collect_discovered_projects();			// projects found by the background search since the last frame
+		update_project_watches();				// projects that changed on disk
+		collect_project_statistics();			// sizes and asset counts computed in the background
     }
 
 
@@ -146,7 +173,7 @@ namespace AT {
 		ImGui::Begin("main_content_area", nullptr, flags);
 		ImGui::PopStyleVar(3);
 
-		sidebar(80.f);		// sidebar_width
+		sidebar(config::get(config::keys::dashboard::sidebar_width));
 		UI::separation_vertical();
 
 		// Main content area
@@ -276,7 +303,7 @@ namespace AT {
 
 				UI::shift_cursor_pos(0, 40);
 				UI::text(FONT_HEADER_1, "Recent Projects");
-				// projects_grid();
+				recent_projects();
 				break;
 				
 			case ui_section::projects: {
@@ -313,113 +340,308 @@ namespace AT {
 	void dashboard::projects_grid() {
 	
 		const f32 available_width = ImGui::GetContentRegionAvail().x;
-		const f32 number_of_cards = std::floor(available_width / 200.f);
+		const f32 number_of_cards = std::max(std::floor(available_width / config::get(config::keys::dashboard::project_card_width)), 1.f);
 		const f32 item_width = (available_width / number_of_cards) - 7.f;
-		const f32 item_height = 250.f;
+		const f32 item_height = config::get(config::keys::dashboard::project_card_height);
 		const ImVec2 item_size(item_width, item_height);
 		const f32 padding = 0.f;
-		const ImVec4 card_bg_color = ImVec4(0.1f, 0.1f, 0.1f, 1.f);				// Darker gray
-		const ImVec4 card_hover_color = ImVec4(0.18f, 0.18f, 0.18f, 1.f);
-		const ImVec4 border_color = ImVec4(0.3f, 0.3f, 0.3f, 1.f);
 		
 		ImGui::PushFont(FONT_HEADER_0);
 		ImGui::Text("Recent Projects");
 		ImGui::PopFont();
+
+		ImGui::SameLine();
+		const f32 search_width = std::min(300.f, available_width * .5f);
+		ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x - search_width);
+		ImGui::SetNextItemWidth(search_width);
+		UI::search_input("##project_search", m_project_search);
+
+		// sorted, filtered and grouped before the search, so the facets count all projects that pass the filters
+		const std::span<const u32> sorted = query_projects(m_project_query);
+		projects_view_controls();
 		ImGui::Separator();
 		
 		int items_per_row = available_width / (item_width + padding);
 		if (items_per_row < 1)  items_per_row = 1;
 		
-		int i = 0;
-		for (const auto& project : get_user_projects_ref()) {
-			if (i++ % items_per_row != 0)
+		// indices into the project store
+		const project_store& projects = get_project_store();
+		const project_query& query = get_project_query();
+		if (!m_project_search.empty()) {
+
+			int i = 0;
+			for (const u32 index : search_projects(m_project_search)) {			// best match first
+				if (!query.matches(index))
+					continue;
+
+				if (i++ % items_per_row != 0)
+					ImGui::SameLine();
+				project_card(projects, index, item_size);
+			}
+			return;
+		}
+
+		for (const auto& group : query.get_groups()) {
+
+			if (!group.label.empty()) {
+				ImGui::PushFont(FONT_HEADER_1);
+				ImGui::Text("%.*s (%u)", static_cast<int>(group.label.size()), group.label.data(), group.count);
+				ImGui::PopFont();
+			}
+
+			// a project is listed in every group of its tags
+			ImGui::PushID(group.first);
+			for (u32 x = 0; x < group.count; x++) {
+				if (x % items_per_row != 0)
+					ImGui::SameLine();
+				project_card(projects, sorted[group.first + x], item_size);
+			}
+			ImGui::PopID();
+		}
+	}
+
+
+	// one row of the last opened projects, looked up by ID without sorting the project list
+	void dashboard::recent_projects() {
+
+		const f32 available_width = ImGui::GetContentRegionAvail().x;
+		const f32 number_of_cards = std::max(std::floor(available_width / config::get(config::keys::dashboard::project_card_width)), 1.f);
+		const ImVec2 item_size((available_width / number_of_cards) - 7.f, config::get(config::keys::dashboard::project_card_height));
+
+		const project_store& projects = get_project_store();
+		u32 shown = 0;
+		ImGui::PushID("recent_projects");
+		for (const UUID& id : get_recent_projects()) {
+
+			if (shown == static_cast<u32>(number_of_cards))
+				break;
+
+			const std::optional<u32> index = projects.find(id);
+			if (!index)
+				continue;														// removed since it was opened
+
+			if (shown++ != 0)
 				ImGui::SameLine();
-			
-			// Start card container
-			ImGui::PushStyleColor(ImGuiCol_ChildBg, card_bg_color);
-			ImGui::PushStyleColor(ImGuiCol_Border, border_color);
-			ImGui::PushStyleVar(ImGuiStyleVar_ChildBorderSize, 0.0f);
-			ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 4.0f);
-			
-			ImGui::BeginChild(project.name.c_str(), item_size, true);
-			
-			// Card header - thumbnail
-			ImGui::SetCursorPos(ImVec2(10, 10));
-			ImGui::Button("Project Thumbnail", ImVec2(item_width - 20, 150));
-			
-			// Card body - title and description
-			ImGui::SetCursorPos(ImVec2(10, 170));
-			ImGui::PushTextWrapPos(item_width - 20);
-			ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "%s", project.display_name.c_str());
-			
-			ImGui::SetCursorPos(ImVec2(10, 190));
-			ImGui::TextDisabled("%s", project.description.c_str());
-			ImGui::PopTextWrapPos();
-			
-			ImGui::EndChild();
-			ImGui::PopStyleVar(2);
-			ImGui::PopStyleColor(2);
-			
-			switch (UI::get_mouse_interation_on_item()) {
-				case UI::mouse_interation::hovered: {
+			project_card(projects, *index, item_size);
+		}
+		ImGui::PopID();
 
-					ImGui::GetWindowDrawList()->AddRectFilled(ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), ImGui::GetColorU32(card_hover_color), 4.0f );
-					ImGui::BeginTooltip();
-					
-					// Tooltip content
-					ImGui::PushFont(FONT_HEADER_1);
-					ImGui::TextColored(UI::get_main_color_ref(), "%s", project.display_name.c_str());
-					ImGui::PopFont();
+		if (shown == 0)
+			ImGui::TextDisabled("Projects you open are listed here.");
+	}
+
+
+	void dashboard::projects_view_controls() {
+
+		static constexpr const char* sort_names[] = { "Last modified", "Name", "Engine version", "Project version" };
+		static constexpr const char* group_names[] = { "No groups", "Tag", "Engine version" };
+
+		int sort = static_cast<int>(m_project_query.sort);
+		ImGui::SetNextItemWidth(150);
+		if (ImGui::Combo("##project_sort", &sort, sort_names, IM_ARRAYSIZE(sort_names)))
+			m_project_query.sort = static_cast<project_query::sort_key>(sort);
+
+		ImGui::SameLine();
+		if (ImGui::Button(m_project_query.descending ? "Descending" : "Ascending", ImVec2(100, 0)))
+			m_project_query.descending = !m_project_query.descending;
+
+		ImGui::SameLine();
+		int group = static_cast<int>(m_project_query.group);
+		ImGui::SetNextItemWidth(150);
+		if (ImGui::Combo("##project_group", &group, group_names, IM_ARRAYSIZE(group_names)))
+			m_project_query.group = static_cast<project_query::group_key>(group);
+
+		// engine version facet, counts of the current result
+		const project_query& query = get_project_query();
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(150);
+		const std::string engine_preview = m_project_query.engine_version ? std::format("{}.{}.{}", *m_project_query.engine_version >> 32, (*m_project_query.engine_version >> 16) & 0xFFFF, *m_project_query.engine_version & 0xFFFF) : "All engines";
+		if (ImGui::BeginCombo("##project_engine", engine_preview.c_str())) {
+
+			if (ImGui::Selectable("All engines", !m_project_query.engine_version))
+				m_project_query.engine_version.reset();
+
+			for (const auto& facet : query.get_engine_version_facets()) {
+
+				const std::string label = std::format("{} ({})", facet.label, facet.count);
+				if (ImGui::Selectable(label.c_str(), m_project_query.engine_version == facet.engine_version))
+					m_project_query.engine_version = facet.engine_version;
+			}
+			ImGui::EndCombo();
+		}
+
+		// tag facets, a selected tag is required
+		for (const auto& facet : query.get_tag_facets()) {
+
+			auto& required = m_project_query.required_tags;
+			const auto selected = std::find(required.begin(), required.end(), facet.label);
+			if (facet.count == 0 && selected == required.end())
+				continue;
+
+			ImGui::SameLine();
+			ImGui::PushID(static_cast<int>(facet.id));
+			if (selected != required.end())
+				ImGui::PushStyleColor(ImGuiCol_Button, UI::get_main_color_ref());
+
+			char label[128];
+			std::snprintf(label, sizeof(label), "%.*s (%u)", static_cast<int>(facet.label.size()), facet.label.data(), facet.count);
+			const bool clicked = ImGui::SmallButton(label);
+			if (selected != required.end())
+				ImGui::PopStyleColor();
+			ImGui::PopID();
+
+			if (clicked && selected != required.end())
+				required.erase(selected);
+			else if (clicked)
+				required.emplace_back(facet.label);
+		}
+	}
+
+
+	void dashboard::project_card(const project_store& projects, const u32 index, const ImVec2& item_size) {
+
+		const project_store::cold_fields& project = projects.get_cold(index);
+
+		const f32 item_width = item_size.x;
+		const ImVec4 card_bg_color = ImVec4(0.1f, 0.1f, 0.1f, 1.f);				// Darker gray
+		const ImVec4 card_hover_color = ImVec4(0.18f, 0.18f, 0.18f, 1.f);
+		const ImVec4 border_color = ImVec4(0.3f, 0.3f, 0.3f, 1.f);
+
+		// Start card container
+		ImGui::PushStyleColor(ImGuiCol_ChildBg, card_bg_color);
+		ImGui::PushStyleColor(ImGuiCol_Border, border_color);
+		ImGui::PushStyleVar(ImGuiStyleVar_ChildBorderSize, 0.0f);
+		ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 4.0f);
+		
+		ImGui::BeginChild(projects.c_str(project.name), item_size, true);
+		
+		// Card header - thumbnail
+		ImGui::SetCursorPos(ImVec2(10, 10));
+		ImGui::Button("Project Thumbnail", ImVec2(item_width - 20, 150));
+		
+		// Card body - title and description
+		ImGui::SetCursorPos(ImVec2(10, 170));
+		ImGui::PushTextWrapPos(item_width - 20);
+		ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "%s", projects.get_display_name(index));
+		
+		ImGui::SetCursorPos(ImVec2(10, 190));
+		ImGui::TextDisabled("%s", projects.c_str(project.description));
+		ImGui::PopTextWrapPos();
+
+		// Card footer - asset counts and disk usage, computed in the background
+		const project_statistics& statistics = projects.get_statistics(index);
+		ImGui::SetCursorPos(ImVec2(10, item_size.y - 26));
+		if (statistics.valid) {
+
+			const ImVec2 icon_size(16, 16);
+			const std::pair<const ref<image>&, u32> counts[] = { { m_mesh_asset_icon, statistics.mesh_count }, { m_texture_icon, statistics.texture_count }, { m_material_icon, statistics.material_count } };
+			for (const auto& [icon, count] : counts) {
+
+				ImGui::Image(icon->get(), icon_size);
+				ImGui::SameLine(0, 3);
+				ImGui::TextDisabled("%u", count);
+				ImGui::SameLine();
+			}
+
+			char disk_usage[32];
+			format_bytes(statistics.disk_usage, disk_usage, sizeof(disk_usage));
+			ImGui::SetCursorPosX(item_width - 10 - ImGui::CalcTextSize(disk_usage).x);
+			ImGui::TextDisabled("%s", disk_usage);
+
+		} else
+			ImGui::TextDisabled("Computing size...");
+		
+		ImGui::EndChild();
+		ImGui::PopStyleVar(2);
+		ImGui::PopStyleColor(2);
+		
+		char menu_id[32];
+		std::snprintf(menu_id, sizeof(menu_id), "##project_card_menu_%u", index);
+		switch (UI::get_mouse_interation_on_item()) {
+			case UI::mouse_interation::hovered: {
+
+				ImGui::GetWindowDrawList()->AddRectFilled(ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), ImGui::GetColorU32(card_hover_color), 4.0f );
+				ImGui::BeginTooltip();
+				
+				// Tooltip content
+				ImGui::PushFont(FONT_HEADER_1);
+				ImGui::TextColored(UI::get_main_color_ref(), "%s", projects.get_display_name(index));
+				ImGui::PopFont();
+				ImGui::Separator();
+				
+				// display strings are formatted once by the store
+				ImGui::Text("Path: %s", projects.c_str(project.project_path));
+				ImGui::Text("Version: %s", projects.c_str(project.project_version_text));
+				ImGui::Text("Engine: %s", projects.c_str(project.engine_version_text));
+				ImGui::Text("Last Modified: %s", project.last_modified_text);
+
+				if (statistics.valid) {
 					ImGui::Separator();
-					
-					ImGui::Text("Path: %s", project.project_path.string().c_str());
 
-					{
-						std::ostringstream oss;
-						oss << (u16)project.project_version.major << '-' << (u16)project.project_version.minor << '-' << (u16)project.project_version.patch;
-						ImGui::Text("Version: %s", oss.str().c_str());
-					}
-					
-					{
-						std::ostringstream oss;
-						oss << (u16)project.engine_version.major << '-' << (u16)project.engine_version.minor << '-' << (u16)project.engine_version.patch;
-						ImGui::Text("Engine: %s", oss.str().c_str());
-					}
+					char disk_usage[32];
+					format_bytes(statistics.disk_usage, disk_usage, sizeof(disk_usage));
+					ImGui::Text("Content: %s in %u files", disk_usage, statistics.file_count);
+					ImGui::Text("Meshes: %u  Textures: %u  Materials: %u", statistics.mesh_count, statistics.texture_count, statistics.material_count);
+
+					if (statistics.last_build) {
+						char last_build[32];
+						const std::time_t seconds = static_cast<std::time_t>(statistics.last_build / 1'000'000'000);
+						std::strftime(last_build, sizeof(last_build), "%Y-%m-%d %H:%M", std::localtime(&seconds));
+						ImGui::Text("Last Build: %s", last_build);
+					} else
+						ImGui::Text("Last Build: never");
+				}
+				
+				if (!project.engine_plugins.empty() || !project.external_libraries.empty()) {
 
-					{
-						std::ostringstream oss;
-						oss << (u16)project.last_modified.year << '-' << (u16)project.last_modified.month << '-' << (u16)project.last_modified.day << ' ' 
-							<< (u16)project.last_modified.hour << ':' << (u16)project.last_modified.minute << ':' << (u16)project.last_modified.secund;
-						ImGui::Text("Last Modified: %s", oss.str().c_str());
-					}
-					
-					if (!project.tags.empty()) {						// Display tags
-						ImGui::Separator();
-						ImGui::Text("Tags:");
-						for (const auto& tag : project.tags)
-							ImGui::BulletText("%s", tag.c_str());
+					const dependency_graph::resolution& dependencies = resolve_project_dependencies(index);
+					ImGui::Separator();
+					if (dependencies.is_resolved())
+						ImGui::Text("Dependencies: %u plugins and libraries", static_cast<u32>(dependencies.load_order.size()));
+					else {
+						ImGui::TextColored(ImVec4(.9f, .3f, .3f, 1.f), "Dependencies: %s", dependency_graph::get_status_name(dependencies.state));
+						for (const auto& problem : dependencies.problems)
+							ImGui::BulletText("%s", problem.c_str());
 					}
-					
-					ImGui::EndTooltip();
-				} break;
+				}
 
-				case UI::mouse_interation::left_double_clicked: {
+				if (!project.tags.empty()) {						// Display tags
+					ImGui::Separator();
+					ImGui::Text("Tags:");
+					for (const auto tag : project.tags)
+						ImGui::BulletText("%s", projects.c_str(tag));
+				}
+				
+				ImGui::EndTooltip();
+			} break;
 
-					const std::string project_path = (project.project_path / project.name).replace_extension(".gltproj").generic_string();
+			case UI::mouse_interation::left_double_clicked: {
 
-					// TODO: remove hard coded path 
-					const std::string command = "cd ~/workspace/gluttony/bin/Debug-linux-x86_64/ && ./gluttony_editor/gluttony_editor " + project_path;
-					LOG(Info, "command: " << command)
-					// util::launch_detached_program(command);
-					application::get().close_application();
+				const std::string project_path = (projects.get_project_path(index) / projects.get(project.name)).replace_extension(".gltproj").generic_string();
 
-				} break;
-				
-				default: break;
-			}
+				// TODO: remove hard coded path 
+				const std::string command = "cd ~/workspace/gluttony/bin/Debug-linux-x86_64/ && ./gluttony_editor/gluttony_editor " + project_path;
+				LOG(Info, "command: " << command)
+				mark_project_opened(projects.get_id(index));
+				// util::launch_detached_program(command);
+				application::get().close_application();
 
+			} break;
+
+			case UI::mouse_interation::right_clicked: ImGui::OpenPopup(menu_id); break;
+			
+			default: break;
 		}
 
+		if (ImGui::BeginPopup(menu_id)) {
+
+			if (ImGui::MenuItem("Export Project...", nullptr, false, !get_project_package_progress().is_running())) {
+				auto folder = util::file_dialog("Folder for the project package", {}, true);
+				if (!folder.empty())
+					export_projects({ projects.get_project_path(index) }, folder / (std::string(projects.get(project.name)) + PACKAGE_EXTENTION));
+			}
+			ImGui::EndPopup();
+		}
 	}
 
 
@@ -434,11 +656,135 @@ namespace AT {
 					add_project(result);
 				}
 			}
+
+			ImGui::SameLine();
+			if (ImGui::Button("Add Folder", ImVec2(120, 30))) {
+				auto result = util::file_dialog("Folder to search for Gluttony Projects", {}, true);
+				if (!result.empty()) {
+					LOG(Info, "Searching for projects in: " << result.generic_string());
+					add_project(result);
+				}
+			}
+
+			ImGui::SameLine();
+			if (ImGui::Button("Import Projects", ImVec2(120, 30))) {
+				auto result = util::file_dialog("Folder to import Gluttony Projects from", {}, true);
+				if (!result.empty())
+					import_projects(result);
+			}
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Searches a folder once for projects, without watching it for new ones");
+
+			ImGui::SameLine();
+			if (ImGui::Button("Import Package", ImVec2(120, 30))) {
+				auto package = util::file_dialog("Gluttony Project Package to import", {{"Gluttony Project Package", "gltpkg"}});
+				auto destination = package.empty() ? std::filesystem::path() : util::file_dialog("Folder to extract the projects into", {}, true);
+				if (!destination.empty())
+					import_project_package(package, destination);
+			}
 			
 			ImGui::SameLine();
 			if (ImGui::Button("Create Project", ImVec2(120, 30)))
 				ImGui::OpenPopup("Create New Project");
 
+			if (is_project_discovery_running()) {
+				ImGui::SameLine();
+				ImGui::AlignTextToFramePadding();
+				ImGui::TextDisabled("Searching for projects...");
+			}
+
+			// copies of listed projects, see [project_conflict]
+			const std::vector<project_conflict>& conflicts = get_project_conflicts();
+			if (!conflicts.empty()) {
+
+				ImGui::SameLine();
+				ImGui::Image(m_warning_icon->get(), ImVec2(20, 20));
+				ImGui::SameLine();
+				char label[64];
+				std::snprintf(label, sizeof(label), "%zu duplicate project%s", conflicts.size(), conflicts.size() == 1 ? "" : "s");
+				if (ImGui::Button(label, ImVec2(0, 30)))
+					ImGui::OpenPopup("Duplicate Projects");
+			}
+
+			if (ImGui::BeginPopup("Duplicate Projects")) {
+
+				ImGui::TextUnformatted("These projects have the same ID as a listed project and are not listed.");
+				ImGui::TextDisabled("Remove or re-create one of the copies to list it.");
+				ImGui::Separator();
+				if (ImGui::BeginTable("##duplicate_projects", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY, ImVec2(800, 300))) {
+
+					ImGui::TableSetupColumn("Project", ImGuiTableColumnFlags_WidthFixed, 160.f);
+					ImGui::TableSetupColumn("Folder");
+					ImGui::TableSetupColumn("Listed copy");
+					ImGui::TableHeadersRow();
+					for (const auto& conflict : conflicts) {
+
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(conflict.data.display_name.c_str());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(conflict.data.project_path.generic_string().c_str());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(conflict.listed_path.generic_string().c_str());
+					}
+					ImGui::EndTable();
+				}
+				ImGui::EndPopup();
+			}
+
+			// runs on a worker thread, see [project_creator]
+			const project_creator::progress creation = get_project_creation_progress();
+			if (creation.is_running()) {
+
+				char progress_text[128];
+				if (creation.state == project_creator::stage::copying_files)
+					std::snprintf(progress_text, sizeof(progress_text), "%s %u/%u (%.1f / %.1f MB)", project_creator::get_stage_name(creation.state),
+						creation.copied_files, creation.total_files, creation.copied_bytes / (1024.f * 1024.f), creation.total_bytes / (1024.f * 1024.f));
+				else
+					std::snprintf(progress_text, sizeof(progress_text), "%s", project_creator::get_stage_name(creation.state));
+
+				ImGui::SameLine();
+				ImGui::AlignTextToFramePadding();
+				UI::progressbar_with_text("Creating project", progress_text, creation.get_fraction(), 0.f, 300.f, 20.f);
+				if (ImGui::IsItemHovered() && !creation.message.empty())
+					ImGui::SetTooltip("%s", creation.message.c_str());
+
+				ImGui::SameLine();
+				if (ImGui::Button("Cancel##project_creation", ImVec2(80, 30)))
+					cancel_project_creation();
+
+			} else if (creation.state == project_creator::stage::failed) {
+
+				ImGui::SameLine();
+				ImGui::AlignTextToFramePadding();
+				ImGui::TextColored(ImVec4(.9f, .3f, .3f, 1.f), "Creating the project failed: %s", creation.message.c_str());
+			}
+
+			// export and import of project packages, see [project_archiver]
+			const project_archiver::progress package = get_project_package_progress();
+			if (package.is_running()) {
+
+				char progress_text[128];
+				std::snprintf(progress_text, sizeof(progress_text), "%s %u/%u (%.1f / %.1f MB)", project_archiver::get_stage_name(package.state),
+					package.processed_files, package.total_files, package.processed_bytes / (1024.f * 1024.f), package.total_bytes / (1024.f * 1024.f));
+
+				ImGui::SameLine();
+				ImGui::AlignTextToFramePadding();
+				UI::progressbar_with_text("Project package", progress_text, package.get_fraction(), 0.f, 300.f, 20.f);
+				if (ImGui::IsItemHovered() && !package.message.empty())
+					ImGui::SetTooltip("%s", package.message.c_str());
+
+				ImGui::SameLine();
+				if (ImGui::Button("Cancel##project_package", ImVec2(80, 30)))
+					cancel_project_package();
+
+			} else if (package.state == project_archiver::stage::failed) {
+
+				ImGui::SameLine();
+				ImGui::AlignTextToFramePadding();
+				ImGui::TextColored(ImVec4(.9f, .3f, .3f, 1.f), "Project package failed: %s", package.message.c_str());
+			}
+
 				
 			if (ImGui::IsPopupOpen("Create New Project")) {
 				ImVec2 center = ImGui::GetMainViewport()->GetCenter();
@@ -450,6 +796,7 @@ namespace AT {
 				static char display_name[128] = "New Project";
 				static char file_name[128] = "new_project";
 				static char project_path[256] = "";
+				static char template_path[256] = "";
 				static bool auto_generate = true;
 				static bool file_name_changed_manually = false;
 
@@ -496,20 +843,29 @@ namespace AT {
 						strncpy(project_path, path.generic_string().c_str(), IM_ARRAYSIZE(project_path));
 				}
 
+				// Optional template, its files are copied into the new project
+				ImGui::InputText("Template", template_path, IM_ARRAYSIZE(template_path));
+				ImGui::SameLine();
+				if (ImGui::Button("Browse...##template")) {
+					auto path = util::file_dialog("Template for the new Gluttony Project", {}, true);
+					if (!path.empty())
+						strncpy(template_path, path.generic_string().c_str(), IM_ARRAYSIZE(template_path));
+				}
+
 				ImGui::Separator();
 
 				// Validation and creation
-				bool isValid = strlen(display_name) > 0 && strlen(file_name) > 0 && strlen(project_path) > 0;
+				bool isValid = strlen(display_name) > 0 && strlen(file_name) > 0 && strlen(project_path) > 0 && !get_project_creation_progress().is_running();
 				if (!isValid)
 					ImGui::BeginDisabled();
 				
 				if (ImGui::Button("Create", ImVec2(120, 0))) {
 
-					std::filesystem::path full_path = (std::filesystem::path(project_path) / file_name).replace_extension(".gltproj");
 					project_data data{};
+					data.name = file_name;
 					data.display_name = display_name;
-					data.project_path = full_path;
-					create_project(data);
+					data.project_path = std::filesystem::path(project_path) / file_name;		// the project file is named after [name] inside of this folder
+					create_project(std::move(data), template_path);
 					
 					// Reset for next use
 					strcpy(display_name, "New Project");
@@ -705,7 +1061,7 @@ Early access to our new hybrid ray tracing renderer is now available!
 			UI::text(FONT_HEADER_1, "Quick Stats");
     		ImGui::PopStyleColor();
 			UI::begin_table("quick_stats", false, {0.f, 0.f}, 0.f, true, .25f);
-			UI::table_row_text("Projects:", "%d", get_user_projects_ref().size());
+			UI::table_row_text("Projects:", "%d", get_project_store().size());
 			UI::table_row_editable_text("Team:", team);
 			UI::end_table();
 
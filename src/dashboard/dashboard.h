@@ -1,8 +1,11 @@
 
 #pragma once
 
+#include "project/project_query.h"
 
-namespace AT { class image; }
+struct ImVec2;
+
+namespace AT { class image; class project_store; }
 
 namespace AT {
 
@@ -98,6 +101,9 @@ namespace AT {
         void news_panel();
         void project_control();
         void projects_grid();
+        void recent_projects();
+        void projects_view_controls();
+        void project_card(const project_store& projects, const u32 index, const ImVec2& item_size);
         void user_profile_panel();
 		
 		enum class ui_section {
@@ -110,6 +116,8 @@ namespace AT {
 		
     	bool 				m_show_settings = false;
     	ui_section 			m_current_section = ui_section::home;
+		std::string			m_project_search{};
+		project_query::parameters	m_project_query{};
         
 		ref<image>		    m_logo_icon;
 		ref<image>		    m_home_icon;
@@ -95,21 +95,15 @@ namespace AT {
 			LOG(Trace, "Monitor: " << x << " data: " << xpos << " / " << ypos << " / " << width << " / " << height);
 		}
 
-		// load data from [app_setting.yml]
-		std::filesystem::path logo_path{};
-		AT::serializer::yaml(config::get_filepath_from_configtype(util::get_executable_path(), config::file::app_settings), "general_settings", AT::serializer::option::load_from_file)
-			.entry("display_name", m_data.title)
-			.entry(KEY_VALUE(logo_path));
-	
 		// ensure window is never bigger than possible OR smaller then logical
 		m_data.height = math::clamp((int)m_data.height, 200, max_possible_height);
 		m_data.width = math::clamp((int)m_data.width, 300, max_possible_width);
 		LOG(Trace, "Creating window [" << m_data.title << " width: " << m_data.width << "  height: " << m_data.height << "]");
 		m_Window = glfwCreateWindow(static_cast<int>(m_data.width), static_cast<int>(m_data.height), m_data.title.c_str(), nullptr, nullptr);
 	
-		if (!logo_path.empty()) {
+		if (!m_data.logo_path.empty()) {
 
-        	const auto icon_full_path = util::get_executable_path() / logo_path;
+        	const auto icon_full_path = util::get_executable_path() / m_data.logo_path;
 			if (std::filesystem::exists(icon_full_path)) {
 
 				GLFWimage icon = load_icon(icon_full_path.string());
@@ -26,6 +26,7 @@ namespace AT {
 	struct window_attrib {
 
 		std::string title;                 // Title of the window.
+		std::filesystem::path logo_path{}; // Icon of the window, relative to the executable (none if empty).
 		u32 pos_x = 100;                   // Initial X position of the window.
 		u32 pos_y = 100;                   // Initial Y position of the window.
 		f64 cursor_pos_x{};                // Last known X position of the cursor.
@@ -0,0 +1,301 @@
+#include "util/pch.h"
+
+#include "util/io/serializer_yaml.h"
+
+#include "project.h"
+#include "dependency_graph.h"
+
+
+namespace AT {
+
+	static constexpr u8 COMPATIBLE = 1;
+
+	static u64 pack(const version& value) { return (static_cast<u64>(value.major) << 32) | (static_cast<u64>(value.minor) << 16) | value.patch; }
+
+	static std::string to_text(const version& value) { return std::to_string(value.major) + '.' + std::to_string(value.minor) + '.' + std::to_string(value.patch); }
+
+	// only the definition itself, see get_compatibility() for its dependencies
+	static bool supports(const dependency_definition& definition, const u64 engine) {
+
+		const u64 max_engine = pack(definition.max_engine_version);
+		return pack(definition.min_engine_version) <= engine && (max_engine == 0 || engine <= max_engine);
+	}
+
+
+	void dependency_graph::set_definitions(std::vector<dependency_definition> definitions) {
+
+		PROFILE_FUNCTION();
+
+		m_lookup.clear();
+		m_definitions.clear();
+		m_definitions.reserve(definitions.size());
+		for (auto& definition : definitions) {
+
+			if (m_lookup.contains(definition.name)) {
+
+				LOG(Warn, "Dependency [" << definition.name << "] is defined more than once, only the first definition is used");
+				continue;
+			}
+
+			m_definitions.push_back(std::move(definition));
+			m_lookup.emplace(m_definitions.back().name, static_cast<u32>(m_definitions.size() - 1));		// no reallocation, see reserve()
+		}
+
+		sort_definitions();
+		m_compatibility.clear();
+		m_visited.assign(m_definitions.size(), 0);
+		m_visit = 0;
+		m_generation++;
+	}
+
+
+	void dependency_graph::set_engine_versions(std::vector<version> installed) {
+
+		m_engine_versions = std::move(installed);
+		m_generation++;															// the compatibility does not depend on the installed engines
+	}
+
+
+	bool dependency_graph::load_catalog(const std::filesystem::path& catalog) {
+
+		std::error_code error_code;
+		if (!std::filesystem::exists(catalog, error_code))
+			return false;
+
+		std::vector<version> engine_versions{};
+		std::vector<dependency_definition> definitions{};
+		serializer::yaml(catalog, "dependency_catalog", serializer::option::load_from_file)
+			.entry("engine_versions", engine_versions)
+			.vector("definitions", definitions, [&definitions](serializer::yaml& inner, const u64 x) {
+				inner.fields(definitions[x]);
+			});
+
+		set_definitions(std::move(definitions));
+		set_engine_versions(std::move(engine_versions));
+		LOG(Trace, "Loaded [" << m_definitions.size() << "] dependencies and [" << m_engine_versions.size() << "] engine versions from [" << catalog.generic_string() << "]");
+		return true;
+	}
+
+
+	void dependency_graph::save_catalog(const std::filesystem::path& catalog) {
+
+		serializer::yaml(catalog, "dependency_catalog", serializer::option::save_to_file)
+			.entry("engine_versions", m_engine_versions)
+			.vector("definitions", m_definitions, [this](serializer::yaml& inner, const u64 x) {
+				inner.fields(m_definitions[x]);
+			});
+	}
+
+
+	const dependency_graph::resolution& dependency_graph::resolve(const UUID& id, const version& engine_version, std::span<const std::string_view> dependencies) {
+
+		const u64 engine = pack(engine_version);
+		std::size_t key = 0;
+		math::hash_combine(key, engine);
+		for (const auto& name : dependencies)
+			math::hash_combine(key, name);
+
+		cached_resolution& cached = m_resolutions[id];
+		if (cached.generation == m_generation && cached.key == key)
+			return cached.result;
+
+		PROFILE_FUNCTION();
+
+		m_resolve_count++;
+		cached.key = key;
+		cached.generation = m_generation;
+		resolution& result = cached.result;
+		result = {};
+
+		// the worst problem decides the state, the order of [status]
+		auto report = [&result](const status state, std::string message) {
+
+			if (result.state == status::resolved || state < result.state)
+				result.state = state;
+			result.problems.push_back(std::move(message));
+		};
+
+		if (!m_engine_versions.empty() && std::none_of(m_engine_versions.begin(), m_engine_versions.end(), [engine](const version& installed) { return pack(installed) == engine; }))
+			report(status::engine_not_installed, "Engine [" + to_text(engine_version) + "] is not installed");
+
+		// all definitions the project needs, directly or through other definitions
+		if (++m_visit == 0) {													// wrapped, markers of old visits could match again
+
+			std::fill(m_visited.begin(), m_visited.end(), 0);
+			m_visit = 1;
+		}
+
+		std::vector<u32> roots{};
+		std::vector<u32> pending{};
+		for (const auto& name : dependencies) {
+
+			const auto found = m_lookup.find(name);
+			if (found == m_lookup.end()) {
+
+				report(status::missing, "[" + std::string(name) + "] is not installed");
+				continue;
+			}
+
+			roots.push_back(found->second);
+			if (m_visited[found->second] != m_visit) {
+
+				m_visited[found->second] = m_visit;
+				pending.push_back(found->second);
+			}
+		}
+
+		while (!pending.empty()) {
+
+			const u32 current = pending.back();
+			pending.pop_back();
+			result.load_order.push_back(current);
+
+			for (const auto dependency : m_nodes[current].dependencies) {
+
+				if (m_visited[dependency] != m_visit) {
+
+					m_visited[dependency] = m_visit;
+					pending.push_back(dependency);
+				}
+			}
+		}
+
+		bool acyclic = true;
+		for (const auto current : result.load_order) {
+
+			for (const auto& name : m_nodes[current].missing)
+				report(status::missing, "[" + std::string(name) + "] needed by [" + m_definitions[current].name + "] is not installed");
+
+			if (m_nodes[current].rank == INVALID) {
+
+				report(status::cycle, "[" + m_definitions[current].name + "] depends on itself through its dependencies");
+				acyclic = false;
+			}
+		}
+
+		if (!acyclic) {
+
+			result.load_order.clear();
+			return result;
+		}
+
+		std::sort(result.load_order.begin(), result.load_order.end(), [this](const u32 a, const u32 b) { return m_nodes[a].rank < m_nodes[b].rank; });
+
+		// the cached compatibility covers the dependencies, the definitions are only checked one by one if a root fails
+		const std::vector<u8>& compatibility = get_compatibility(engine);
+		if (std::any_of(roots.begin(), roots.end(), [&compatibility](const u32 root) { return compatibility[root] != COMPATIBLE; })) {
+
+			for (const auto current : result.load_order)
+				if (!supports(m_definitions[current], engine))
+					report(status::incompatible, "[" + m_definitions[current].name + "] does not support engine [" + to_text(engine_version) + "]");
+		}
+
+		return result;
+	}
+
+
+	const dependency_graph::resolution& dependency_graph::resolve(const project_data& project) {
+
+		std::vector<std::string_view> dependencies{};
+		dependencies.reserve(project.engine_plugins.size() + project.external_libraries.size());
+		dependencies.insert(dependencies.end(), project.engine_plugins.begin(), project.engine_plugins.end());
+		dependencies.insert(dependencies.end(), project.external_libraries.begin(), project.external_libraries.end());
+		return resolve(project.ID, project.engine_version, dependencies);
+	}
+
+
+	std::optional<u32> dependency_graph::find(std::string_view name) const {
+
+		const auto found = m_lookup.find(name);
+		return found != m_lookup.end() ? std::optional<u32>(found->second) : std::nullopt;
+	}
+
+
+	const char* dependency_graph::get_status_name(const status value) {
+
+		switch (value) {
+			case status::resolved:					return "Resolved";
+			case status::engine_not_installed:		return "Engine not installed";
+			case status::missing:					return "Missing dependency";
+			case status::cycle:						return "Dependency cycle";
+			case status::incompatible:				return "Incompatible dependency";
+			default:								return "Unknown";
+		}
+	}
+
+
+	// Kahn's algorithm, definitions that are left on a cycle or depend on one keep the rank INVALID
+	void dependency_graph::sort_definitions() {
+
+		const u32 count = static_cast<u32>(m_definitions.size());
+		m_nodes.assign(count, {});
+
+		std::vector<u32> remaining(count, 0);									// dependencies that are not ranked yet
+		std::vector<std::vector<u32>> dependents(count);
+		for (u32 x = 0; x < count; x++) {
+
+			node& current = m_nodes[x];
+			for (const auto& name : m_definitions[x].dependencies) {
+
+				const auto found = m_lookup.find(name);
+				if (found != m_lookup.end())
+					current.dependencies.push_back(found->second);
+				else
+					current.missing.push_back(name);
+			}
+
+			std::sort(current.dependencies.begin(), current.dependencies.end());
+			current.dependencies.erase(std::unique(current.dependencies.begin(), current.dependencies.end()), current.dependencies.end());
+			remaining[x] = static_cast<u32>(current.dependencies.size());
+			for (const auto dependency : current.dependencies)
+				dependents[dependency].push_back(x);
+		}
+
+		std::vector<u32> ready{};
+		for (u32 x = 0; x < count; x++)
+			if (remaining[x] == 0)
+				ready.push_back(x);
+
+		u32 rank = 0;
+		for (size_t x = 0; x < ready.size(); x++) {
+
+			const u32 current = ready[x];
+			m_nodes[current].rank = rank++;
+			for (const auto dependent : dependents[current])
+				if (--remaining[dependent] == 0)
+					ready.push_back(dependent);
+		}
+
+		if (rank != count)
+			LOG(Warn, "[" << count - rank << "] dependencies are on a dependency cycle or depend on one");
+	}
+
+
+	// one pass in topological order, the dependencies of a definition are done before it
+	const std::vector<u8>& dependency_graph::get_compatibility(const u64 engine) {
+
+		auto [entry, inserted] = m_compatibility.try_emplace(engine);
+		if (!inserted)
+			return entry->second;
+
+		const u32 count = static_cast<u32>(m_definitions.size());
+		std::vector<u32> order(count, INVALID);
+		for (u32 x = 0; x < count; x++)
+			if (m_nodes[x].rank != INVALID)
+				order[m_nodes[x].rank] = x;
+
+		std::vector<u8>& compatibility = entry->second;
+		compatibility.assign(count, 0);											// definitions on a cycle stay incompatible
+		for (const auto current : order) {
+
+			if (current == INVALID)
+				break;
+
+			const node& current_node = m_nodes[current];
+			compatibility[current] = supports(m_definitions[current], engine) && current_node.missing.empty()
+				&& std::all_of(current_node.dependencies.begin(), current_node.dependencies.end(), [&compatibility](const u32 dependency) { return compatibility[dependency] == COMPATIBLE; });
+		}
+		return compatibility;
+	}
+
+}
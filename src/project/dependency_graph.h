@@ -0,0 +1,129 @@
+#pragma once
+
+#include "util/pch.h"
+#include "util/data_structures/UUID.h"
+#include "util/io/serializer_data.h"
+
+namespace AT {
+
+	struct project_data;
+
+	// A plugin or external library projects can depend on, with the engine versions it works with.
+	// Plugins and libraries share one set of names.
+	struct dependency_definition {
+		std::string					name{};
+		std::vector<std::string>	dependencies{};				// names of the plugins and libraries it needs
+		version						min_engine_version{};		// oldest supported engine, 0.0.0 for any
+		version						max_engine_version{};		// newest supported engine, 0.0.0 for any
+
+		SERIALIZABLE(dependency_definition, name, dependencies, min_engine_version, max_engine_version);
+	};
+
+
+	// Resolves the plugins and external libraries of projects (see [project_data::engine_plugins]) against the known
+	// definitions and the installed engine versions.
+	// The definitions are sorted topologically once when they are set (Kahn's algorithm), definitions on a dependency cycle
+	// or depending on one are marked then, so resolving a project only collects its dependencies and orders them by rank.
+	// Whether a definition and all its dependencies support an engine version is computed in one pass over the topological
+	// order per engine version and kept, projects sharing plugins reuse it. The resolution of every project is cached by its
+	// ID together with a hash of its engine version and dependency names, unchanged projects are not resolved again.
+	// Not thread-safe, used by the main thread.
+	//
+	//   dependency_graph graph;
+	//   graph.set_definitions(definitions);
+	//   graph.set_engine_versions(installed);
+	//   if (!graph.resolve(project).is_resolved()) { ... }
+	class dependency_graph {
+	public:
+
+		static constexpr u32 INVALID = std::numeric_limits<u32>::max();
+
+		enum class status : u8 {
+			resolved = 0,
+			engine_not_installed,				// the engine version of the project is not installed
+			missing,							// a dependency is not defined
+			cycle,								// dependencies depend on each other
+			incompatible,						// a dependency does not support the engine version of the project
+		};
+
+		struct resolution {
+			status						state = status::resolved;			// the first problem in the order of [status]
+			std::vector<u32>			load_order{};						// definition ids, every definition after the ones it needs
+			std::vector<std::string>	problems{};							// one message per problem
+
+			bool is_resolved() const										{ return state == status::resolved; }
+		};
+
+		dependency_graph() = default;
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(dependency_graph);
+
+		// Replaces the known plugins and libraries, every project is resolved again on its next request.
+		// A definition whose name is already defined is ignored.
+		void set_definitions(std::vector<dependency_definition> definitions);
+
+		// Replaces the installed engine versions, every project is resolved again on its next request.
+		// The engine of a project is not checked while no version is set.
+		void set_engine_versions(std::vector<version> installed);
+
+		// Reads the definitions and the installed engine versions from the YAML file [catalog].
+		// @return false if the file does not exist, nothing is changed then.
+		bool load_catalog(const std::filesystem::path& catalog);
+
+		// Writes the definitions and the installed engine versions to the YAML file [catalog].
+		void save_catalog(const std::filesystem::path& catalog);
+
+		// Resolves the dependencies of the project [id], or returns the cached resolution if its engine version, its
+		// dependencies, the definitions and the installed engines did not change since the last call.
+		// @param dependencies The plugins and libraries of the project.
+		// @return Valid until the next call of a non-const function.
+		const resolution& resolve(const UUID& id, const version& engine_version, std::span<const std::string_view> dependencies);
+
+		// Resolves [project.engine_plugins] and [project.external_libraries], like resolve() above.
+		const resolution& resolve(const project_data& project);
+
+		// Drops the cached resolution of the project [id], e.g. after it was removed.
+		void forget(const UUID& id)											{ m_resolutions.erase(id); }
+
+		u32 get_definition_count() const									{ return static_cast<u32>(m_definitions.size()); }
+		const dependency_definition& get_definition(const u32 id) const		{ return m_definitions[id]; }
+		const std::vector<version>& get_engine_versions() const				{ return m_engine_versions; }
+
+		// @return The id of the definition [name], or std::nullopt if it is not defined.
+		std::optional<u32> find(std::string_view name) const;
+
+		// Number of resolutions that were computed instead of taken from the cache.
+		u64 get_resolve_count() const										{ return m_resolve_count; }
+
+		static const char* get_status_name(const status value);
+
+	private:
+
+		struct node {
+			std::vector<u32>				dependencies{};					// definition ids, sorted and unique
+			std::vector<std::string_view>	missing{};						// names of dependencies that are not defined
+			u32								rank = INVALID;					// position in the topological order, INVALID on or after a cycle
+		};
+
+		struct cached_resolution {
+			u64								key = 0;						// hash of the engine version and the dependency names
+			u32								generation = 0;
+			resolution						result{};
+		};
+
+		void sort_definitions();
+		const std::vector<u8>& get_compatibility(const u64 engine);
+
+		std::vector<dependency_definition>				m_definitions{};
+		std::vector<node>								m_nodes{};							// one per definition
+		std::unordered_map<std::string_view, u32>		m_lookup{};							// [dependency_definition::name] => id
+		std::vector<version>							m_engine_versions{};
+		std::unordered_map<u64, std::vector<u8>>		m_compatibility{};					// packed engine version => per definition, 1 if it and its dependencies support it
+		std::unordered_map<UUID, cached_resolution>		m_resolutions{};
+		std::vector<u32>								m_visited{};						// per definition, [m_visit] if collected by the current resolve()
+		u32												m_visit = 0;
+		u32												m_generation = 0;					// changed by set_definitions() and set_engine_versions()
+		u64												m_resolve_count = 0;
+	};
+
+}
@@ -1,142 +1,712 @@
 
 #include "util/pch.h"
 
+#include "util/io/config.h"
+#include "util/io/directory_crawler.h"
+#include "util/io/file_watcher.h"
+#include "util/system.h"
+
+#include "project_conflicts.h"
+#include "project_index.h"
+#include "project_search.h"
+#include "project_statistics.h"
+#include "project_store.h"
 #include "project.h"
 
 
 namespace AT {
 
-	static std::vector<project_data>						s_user_projects{};
+	static project_store									s_projects{};
+	static project_search									s_search{};					// mirrors the order of [s_projects]
+	static project_query									s_query{};
+	static bool												s_query_outdated = true;		// rebuilt on the next query after [s_projects] changed
+	static project_conflicts								s_conflicts{};					// copies of listed projects, main thread only
+	static constexpr u32									RECENT_PROJECT_COUNT = 16;
+	static util::lru_list<UUID>								s_recent_projects{ RECENT_PROJECT_COUNT };		// main thread only
+	static dependency_graph									s_dependencies{};				// main thread only
+
+	static std::unique_ptr<project_index>					s_index{};
+
+	static std::mutex										s_discovery_mutex{};
+	static std::vector<project_data>						s_discovered_projects{};		// new or changed, found by the crawler threads, guarded by [s_discovery_mutex]
+	static std::vector<std::filesystem::path>				s_removed_projects{};			// [project_path] of deleted projects, guarded by [s_discovery_mutex]
+	static std::unique_ptr<io::directory_crawler>			s_crawler{};					// declared after the containers, its threads are joined before they are destroyed
+	static std::unique_ptr<project_creator>					s_creator{};					// like [s_crawler], reports to [s_discovered_projects]
+	static std::unique_ptr<project_archiver>				s_archiver{};					// like [s_creator]
+	static std::unique_ptr<project_statistics_indexer>		s_statistics{};
+
+	struct project_watch {
+		std::filesystem::path						project_file{};
+		u32											id = 0;						// 0 if the project is polled, the watch limit was reached
+		std::optional<project_index::file_stamp>	stamp{};					// last polled stamp of [project_file]
+	};
+
+	static std::unordered_map<std::string, project_watch>	s_project_watches{};			// generic [project_path] => watch, main thread only
+	static std::vector<u32>									s_root_watches{};
+	static bool												s_roots_polled = false;			// a root could not be watched, the roots are searched every [POLL_INTERVAL]
+	static bool												s_watches_outdated = false;		// the user projects changed, watches have to be added or removed
+	static std::chrono::steady_clock::time_point			s_next_poll{};
+	static std::mutex										s_watch_mutex{};
+	static std::vector<std::filesystem::path>				s_changed_projects{};			// [project_path] of changed projects, guarded by [s_watch_mutex]
+	static bool												s_roots_changed = false;		// guarded by [s_watch_mutex]
+	static std::unique_ptr<io::file_watcher>				s_watcher{};					// declared after the containers, like [s_crawler]
+
+	static constexpr std::chrono::seconds					POLL_INTERVAL{ 30 };
+	static constexpr std::chrono::milliseconds				WATCH_DEBOUNCE{ 500 };			// long enough to see a checkout or build as one change
+
+	static constexpr const char*							PROJECT_INDEX_FILE = "project_index.bin";
+	static constexpr const char*							DEPENDENCY_CATALOG_FILE = "dependency_catalog" CONFIG_FILE_EXTENSION;
+
+	static constexpr std::string_view						DISCOVERY_SECTION = "project_discovery";
+	static constexpr std::string_view						DISCOVERY_ROOTS_KEY = "roots";
+	static constexpr char									DISCOVERY_ROOTS_SEPARATOR = ';';
+	static constexpr std::string_view						RECENT_SECTION = "recent_projects";
+	static constexpr std::string_view						RECENT_IDS_KEY = "ids";
 	
-    std::vector<project_data>& get_user_projects_ref()      { return s_user_projects; }
+    const project_store& get_project_store()                { return s_projects; }
+
+
+	// created on first use from the main thread
+	static project_index& get_project_index() {
+
+		if (!s_index)
+			s_index = std::make_unique<project_index>(util::get_executable_path() / CONFIG_DIR / PROJECT_INDEX_FILE);
+		return *s_index;
+	}
+
+
+	// computed in the background, picked up by collect_project_statistics()
+	static void request_project_statistics(const std::filesystem::path& project_path, const std::filesystem::path& build_path) {
+
+		if (!s_statistics)
+			s_statistics = std::make_unique<project_statistics_indexer>();
+		s_statistics->request(project_path, build_path);
+	}
+
+
+	static void remove_user_project(const std::filesystem::path& project_path);
+
+	// expects to be called from the main thread, the owner of [s_projects]
+	// @return true if the project was added, false if an existing entry was replaced or it is a copy of a listed project
+	static bool add_user_project(const project_data& data) {
+
+		if (const std::optional<std::filesystem::path> listed_path = project_conflicts::find_original(s_projects, data)) {
+
+			remove_user_project(data.project_path);							// in case the project file was replaced by a copy of another project
+			s_conflicts.add(data, *listed_path);
+			return false;
+		}
+
+		if (!data.statistics.valid)
+			request_project_statistics(data.project_path, data.build_path);
+
+		s_query_outdated = true;
+		if (const std::optional<u32> listed = s_projects.find(data.project_path)) {
+
+			s_projects.set(*listed, data);
+			s_search.set(*listed, data);
+			return false;
+		}
+
+		s_projects.add(data);
+		s_search.append(data);
+		s_watches_outdated = true;
+		return true;
+	}
+
+
+	// expects to be called from the main thread, the owner of [s_projects]
+	// the first copy of a removed project is listed instead
+	static void remove_user_project(const std::filesystem::path& project_path) {
+
+		const std::optional<u32> listed = s_projects.find(project_path);
+		if (!listed) {
+
+			s_conflicts.remove(project_path, std::nullopt);
+			return;
+		}
+
+		const UUID id = s_projects.get_id(*listed);
+		s_dependencies.forget(id);
+		s_search.erase(*listed);
+		s_projects.erase(*listed);
+		s_query_outdated = true;
+		s_watches_outdated = true;
+
+		if (const std::optional<project_data> promoted = s_conflicts.remove(project_path, id))
+			add_user_project(*promoted);
+	}
+
+
+	static void load_recent_projects();
+
+	void load_project_index() {
+
+		project_index& index = get_project_index();
+		index.load();
+
+		// the index keeps every project file it found, copies with the same ID are reported as conflicts
+		std::vector<project_data> projects = index.get_projects();
+		s_conflicts.assign(projects);
+		s_projects.assign(projects);
+
+		load_recent_projects();
+		s_search.rebuild(projects);
+		s_query_outdated = true;
+		s_watches_outdated = true;
+
+		// cached statistics are shown right away, changes are picked up by the watches
+		for (const auto& project : projects)
+			if (!project.statistics.valid)
+				request_project_statistics(project.project_path, project.build_path);
+	}
+
+
+	void save_project_index() { get_project_index().save(); }
+
+
+	std::span<const u32> search_projects(std::string_view query) { return s_search.search(query); }
+
+
+	std::span<const u32> query_projects(const project_query::parameters& query) {
+
+		// all changes of a frame cause a single rebuild
+		if (s_query_outdated) {
+
+			s_query.rebuild(s_projects);
+			s_query_outdated = false;
+		}
+		return s_query.execute(query);
+	}
+
+
+	const project_query& get_project_query() { return s_query; }
 
     
-    system_time create_time(int year, int month, int day, int hour, int min, int sec, int ms) {
-		return {
-			static_cast<u16>(year),
-			static_cast<u8>(month),
-			static_cast<u8>(day),
-			static_cast<u8>(0), // day_of_week (we'll leave as 0)
-			static_cast<u8>(hour),
-			static_cast<u8>(min),
-			static_cast<u8>(sec),
-			static_cast<u16>(ms)
-		};
-	}
-
-
-
-	void create_dummy_projects() {
-		s_user_projects.clear();
-		
-		auto add_project = [&](const char* path, const char* display, const char* name, 
-							const version& eng_ver, const version& proj_ver, const char* build_path,
-							const char* start_world, const char* editor_world,
-							const system_time& mod_time, const char* desc, 
-							std::initializer_list<const char*> tag_list) {
-			project_data proj;
-			proj.project_path = path;
-			proj.display_name = display;
-			proj.name = name;
-			proj.engine_version = eng_ver;
-			proj.project_version = proj_ver;
-			proj.build_path = build_path;
-			proj.start_world = start_world;
-			proj.editor_start_world = editor_world;
-			proj.last_modified = mod_time;
-			proj.description = desc;
-			
-			for (const char* tag : tag_list) {
-				proj.tags.push_back(tag);
-			}
-			
-			s_user_projects.push_back(proj);
-		};
-		
-		// Create dummy projects - note explicit version{} construction
-		add_project("~/workspace/gluttony_test_project", "Simple test project", "test_project",
-					version{1, 2, 3}, version{0, 9, 1}, "C:/Builds/RayTracer",
-					"worlds/main_world.glt", "worlds/editor_start.glt",
-					create_time(2025, 3, 15, 14, 30, 15, 500),
-					"Advanced ray tracing implementation with global illumination",
-					{"graphics", "demo", "tech-demo"});
-		
-		add_project("~/workspace/gluttony_test_project", "Physics Simulation", "physics_sim",
-					version{1, 2, 2}, version{1, 0, 0}, "D:/Builds/PhysicsSim",
-					"worlds/physics_demo.glt", "worlds/editor_physics.glt",
-					create_time(2025, 2, 28, 10, 15, 30, 200),
-					"Real-time physics simulation with soft body dynamics",
-					{"physics", "simulation", "educational"});
-		
-		add_project("~/workspace/gluttony_test_project", "Fluid Dynamics", "fluid_sim",
-					version{1, 2, 3}, version{0, 5, 0}, "E:/Builds/FluidSim",
-					"worlds/fluid_demo.glt", "worlds/editor_fluid.glt",
-					create_time(2025, 4, 5, 16, 45, 0, 0),
-					"Real-time fluid simulation using SPH method",
-					{"physics", "fluid", "simulation", "tech-demo"});
-		
-		add_project("~/workspace/gluttony_test_project", "Space Shooter", "space_shooter",
-					version{1, 1, 5}, version{2, 0, 3}, "F:/Builds/SpaceShooter",
-					"worlds/level1.glt", "worlds/editor_level1.glt",
-					create_time(2025, 3, 22, 9, 0, 0, 0),
-					"Top-down space shooter with procedurally generated levels",
-					{"game", "action", "procedural", "arcade"});
-		
-		add_project("~/workspace/gluttony_test_project", "Modern House", "modern_house",
-					version{1, 2, 1}, version{1, 2, 0}, "G:/Builds/HouseDesign",
-					"worlds/house_exterior.glt", "worlds/editor_house.glt",
-					create_time(2025, 4, 10, 13, 20, 45, 750),
-					"Architectural visualization of a modern house design",
-					{"archviz", "design", "realistic", "lighting"});
-		
-		add_project("~/workspace/gluttony_test_project", "AI Behavior Demo", "ai_behavior",
-					version{1, 2, 3}, version{0, 7, 2}, "C:/Builds/AI_Demo",
-					"worlds/ai_test.glt", "worlds/editor_ai.glt",
-					create_time(2025, 3, 30, 11, 10, 30, 0),
-					"Demonstration of advanced AI pathfinding and behavior trees",
-					{"ai", "tech-demo", "pathfinding", "behavior"});
-		
-		add_project("~/workspace/gluttony_test_project", "RPG Prototype", "rpg_prototype",
-					version{1, 2, 0}, version{0, 3, 5}, "D:/Builds/RPG_Prototype",
-					"worlds/village.glt", "worlds/editor_village.glt",
-					create_time(2025, 2, 14, 15, 45, 0, 0),
-					"Prototype for a fantasy RPG with quest system and inventory",
-					{"game", "rpg", "fantasy", "prototype"});
-		
-		add_project("~/workspace/gluttony_test_project", "VR Experience", "vr_showcase",
-					version{1, 2, 3}, version{1, 0, 0}, "E:/Builds/VR_Showcase",
-					"worlds/vr_main.glt", "worlds/editor_vr.glt",
-					create_time(2025, 4, 12, 17, 30, 0, 250),
-					"Immersive VR experience showcasing engine capabilities",
-					{"vr", "tech-demo", "immersive", "experimental"});
-		
-		add_project("~/workspace/gluttony_test_project", "Sculpture Garden", "sculpture_garden",
-					version{1, 1, 8}, version{0, 4, 2}, "F:/Builds/SculptureGarden",
-					"worlds/garden_main.glt", "worlds/editor_garden.glt",
-					create_time(2025, 3, 18, 12, 0, 0, 500),
-					"Virtual art gallery showcasing 3D sculptures in a garden setting",
-					{"art", "gallery", "environment", "showcase"});
-		
-		add_project("~/workspace/gluttony_test_project", "Ray Tracing Demo", "raytracer_demo",
-					version{1, 2, 2}, version{0, 8, 1}, "G:/Builds/SolarSystem",
-					"worlds/solar_system.glt", "worlds/editor_space.glt",
-					create_time(2025, 4, 8, 14, 5, 15, 0),
-					"Educational simulation of our solar system with accurate orbits",
-					{"education", "space", "simulation", "science"});
-	}
-
-
-	void create_project(project_data data) {
-
-		LOG(Info, "creating project [" << data.display_name << "] at [" << data.build_path.generic_string() << "]");
+	bool create_project(project_data data, const std::filesystem::path& template_path) {
+
+		if (!s_creator)
+			s_creator = std::make_unique<project_creator>();
+
+		project_index& index = get_project_index();
+		return s_creator->start(std::move(data), template_path, [&index](const std::filesystem::path& project_file) {
+
+			std::optional<project_data> created = index.update(project_file);
+			if (!created)
+				return;
+
+			index.save();
+			std::lock_guard lock(s_discovery_mutex);
+			s_discovered_projects.push_back(std::move(*created));
+		});
+	}
+
+
+	void cancel_project_creation() {
 
+		if (s_creator)
+			s_creator->cancel();
 	}
 
+
+	void stop_project_creation() {
+
+		if (!s_creator)
+			return;
+
+		s_creator->cancel();
+		s_creator->wait();
+	}
+
+
+	project_creator::progress get_project_creation_progress() { return s_creator ? s_creator->get_progress() : project_creator::progress{}; }
+
 	
 	void add_project(const std::filesystem::path& path) {
 
+		std::error_code error_code;
+		if (std::filesystem::is_directory(path, error_code)) {
+
+			add_discovery_root(path);
+			start_project_discovery();
+			return;
+		}
+
+		VALIDATE(project_data::is_valid_project_path(path), return, "", "[" << path.generic_string() << "] is not a project file");
+
+		std::optional<project_data> data = get_project_index().update(path.lexically_normal());
+		if (!data) {
+
+			LOG(Info, "Project [" << path.generic_string() << "] is already listed");
+			return;
+		}
+
+		add_user_project(*data);
+		save_project_index();
+	}
+
+	// top level only, a new project folder in a root starts a search, changes inside of projects are reported by their own watch
+	static void watch_discovery_root(const std::filesystem::path& root) {
+
+		const u32 id = s_watcher->watch_directory(root, false, [](const std::filesystem::path&) {
+
+			std::lock_guard lock(s_watch_mutex);
+			s_roots_changed = true;
+		});
+
+		if (id)
+			s_root_watches.push_back(id);
+		else
+			s_roots_polled |= s_watcher->is_watch_limit_reached();
+	}
+
+	// ------------------------------- discovery -------------------------------
+
+	void start_project_discovery(const std::vector<std::filesystem::path>& roots) {
+
+		stop_project_discovery();
+
+		const std::vector<std::filesystem::path> search_roots = roots.empty() ? get_discovery_roots() : roots;
+		if (!s_crawler)
+			s_crawler = std::make_unique<io::directory_crawler>();
+
+		// only new and changed project files are parsed and reported, see [project_index]
+		project_index& index = get_project_index();
+		const u32 scan = index.begin_scan();
+		LOG(Trace, "Searching for projects in [" << search_roots.size() << "] folders");
+		s_crawler->start(search_roots,
+			[](std::string_view file_name) { return file_name.ends_with(PROJECT_EXTENTION); },
+			[&index](const std::filesystem::path& project_file) {
+
+				std::optional<project_data> data = index.update(project_file);
+				if (!data)
+					return;
+
+				std::lock_guard lock(s_discovery_mutex);
+				s_discovered_projects.push_back(std::move(*data));
+			},
+			[&index, scan]() {
+
+				// projects that were not found are deleted, or outside of the roots and checked by their stamp
+				std::vector<project_data> changed{};
+				std::vector<std::filesystem::path> removed{};
+				index.finish_scan(scan, changed, removed);
+				index.save();
+
+				std::lock_guard lock(s_discovery_mutex);
+				std::move(changed.begin(), changed.end(), std::back_inserter(s_discovered_projects));
+				std::move(removed.begin(), removed.end(), std::back_inserter(s_removed_projects));
+			});
+	}
+
+
+	void stop_project_discovery() {
 
+		if (!s_crawler)
+			return;
+
+		s_crawler->cancel();
+		s_crawler->wait();
+	}
+
+
+	bool is_project_discovery_running() { return s_crawler && s_crawler->is_running(); }
+
+
+	u32 collect_discovered_projects() {
+
+		std::vector<project_data> discovered{};
+		std::vector<std::filesystem::path> removed{};
+		{
+			std::lock_guard lock(s_discovery_mutex);
+			if (s_discovered_projects.empty() && s_removed_projects.empty())
+				return 0;
+
+			discovered.swap(s_discovered_projects);
+			removed.swap(s_removed_projects);
+		}
+
+		u32 changes = static_cast<u32>(removed.size());
+		for (const auto& project_path : removed)
+			remove_user_project(project_path);
+
+		for (auto& data : discovered) {
+
+			add_user_project(data);
+			changes++;
+		}
+		return changes;
+	}
+
+
+	std::vector<std::filesystem::path> get_discovery_roots() {
+
+		std::string value{};
+		config::get(config::file::launcher, DISCOVERY_SECTION, DISCOVERY_ROOTS_KEY, value);
+
+		std::vector<std::filesystem::path> roots{};
+		for (size_t start = 0; start < value.size(); ) {
+
+			size_t end = value.find(DISCOVERY_ROOTS_SEPARATOR, start);
+			if (end == std::string::npos)
+				end = value.size();
+
+			if (end > start)
+				roots.emplace_back(value.substr(start, end - start));
+			start = end + 1;
+		}
+		return roots;
 	}
 
 
-}
\ No newline at end of file
+	void add_discovery_root(const std::filesystem::path& root) {
+
+		const std::filesystem::path normalized = root.lexically_normal();
+		std::vector<std::filesystem::path> roots = get_discovery_roots();
+		if (std::find(roots.begin(), roots.end(), normalized) != roots.end())
+			return;
+
+		roots.push_back(normalized);
+		if (s_watcher)
+			watch_discovery_root(normalized);
+
+		std::string value{};
+		for (const auto& entry : roots) {
+
+			if (!value.empty())
+				value += DISCOVERY_ROOTS_SEPARATOR;
+			value += entry.generic_string();
+		}
+		config::set(config::file::launcher, DISCOVERY_SECTION, DISCOVERY_ROOTS_KEY, value);
+	}
+
+	// ------------------------------- import -------------------------------
+
+	void import_projects(const std::filesystem::path& root) {
+
+		// projects outside of the searched folders are kept, see project_index::finish_scan()
+		const std::filesystem::path normalized = root.lexically_normal();
+		LOG(Info, "Importing projects from [" << normalized.generic_string() << "]");
+		start_project_discovery({ normalized });
+	}
+
+
+	const std::vector<project_conflict>& get_project_conflicts() { return s_conflicts.get(); }
+
+	// ------------------------------- packages -------------------------------
+
+	bool export_projects(std::vector<std::filesystem::path> project_paths, const std::filesystem::path& package_file) {
+
+		if (!s_archiver)
+			s_archiver = std::make_unique<project_archiver>();
+		return s_archiver->start_export(std::move(project_paths), package_file);
+	}
+
+
+	bool import_project_package(const std::filesystem::path& package_file, const std::filesystem::path& destination, std::vector<std::string> projects) {
+
+		if (!s_archiver)
+			s_archiver = std::make_unique<project_archiver>();
+
+		project_index& index = get_project_index();
+		return s_archiver->start_import(package_file, destination, std::move(projects), [&index](const std::vector<std::filesystem::path>& project_files) {
+
+			std::vector<project_data> imported{};
+			for (const auto& project_file : project_files)
+				if (std::optional<project_data> data = index.update(project_file))
+					imported.push_back(std::move(*data));
+
+			index.save();
+			std::lock_guard lock(s_discovery_mutex);
+			std::move(imported.begin(), imported.end(), std::back_inserter(s_discovered_projects));
+		});
+	}
+
+
+	void cancel_project_package() {
+
+		if (s_archiver)
+			s_archiver->cancel();
+	}
+
+
+	void stop_project_package() {
+
+		if (!s_archiver)
+			return;
+
+		s_archiver->cancel();
+		s_archiver->wait();
+	}
+
+
+	project_archiver::progress get_project_package_progress() { return s_archiver ? s_archiver->get_progress() : project_archiver::progress{}; }
+
+	// ------------------------------- recent projects -------------------------------
+
+	// stored in [config::file::launcher] from the most recent one, IDs of projects that are not listed are skipped by the caller
+	static void load_recent_projects() {
+
+		std::string value{};
+		config::get(config::file::launcher, RECENT_SECTION, RECENT_IDS_KEY, value);
+
+		std::vector<UUID> recent{};
+		for (size_t start = 0; start < value.size(); ) {
+
+			size_t end = value.find(DISCOVERY_ROOTS_SEPARATOR, start);
+			if (end == std::string::npos)
+				end = value.size();
+
+			u64 id = 0;
+			const auto result = std::from_chars(value.data() + start, value.data() + end, id);
+			if (result.ec == std::errc() && result.ptr == value.data() + end)
+				recent.emplace_back(id);
+			start = end + 1;
+		}
+
+		s_recent_projects.clear();
+		for (auto id = recent.rbegin(); id != recent.rend(); ++id)
+			s_recent_projects.touch(*id);
+	}
+
+
+	void mark_project_opened(const UUID& id) {
+
+		s_recent_projects.touch(id);
+
+		// the config store writes the file on its background thread
+		std::string value{};
+		for (const UUID& entry : s_recent_projects) {
+
+			if (!value.empty())
+				value += DISCOVERY_ROOTS_SEPARATOR;
+			value += std::to_string(static_cast<u64>(entry));
+		}
+		config::set(config::file::launcher, RECENT_SECTION, RECENT_IDS_KEY, value);
+	}
+
+
+	const util::lru_list<UUID>& get_recent_projects() { return s_recent_projects; }
+
+	// ------------------------------- dependencies -------------------------------
+
+	void load_dependency_catalog() {
+
+		const std::filesystem::path catalog = util::get_executable_path() / CONFIG_DIR / DEPENDENCY_CATALOG_FILE;
+		if (!s_dependencies.load_catalog(catalog))
+			LOG(Trace, "No dependency catalog in [" << catalog.generic_string() << "], only the engine versions of projects are listed")
+	}
+
+
+	const dependency_graph::resolution& resolve_project_dependencies(const u32 index) {
+
+		const project_store::cold_fields& cold = s_projects.get_cold(index);
+		std::vector<std::string_view> dependencies{};
+		dependencies.reserve(cold.engine_plugins.size() + cold.external_libraries.size());
+		for (const auto plugin : cold.engine_plugins)
+			dependencies.push_back(s_projects.get(plugin));
+		for (const auto library : cold.external_libraries)
+			dependencies.push_back(s_projects.get(library));
+
+		return s_dependencies.resolve(s_projects.get_id(index), s_projects.get_engine_version(index), dependencies);
+	}
+
+
+	const dependency_graph& get_dependency_graph() { return s_dependencies; }
+
+	// ------------------------------- watching -------------------------------
+
+	static void watch_project(const std::filesystem::path& project_path) {
+
+		project_watch watch{ project_data::find_project_file(project_path) };
+		if (!s_watcher->is_watch_limit_reached()) {
+
+			watch.id = s_watcher->watch_directory(project_path, true, [project_path](const std::filesystem::path&) {
+
+				std::lock_guard lock(s_watch_mutex);
+				s_changed_projects.push_back(project_path);
+			}, io::directory_crawler::default_skipped_directories());
+		}
+
+		if (!watch.id)
+			watch.stamp = project_index::get_stamp(watch.project_file);
+		s_project_watches[project_path.generic_string()] = std::move(watch);
+	}
+
+
+	// watches new user projects and unwatches removed ones
+	static void sync_project_watches() {
+
+		std::unordered_set<std::string> listed{};
+		for (u32 x = 0; x < s_projects.size(); x++) {
+
+			std::string key(s_projects.get(s_projects.get_cold(x).project_path));
+			if (!s_project_watches.contains(key))
+				watch_project(s_projects.get_project_path(x));
+			listed.insert(std::move(key));
+		}
+
+		for (auto iterator = s_project_watches.begin(); iterator != s_project_watches.end(); ) {
+
+			if (listed.contains(iterator->first)) {
+
+				++iterator;
+				continue;
+			}
+
+			if (iterator->second.id)
+				s_watcher->unwatch(iterator->second.id);
+			iterator = s_project_watches.erase(iterator);
+		}
+		s_watches_outdated = false;
+	}
+
+
+	void start_project_watching() {
+
+		stop_project_watching();
+		s_watcher = std::make_unique<io::file_watcher>(WATCH_DEBOUNCE);
+		for (const auto& root : get_discovery_roots())
+			watch_discovery_root(root);
+
+		sync_project_watches();
+		s_next_poll = std::chrono::steady_clock::now() + POLL_INTERVAL;
+		if (s_watcher->is_watch_limit_reached())
+			LOG(Info, "Not all projects can be watched, [" << std::count_if(s_project_watches.begin(), s_project_watches.end(), [](const auto& entry) { return entry.second.id == 0; }) << "] projects are checked every [" << POLL_INTERVAL.count() << "] seconds");
+	}
+
+
+	void stop_project_watching() {
+
+		s_watcher.reset();							// joins the watcher thread, no callback runs afterwards
+		s_project_watches.clear();
+		s_root_watches.clear();
+		s_roots_polled = false;
+
+		std::lock_guard lock(s_watch_mutex);
+		s_changed_projects.clear();
+		s_roots_changed = false;
+	}
+
+
+	u32 update_project_watches() {
+
+		if (!s_watcher)
+			return 0;
+
+		std::vector<std::filesystem::path> changed{};
+		bool search_roots = false;
+		{
+			std::lock_guard lock(s_watch_mutex);
+			changed.swap(s_changed_projects);
+
+			// a running search may have passed the new folder already, the next one starts once it is finished
+			if (s_roots_changed && !is_project_discovery_running()) {
+
+				search_roots = true;
+				s_roots_changed = false;
+			}
+		}
+
+		// fallback for projects and roots that could not be watched
+		const auto now = std::chrono::steady_clock::now();
+		if (now >= s_next_poll) {
+
+			s_next_poll = now + POLL_INTERVAL;
+			for (auto& [key, watch] : s_project_watches) {
+
+				if (watch.id)
+					continue;
+
+				std::optional<project_index::file_stamp> stamp = project_index::get_stamp(watch.project_file);
+				if (stamp == watch.stamp)
+					continue;
+
+				watch.stamp = stamp;
+				changed.emplace_back(key);
+			}
+			search_roots |= s_roots_polled && !is_project_discovery_running();
+		}
+
+		if (search_roots)
+			start_project_discovery();
+
+		std::sort(changed.begin(), changed.end());
+		changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+		u32 changes = 0;
+		project_index& index = get_project_index();
+		for (const auto& project_path : changed) {
+
+			const auto watch = s_project_watches.find(project_path.generic_string());
+			if (watch == s_project_watches.end())
+				continue;														// removed in the meantime
+			changes++;
+
+			// the project file can be edited, renamed, replaced or deleted
+			std::filesystem::path project_file = watch->second.project_file;
+			if (!project_index::get_stamp(project_file)) {
+
+				index.remove(project_file);
+				project_file = project_data::find_project_file(project_path);
+			}
+
+			if (project_file.empty()) {
+
+				LOG(Info, "The project file in [" << project_path.generic_string() << "] was removed");
+				remove_user_project(project_path);
+				continue;
+			}
+
+			watch->second.project_file = project_file;
+			if (std::optional<project_data> data = index.update(project_file))
+				add_user_project(*data);
+
+			const system_time time = util::get_system_time();
+			index.set_last_modified(project_file, time);
+			if (const std::optional<u32> listed = s_projects.find(project_path)) {
+
+				s_projects.set_last_modified(*listed, time);
+				request_project_statistics(project_path, s_projects.get(s_projects.get_cold(*listed).build_path));
+			}
+			s_query_outdated = true;
+		}
+
+		if (s_watches_outdated)
+			sync_project_watches();
+		return changes;
+	}
+
+	// ------------------------------- statistics -------------------------------
+
+	u32 collect_project_statistics() {
+
+		if (!s_statistics)
+			return 0;
+
+		std::vector<project_statistics_indexer::result> results{};
+		s_statistics->collect(results);
+
+		project_index& index = get_project_index();
+		for (const auto& result : results) {
+
+			if (!result.project_file.empty())
+				index.set_statistics(result.project_file, result.statistics);
+
+			if (const std::optional<u32> listed = s_projects.find(result.project_path))
+				s_projects.set_statistics(*listed, result.statistics);
+		}
+		return static_cast<u32>(results.size());
+	}
+
+
+	void stop_project_statistics() {
+
+		if (s_statistics)
+			s_statistics->stop();
+	}
+
+
+	bool is_project_statistics_running() { return s_statistics && s_statistics->is_running(); }
+
+}
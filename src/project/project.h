@@ -2,9 +2,27 @@
 
 #include "util/pch.h"
 #include "util/data_structures/UUID.h"
+#include "util/data_structures/lru_list.h"
 #include "util/io/serializer_yaml.h"
 
+#include "project_query.h"
+#include "project_creator.h"
+#include "project_archiver.h"
+#include "dependency_graph.h"
+
 namespace AT {
+
+	// Disk usage and content of a project, computed in the background by the launcher (see [project_statistics_indexer])
+	// and kept in the project index, it is not part of the project file.
+	struct project_statistics {
+		u64							disk_usage = 0;				// allocated bytes of all files in CONTENT_DIR
+		u32							file_count = 0;
+		u32							mesh_count = 0;
+		u32							texture_count = 0;
+		u32							material_count = 0;			// materials and material instances
+		int64						last_build = 0;				// newest write time in the build folder (ns since epoch), 0 if never built
+		bool						valid = false;				// false until computed once
+	};
   
     struct project_data {
 
@@ -24,13 +42,28 @@ namespace AT {
 		std::filesystem::path		start_world{};				// system path to the first world when executoing project
 		std::filesystem::path		editor_start_world{};		// system path to the first world when developing the project
 
-		// Dependencies
-		//std::unordered_set<std::string> engine_plugins;		// List of enabled or required plugins
-		//std::unordered_set<std::string> external_libraries;	// List of external libraries
+		// Dependencies, resolved by the launcher (see [dependency_graph])
+		std::vector<std::string>	engine_plugins{};			// enabled or required plugins
+		std::vector<std::string>	external_libraries{};		// external libraries
+
+		project_statistics			statistics{};				// not serialized, see [project_statistics]
+
+		SERIALIZABLE(project_data, ID, name, display_name, description, project_path, last_modified, engine_version, project_version, build_path, start_world, editor_start_world, engine_plugins, external_libraries);
 
 
 		static bool is_valid_project_path(const std::filesystem::path& project_file) { return (!project_file.empty() && std::filesystem::exists(project_file) && project_file.extension() == PROJECT_EXTENTION); }
 
+		// @return The first project file in [project_path], empty if there is none.
+		static std::filesystem::path find_project_file(const std::filesystem::path& project_path) {
+
+			std::error_code error_code;
+			auto iterator = std::filesystem::directory_iterator(project_path, error_code);
+			for (const auto end = std::filesystem::directory_iterator(); !error_code && iterator != end; iterator.increment(error_code))
+				if (iterator->path().extension() == PROJECT_EXTENTION && iterator->is_regular_file(error_code))
+					return iterator->path();
+			return {};
+		}
+
 		void serialize_projects_data(const serializer::option option) {
 
 			for (const auto& entry : std::filesystem::directory_iterator(project_path)) {
@@ -38,38 +71,191 @@ namespace AT {
 				if (entry.is_directory() || entry.path().extension() != PROJECT_EXTENTION)
 					continue;
 
-				serializer::yaml(entry.path(), "project_data", option)
-					.entry(KEY_VALUE(ID))
-					.entry(KEY_VALUE(name))
-					.entry(KEY_VALUE(display_name))
-					.entry(KEY_VALUE(description))
-					.entry(KEY_VALUE(project_path))
-					.entry(KEY_VALUE(last_modified))
-					.entry(KEY_VALUE(engine_version))
-					.entry(KEY_VALUE(project_version))
-					.entry(KEY_VALUE(build_path))
-					.entry(KEY_VALUE(start_world))
-					.entry(KEY_VALUE(editor_start_world))
-					// .unordered_set(KEY_VALUE(engine_plugins))
-					// .unordered_set(KEY_VALUE(external_libraries))
-					.vector("tags", tags, [&](serializer::yaml& inner, u64 x) {
-						inner.entry("tag", tags[x]);
-					});
-
+				serialize_project_file(entry.path(), option);
 				break;
 			}
 		}
 
+		// loads/saves the project from/to [project_file], after loading [project_path] is the directory of the file (even if the file was moved)
+		void serialize_project_file(const std::filesystem::path& project_file, const serializer::option option) {
+
+			serializer::yaml(project_file, "project_data", option)
+				.fields(*this)
+				.vector("tags", tags, [&](serializer::yaml& inner, u64 x) {
+					inner.entry("tag", tags[x]);
+				});
+
+			if (option == serializer::option::load_from_file)
+				project_path = project_file.parent_path();
+		}
+
 	};
 
 
 	// MAYBE: change to project_manager class
 
-	std::vector<project_data>& get_user_projects_ref();
+	class project_store;
+
+	// The user projects, see [project_store]. Projects are added and removed by the functions below only,
+	// they keep the search and the query in the same order.
+	const project_store& get_project_store();
 
-	void create_dummy_projects();
+	// Fills the user projects from the project index of the last session (a single read, no project file is parsed).
+	// Call start_project_discovery() afterwards to pick up changes, see [project_index].
+	void load_project_index();
+
+	// Writes the project index if it changed, done after every completed discovery as well.
+	void save_project_index();
+
+	// Fuzzy searches the user projects (display name, name, path, description and tags), see [project_search].
+	// @return Indices into get_project_store(), best match first, all projects if [query] is empty.
+	//         Valid until the next call or until the projects change.
+	std::span<const u32> search_projects(std::string_view query);
+
+	// Sorts, filters and groups the user projects, see [project_query].
+	// @return Indices into get_project_store(), valid until the next call or until the projects change.
+	std::span<const u32> query_projects(const project_query::parameters& query);
+
+	// Groups and facets of the last query_projects(), and its filters for single projects (project_query::matches()).
+	const project_query& get_project_query();
 	
-	void create_project(project_data data);
+	// ------------------------------- creation -------------------------------
+	// New projects are created on a worker thread (see [project_creator]), the UI shows the progress and can cancel.
+	// A created project is listed by collect_discovered_projects(), like a project found by the discovery.
+
+	// Starts creating [data] in the folder [data.project_path] with a project file named after [data.name], see project_creator::start().
+	// @param template_path A folder whose files are copied into the new project, may be empty.
+	// @return false if a project is still being created or the folder is not usable.
+	bool create_project(project_data data, const std::filesystem::path& template_path = {});
+
+	// Cancels the running creation without waiting for it, everything it created is removed.
+	void cancel_project_creation();
+
+	// Cancels the running creation and waits for it, call before the application exits.
+	void stop_project_creation();
 
+	// Progress of the running (or last) creation.
+	project_creator::progress get_project_creation_progress();
+
+	// Adds a single project file, or a folder that is added to the discovery roots and searched for projects.
 	void add_project(const std::filesystem::path& path);
+
+	// ------------------------------- discovery -------------------------------
+	// Project files are searched on background threads (see [io::directory_crawler]) in the discovery roots, which are kept
+	// in the launcher config. Found projects are loaded on these threads and wait until the main thread picks them up with
+	// collect_discovered_projects(), so the project list fills while the search is still running and the UI never waits for it.
+
+	// Starts a search over [roots], or over the configured discovery roots if [roots] is empty. A running search is cancelled first.
+	void start_project_discovery(const std::vector<std::filesystem::path>& roots = {});
+
+	// Cancels a running search and waits for its threads, call before the application exits.
+	void stop_project_discovery();
+
+	bool is_project_discovery_running();
+
+	// Applies the changes found since the last call to the user projects: new projects are added, changed projects
+	// replace their entry (same [project_path]) and deleted projects are removed. Call from the main thread, e.g. every frame.
+	// @return The number of added, changed and removed projects.
+	u32 collect_discovered_projects();
+
+	std::vector<std::filesystem::path> get_discovery_roots();
+
+	// Adds [root] to the configured discovery roots (if not already included).
+	void add_discovery_root(const std::filesystem::path& root);
+
+	// ------------------------------- import -------------------------------
+	// Projects are identified by [project_data::ID]: a copy of a listed project in another folder (e.g. a copied project or a
+	// second checkout) is not listed, but kept as a conflict until the user removes one of the copies. When the listed copy is
+	// removed, the first conflicting copy takes its place.
+
+	// A project that was found, but not listed because a project with the same [ID] is already listed.
+	struct project_conflict {
+		project_data				data{};
+		std::filesystem::path		listed_path{};				// [project_path] of the listed project with the same [ID]
+	};
+
+	// Searches [root] once for projects on the crawler threads, see start_project_discovery(). Unlike add_project() [root] is
+	// not added to the discovery roots, e.g. for an archive of projects. Found projects are watched like all others.
+	void import_projects(const std::filesystem::path& root);
+
+	const std::vector<project_conflict>& get_project_conflicts();
+
+	// ------------------------------- packages -------------------------------
+	// Projects are exported into a single package file (see [project_archiver]) to move them between machines, instead of
+	// copying a tree of many small files. Both directions run on a worker thread, the UI shows the progress and can cancel.
+	// Imported projects are listed by collect_discovered_projects(), like a project found by the discovery.
+
+	// Starts writing the projects in [project_paths] into [package_file].
+	// @return false if projects are still being exported or imported.
+	bool export_projects(std::vector<std::filesystem::path> project_paths, const std::filesystem::path& package_file);
+
+	// Starts extracting the projects in [package_file] into [destination], each into a folder named like the project folder it was exported from.
+	// @param projects Folder names of the projects to extract (see project_archiver::list_projects()), all projects if empty.
+	// @return false if projects are still being exported or imported.
+	bool import_project_package(const std::filesystem::path& package_file, const std::filesystem::path& destination, std::vector<std::string> projects = {});
+
+	// Cancels the running export or import without waiting for it.
+	void cancel_project_package();
+
+	// Cancels the running export or import and waits for it, call before the application exits.
+	void stop_project_package();
+
+	// Progress of the running (or last) export or import.
+	project_archiver::progress get_project_package_progress();
+
+	// ------------------------------- recent projects -------------------------------
+	// The last opened projects are kept by [project_data::ID] in a small [util::lru_list] and stored in [config::file::launcher],
+	// so the home page shows them without sorting all projects. IDs of projects that are not listed anymore are skipped.
+
+	// Moves the project [id] to the front of the recent projects, call when a project is opened.
+	// They are written by the background thread of the config store, opening a project does not write the project index.
+	void mark_project_opened(const UUID& id);
+
+	// The recent projects, the most recently opened first. Use project_store::find() to get their data.
+	const util::lru_list<UUID>& get_recent_projects();
+
+	// ------------------------------- dependencies -------------------------------
+	// The plugins and external libraries of the projects are resolved against the dependency catalog in the config folder,
+	// the known plugins and libraries and the installed engine versions (see [dependency_graph]).
+
+	// Reads the dependency catalog, every project is resolved again on its next request.
+	void load_dependency_catalog();
+
+	// Resolves the plugins and libraries of the project at [index] of get_project_store().
+	// @return The cached resolution if neither the project nor the catalog changed, valid until the next call.
+	const dependency_graph::resolution& resolve_project_dependencies(const u32 index);
+
+	// The catalog, e.g. to get the names of the definitions in dependency_graph::resolution::load_order.
+	const dependency_graph& get_dependency_graph();
+
+	// ------------------------------- watching -------------------------------
+	// Project folders and discovery roots are watched for changes (see [io::file_watcher]), so edits, new and deleted project
+	// files show up while the launcher is open. Events of a folder are coalesced, a git checkout causes one update per project.
+	// Once the system limit of watches is reached, the remaining projects are polled by the stamp of their project file.
+
+	// Starts watching the discovery roots and all listed projects.
+	void start_project_watching();
+
+	// Stops all watches, call before the application exits.
+	void stop_project_watching();
+
+	// Applies the changes reported since the last call: changed projects are loaded again and get a new [last_modified],
+	// deleted project files are removed and discovery roots with new folders are searched again. Also watches new projects
+	// and unwatches removed ones. Call from the main thread after collect_discovered_projects().
+	// @return The number of changed and removed projects.
+	u32 update_project_watches();
+
+	// ------------------------------- statistics -------------------------------
+	// Disk usage, asset counts and the last build of every project (see [project_statistics]) are computed in the background
+	// by a [project_statistics_indexer] and cached in the project index. New projects, projects without cached statistics and
+	// projects whose folder changed (reported by the watches) are computed again.
+
+	// Applies the statistics computed since the last call to the user projects and the project index. Call from the main thread.
+	// @return The number of updated projects.
+	u32 collect_project_statistics();
+
+	// Drops the queued projects and waits for the running one, call before the application exits.
+	void stop_project_statistics();
+
+	bool is_project_statistics_running();
 }
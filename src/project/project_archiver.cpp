@@ -0,0 +1,316 @@
+#include "util/pch.h"
+
+#include "util/io/directory_crawler.h"
+#include "util/io/package.h"
+
+#include "project.h"
+#include "project_archiver.h"
+
+
+namespace AT {
+
+	project_archiver::~project_archiver() {
+
+		cancel();
+		wait();
+	}
+
+
+	bool project_archiver::start_export(std::vector<std::filesystem::path> project_paths, const std::filesystem::path& package_file) {
+
+		VALIDATE(!is_running(), return false, "", "Projects are already being exported or imported");
+		wait();
+
+		VALIDATE(!project_paths.empty() && !package_file.empty(), return false, "", "An export needs projects and a package file");
+
+		reset(stage::scanning);
+		m_thread = std::thread(&project_archiver::run_export, this, std::move(project_paths), package_file);
+		return true;
+	}
+
+
+	bool project_archiver::start_import(const std::filesystem::path& package_file, const std::filesystem::path& destination, std::vector<std::string> projects, imported_callback&& on_imported) {
+
+		VALIDATE(!is_running(), return false, "", "Projects are already being exported or imported");
+		wait();
+
+		VALIDATE(!package_file.empty() && !destination.empty(), return false, "", "An import needs a package file and a destination");
+
+		reset(stage::scanning);
+		m_thread = std::thread(&project_archiver::run_import, this, package_file, destination, std::move(projects), std::move(on_imported));
+		return true;
+	}
+
+
+	void project_archiver::wait() {
+
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+
+	project_archiver::progress project_archiver::get_progress() const {
+
+		progress result{};
+		result.state = m_stage.load(std::memory_order_acquire);
+		result.processed_bytes = m_processed_bytes.load(std::memory_order_relaxed);
+		result.total_bytes = m_total_bytes.load(std::memory_order_relaxed);
+		result.processed_files = m_processed_files.load(std::memory_order_relaxed);
+		result.total_files = m_total_files.load(std::memory_order_relaxed);
+
+		std::lock_guard lock(m_message_mutex);
+		result.message = m_message;
+		return result;
+	}
+
+
+	const char* project_archiver::get_stage_name(const stage value) {
+
+		switch (value) {
+			case stage::idle:					return "Idle";
+			case stage::scanning:				return "Reading files";
+			case stage::exporting:				return "Exporting";
+			case stage::importing:				return "Importing";
+			case stage::finished:				return "Finished";
+			case stage::cancelled:				return "Cancelled";
+			case stage::failed:					return "Failed";
+			default:							return "Unknown";
+		}
+	}
+
+
+	std::vector<std::string> project_archiver::list_projects(const std::filesystem::path& package_file) {
+
+		const io::package_reader reader(package_file);
+		if (!reader.is_valid())
+			return {};
+
+		std::vector<std::string> projects{};
+		for (const auto& entry : reader.get_entries()) {
+
+			const size_t separator = entry.name.find('/');
+			if (separator != std::string::npos && entry.name.find('/', separator + 1) == std::string::npos && entry.name.ends_with(PROJECT_EXTENTION))
+				projects.push_back(entry.name.substr(0, separator));
+		}
+
+		std::sort(projects.begin(), projects.end());
+		projects.erase(std::unique(projects.begin(), projects.end()), projects.end());
+		return projects;
+	}
+
+
+	void project_archiver::run_export(std::vector<std::filesystem::path> project_paths, std::filesystem::path package_file) {
+
+		struct package_file_entry {
+			std::filesystem::path	source{};
+			std::string				name{};
+			u64						size = 0;
+		};
+
+		LOG(Trace, "Exporting [" << project_paths.size() << "] projects to [" << package_file.generic_string() << "]");
+
+		// files of every project below a unique folder name, skips the folders a crawler skips and symbolic links
+		const std::vector<std::string>& skipped = io::directory_crawler::default_skipped_directories();
+		std::vector<package_file_entry> files{};
+		std::unordered_set<std::string> folders{};
+		for (const auto& project_path : project_paths) {
+
+			const std::filesystem::path normalized = project_path.lexically_normal();
+			std::string folder = (normalized.has_filename() ? normalized : normalized.parent_path()).filename().string();
+			for (u32 x = 2; !folders.insert(folder).second; x++)
+				folder = (normalized.has_filename() ? normalized : normalized.parent_path()).filename().string() + "_" + std::to_string(x);
+
+			std::error_code error_code;
+			auto iterator = std::filesystem::recursive_directory_iterator(normalized, std::filesystem::directory_options::skip_permission_denied, error_code);
+			if (error_code)
+				return fail("Failed to read the project [" + normalized.generic_string() + "]: " + error_code.message());
+
+			for (const auto end = std::filesystem::recursive_directory_iterator(); !error_code && iterator != end; iterator.increment(error_code)) {
+
+				if (m_cancel.load(std::memory_order_relaxed))
+					return fail({});
+
+				std::error_code entry_error;
+				const std::filesystem::path& path = iterator->path();
+				if (iterator->is_directory(entry_error)) {
+
+					if (iterator->is_symlink(entry_error) || std::find(skipped.begin(), skipped.end(), path.filename().string()) != skipped.end())
+						iterator.disable_recursion_pending();
+					continue;
+				}
+
+				if (!iterator->is_regular_file(entry_error) || iterator->is_symlink(entry_error))
+					continue;
+
+				const u64 size = iterator->file_size(entry_error);
+				files.push_back({ path, folder + "/" + path.lexically_relative(normalized).generic_string(), entry_error ? 0 : size });
+				m_total_bytes.fetch_add(files.back().size, std::memory_order_relaxed);
+				m_total_files.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (error_code)
+				return fail("Failed to read the project [" + normalized.generic_string() + "]: " + error_code.message());
+		}
+
+		// the package replaces [package_file] in finish() only, nothing has to be removed on failure
+		set_stage(stage::exporting);
+		io::package_writer writer(package_file);
+		for (const auto& file : files) {
+
+			set_message(file.name);
+			const u64 processed_before = m_processed_bytes.load(std::memory_order_relaxed);
+			const bool added = writer.add_file(file.source, file.name, [this, processed_before](const u64 read_bytes) {
+
+				m_processed_bytes.store(processed_before + read_bytes, std::memory_order_relaxed);
+				return !m_cancel.load(std::memory_order_relaxed);
+			});
+
+			if (!added)
+				return fail("Failed to export [" + file.source.generic_string() + "]");
+
+			m_processed_bytes.store(processed_before + file.size, std::memory_order_relaxed);
+			m_processed_files.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (m_cancel.load(std::memory_order_relaxed))
+			return fail({});
+
+		if (!writer.finish())
+			return fail("Failed to write the package [" + package_file.generic_string() + "]");
+
+		LOG(Info, "Exported [" << project_paths.size() << "] projects to [" << package_file.generic_string() << "]");
+		set_message({});
+		set_stage(stage::finished);
+		m_running.store(false, std::memory_order_release);
+	}
+
+
+	void project_archiver::run_import(std::filesystem::path package_file, std::filesystem::path destination, std::vector<std::string> projects, imported_callback on_imported) {
+
+		LOG(Trace, "Importing projects from [" << package_file.generic_string() << "] into [" << destination.generic_string() << "]");
+
+		const io::package_reader reader(package_file);
+		if (!reader.is_valid())
+			return fail("Failed to read the package [" + package_file.generic_string() + "]");
+
+		if (projects.empty())
+			projects = list_projects(package_file);
+
+		// only the index is read to select files, the chunks of other projects are never touched
+		const std::unordered_set<std::string> selected(projects.begin(), projects.end());
+		std::vector<u32> indices{};
+		const auto& entries = reader.get_entries();
+		for (u32 x = 0; x < entries.size(); x++) {
+
+			const size_t separator = entries[x].name.find('/');
+			if (separator == std::string::npos || !selected.contains(entries[x].name.substr(0, separator)))
+				continue;
+
+			indices.push_back(x);
+			m_total_bytes.fetch_add(entries[x].size, std::memory_order_relaxed);
+		}
+		m_total_files.store(static_cast<u32>(indices.size()), std::memory_order_relaxed);
+
+		std::vector<std::filesystem::path> created{};
+		std::vector<std::filesystem::path> emptied{};
+		for (const auto& project : projects) {
+
+			std::error_code error_code;
+			const std::filesystem::path folder = destination / project;
+			if (!std::filesystem::exists(folder, error_code))
+				created.push_back(folder);
+			else if (std::filesystem::is_directory(folder, error_code) && std::filesystem::is_empty(folder, error_code))
+				emptied.push_back(folder);
+			else
+				return fail("Can not import [" + project + "], the folder [" + folder.generic_string() + "] is not empty");
+		}
+
+		// removes everything that was extracted, a folder itself only if it did not exist before
+		auto roll_back = [&created, &emptied]() {
+
+			std::error_code error_code;
+			for (const auto& folder : created)
+				std::filesystem::remove_all(folder, error_code);
+
+			for (const auto& folder : emptied) {
+
+				std::vector<std::filesystem::path> children{};
+				auto iterator = std::filesystem::directory_iterator(folder, error_code);
+				for (const auto end = std::filesystem::directory_iterator(); !error_code && iterator != end; iterator.increment(error_code))
+					children.push_back(iterator->path());
+
+				for (const auto& child : children)
+					std::filesystem::remove_all(child, error_code);
+			}
+		};
+
+		set_stage(stage::importing);
+		set_message(package_file.filename().string());
+		const bool extracted = reader.extract(indices, destination, 0, [this](const u64 written_bytes) {
+
+			m_processed_bytes.store(written_bytes, std::memory_order_relaxed);
+			return !m_cancel.load(std::memory_order_relaxed);
+		});
+
+		if (!extracted || m_cancel.load(std::memory_order_relaxed)) {
+
+			roll_back();
+			return fail("Failed to extract the package [" + package_file.generic_string() + "]");
+		}
+		m_processed_files.store(static_cast<u32>(indices.size()), std::memory_order_relaxed);
+
+		std::vector<std::filesystem::path> project_files{};
+		for (const auto& project : projects) {
+
+			std::filesystem::path project_file = project_data::find_project_file(destination / project);
+			if (!project_file.empty())
+				project_files.push_back(std::move(project_file));
+		}
+
+		LOG(Info, "Imported [" << project_files.size() << "] projects from [" << package_file.generic_string() << "]");
+		if (on_imported)
+			on_imported(project_files);
+
+		set_message({});
+		set_stage(stage::finished);
+		m_running.store(false, std::memory_order_release);
+	}
+
+
+	void project_archiver::reset(const stage value) {
+
+		m_cancel.store(false, std::memory_order_relaxed);
+		m_processed_bytes.store(0, std::memory_order_relaxed);
+		m_total_bytes.store(0, std::memory_order_relaxed);
+		m_processed_files.store(0, std::memory_order_relaxed);
+		m_total_files.store(0, std::memory_order_relaxed);
+		set_message({});
+		set_stage(value);
+		m_running.store(true, std::memory_order_release);
+	}
+
+
+	void project_archiver::set_stage(const stage value) { m_stage.store(value, std::memory_order_release); }
+
+
+	void project_archiver::set_message(std::string message) {
+
+		std::lock_guard lock(m_message_mutex);
+		m_message = std::move(message);
+	}
+
+
+	void project_archiver::fail(std::string message) {
+
+		const bool cancelled = m_cancel.load(std::memory_order_relaxed);
+		if (cancelled)
+			LOG(Info, "Cancelled the project export or import")
+		else
+			LOG(Error, message);
+
+		set_message(cancelled ? std::string() : std::move(message));
+		set_stage(cancelled ? stage::cancelled : stage::failed);
+		m_running.store(false, std::memory_order_release);
+	}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "util/pch.h"
+
+namespace AT {
+
+	// Exports projects into a single package file and imports them again, on a worker thread (see [io::package_writer]).
+	// Every project is stored below its folder name ("<folder>/<relative path>"), folders a crawler skips (".git", "build", ...)
+	// are left out, they are created again on the other machine. The progress can be read at any time (e.g. every frame) and
+	// both operations can be cancelled, a cancelled or failed operation removes what it created.
+	//
+	//   project_archiver archiver;
+	//   archiver.start_export({ project_path }, package_file);
+	//   ... archiver.get_progress() ...
+	class project_archiver {
+	public:
+
+		enum class stage : u8 {
+			idle = 0,
+			scanning,
+			exporting,
+			importing,
+			finished,
+			cancelled,
+			failed,
+		};
+
+		struct progress {
+			stage					state = stage::idle;
+			u64						processed_bytes = 0;
+			u64						total_bytes = 0;			// known after [stage::scanning]
+			u32						processed_files = 0;		// an import counts its files once they are all extracted
+			u32						total_files = 0;
+			std::string				message{};					// the file that is processed, or the reason of a failure
+
+			bool is_running() const									{ return state != stage::idle && state < stage::finished; }
+
+			f32 get_fraction() const								{ return total_bytes ? static_cast<f32>(processed_bytes) / static_cast<f32>(total_bytes) : 0.f; }
+		};
+
+		// Called on the worker thread once an import is finished, with the project files of the imported projects.
+		using imported_callback = std::function<void(const std::vector<std::filesystem::path>& project_files)>;
+
+		project_archiver() = default;
+
+		// Cancels a running operation and waits for it.
+		~project_archiver();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(project_archiver);
+
+		// Starts writing the projects in [project_paths] into [package_file], which is replaced once the package is complete.
+		// @return false if an operation is still running.
+		bool start_export(std::vector<std::filesystem::path> project_paths, const std::filesystem::path& package_file);
+
+		// Starts extracting the projects of [package_file] into [destination] / their folder name.
+		// @param projects Folder names of the projects to extract (see list_projects()), all projects if empty.
+		// Fails (see get_progress()) if the package is not readable or the folder of a project exists and is not empty.
+		// @return false if an operation is still running.
+		bool start_import(const std::filesystem::path& package_file, const std::filesystem::path& destination, std::vector<std::string> projects = {}, imported_callback&& on_imported = {});
+
+		// Stops the running operation as soon as possible, does not block.
+		void cancel()												{ m_cancel.store(true, std::memory_order_relaxed); }
+
+		// Blocks until the running operation is finished, cancelled or failed.
+		void wait();
+
+		bool is_running() const										{ return m_running.load(std::memory_order_acquire); }
+
+		// Returns the progress of the current (or last) operation.
+		progress get_progress() const;
+
+		static const char* get_stage_name(const stage value);
+
+		// Folder names of the projects in [package_file], a project is a top level folder with a project file, read from the index only.
+		static std::vector<std::string> list_projects(const std::filesystem::path& package_file);
+
+	private:
+
+		void run_export(std::vector<std::filesystem::path> project_paths, std::filesystem::path package_file);
+		void run_import(std::filesystem::path package_file, std::filesystem::path destination, std::vector<std::string> projects, imported_callback on_imported);
+		void reset(const stage value);
+		void set_stage(const stage value);
+		void set_message(std::string message);
+		void fail(std::string message);
+
+		std::thread									m_thread{};
+		std::atomic<bool>							m_running = false;
+		std::atomic<stage>							m_stage = stage::idle;
+		std::atomic<bool>							m_cancel = false;
+		std::atomic<u64>							m_processed_bytes = 0;
+		std::atomic<u64>							m_total_bytes = 0;
+		std::atomic<u32>							m_processed_files = 0;
+		std::atomic<u32>							m_total_files = 0;
+		mutable std::mutex							m_message_mutex{};
+		std::string									m_message{};					// guarded by [m_message_mutex]
+	};
+
+}
@@ -0,0 +1,76 @@
+#include "util/pch.h"
+
+#include "project_store.h"
+#include "project_conflicts.h"
+
+
+namespace AT {
+
+	void project_conflicts::assign(std::vector<project_data>& projects) {
+
+		m_conflicts.clear();
+		std::unordered_map<UUID, size_t> first_copy{};
+		size_t kept = 0;
+		for (size_t x = 0; x < projects.size(); x++) {
+
+			const auto [found, inserted] = first_copy.try_emplace(projects[x].ID, kept);
+			if (!inserted) {
+
+				m_conflicts.push_back({ std::move(projects[x]), projects[found->second].project_path });
+				continue;
+			}
+
+			if (kept != x)
+				projects[kept] = std::move(projects[x]);
+			kept++;
+		}
+		projects.resize(kept);
+
+		if (!m_conflicts.empty())
+			LOG(Warn, "[" << m_conflicts.size() << "] projects are copies of listed projects and are not listed");
+	}
+
+
+	std::optional<std::filesystem::path> project_conflicts::find_original(const project_store& projects, const project_data& data) {
+
+		const std::optional<u32> same_id = projects.find(data.ID);
+		if (!same_id || same_id == projects.find(data.project_path))
+			return std::nullopt;
+
+		return projects.get_project_path(*same_id);
+	}
+
+
+	void project_conflicts::add(const project_data& data, const std::filesystem::path& listed_path) {
+
+		LOG(Warn, "Project [" << data.display_name << "] in [" << data.project_path.generic_string() << "] has the same ID as the project in [" << listed_path.generic_string() << "], it is not listed");
+		const auto conflict = std::find_if(m_conflicts.begin(), m_conflicts.end(), [&data](const project_conflict& entry) { return entry.data.project_path == data.project_path; });
+		if (conflict != m_conflicts.end())
+			*conflict = { data, listed_path };
+		else
+			m_conflicts.push_back({ data, listed_path });
+	}
+
+
+	std::optional<project_data> project_conflicts::remove(const std::filesystem::path& project_path, const std::optional<UUID>& removed_id) {
+
+		std::erase_if(m_conflicts, [&project_path](const project_conflict& entry) { return entry.data.project_path == project_path; });
+		if (!removed_id)
+			return std::nullopt;
+
+		const UUID id = *removed_id;
+		const auto copy = std::find_if(m_conflicts.begin(), m_conflicts.end(), [id](const project_conflict& entry) { return entry.data.ID == id; });
+		if (copy == m_conflicts.end())
+			return std::nullopt;
+
+		project_data promoted = std::move(copy->data);
+		m_conflicts.erase(copy);
+		for (auto& conflict : m_conflicts)
+			if (conflict.data.ID == id)
+				conflict.listed_path = promoted.project_path;
+
+		LOG(Info, "Listing project [" << promoted.display_name << "] in [" << promoted.project_path.generic_string() << "] instead of the removed copy");
+		return promoted;
+	}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "util/pch.h"
+
+#include "project.h"
+
+namespace AT {
+
+	class project_store;
+
+	// Copies of listed projects, see [project_conflict]: project files with the [ID] of a listed project in another folder.
+	// Only the first project of an ID is listed, its copies are kept here and the first one is listed when it is removed.
+	// Keeps the bookkeeping only, the caller changes the [project_store] (and everything that mirrors it) as the results say.
+	// Not thread-safe, used by the owner of the [project_store].
+	class project_conflicts {
+	public:
+
+		// Replaces all conflicts with the copies in [projects], the first project of every ID is kept in [projects].
+		void assign(std::vector<project_data>& projects);
+
+		// @return The [project_path] of the listed project [data] is a copy of, or std::nullopt if [data] can be listed.
+		//         If [data] is stored in the folder of another listed project (its project file was replaced by a copy), the
+		//         caller has to remove that project before add() is called.
+		static std::optional<std::filesystem::path> find_original(const project_store& projects, const project_data& data);
+
+		// Stores [data] as a copy of the project in [listed_path], an existing conflict of the same folder is replaced.
+		void add(const project_data& data, const std::filesystem::path& listed_path);
+
+		// Forgets the copy in [project_path], call when a project is removed.
+		// @param removed_id The ID of the listed project that was removed from [project_path], if one was listed there.
+		// @return The first copy of [removed_id], the caller lists it instead. The other copies now refer to its folder.
+		std::optional<project_data> remove(const std::filesystem::path& project_path, const std::optional<UUID>& removed_id);
+
+		const std::vector<project_conflict>& get() const							{ return m_conflicts; }
+		size_t size() const															{ return m_conflicts.size(); }
+		bool empty() const															{ return m_conflicts.empty(); }
+
+	private:
+
+		std::vector<project_conflict>				m_conflicts{};
+	};
+
+}
@@ -0,0 +1,247 @@
+#include "util/pch.h"
+
+#include "util/io/io.h"
+#include "util/io/config.h"
+#include "util/io/directory_crawler.h"
+#include "util/system.h"
+
+#include "project.h"
+#include "project_creator.h"
+
+
+namespace AT {
+
+	f32 project_creator::progress::get_fraction() const {
+
+		switch (state) {
+			case stage::copying_files:			return total_bytes ? .9f * static_cast<f32>(copied_bytes) / static_cast<f32>(total_bytes) : 0.f;
+			case stage::writing_project_file:	return .9f;
+			case stage::creating_config:		return .95f;
+			case stage::finished:				return 1.f;
+			default:							return 0.f;
+		}
+	}
+
+
+	project_creator::~project_creator() {
+
+		cancel();
+		wait();
+	}
+
+
+	bool project_creator::start(project_data data, const std::filesystem::path& template_path, finished_callback&& on_finished) {
+
+		VALIDATE(!is_running(), return false, "", "A project is already being created");
+		wait();
+
+		VALIDATE(!data.name.empty() && !data.project_path.empty(), return false, "", "A new project needs a name and a folder");
+
+		std::error_code error_code;
+		m_folder_existed = std::filesystem::exists(data.project_path, error_code);
+		VALIDATE(!m_folder_existed || (std::filesystem::is_directory(data.project_path, error_code) && std::filesystem::is_empty(data.project_path, error_code)), return false, "",
+			"Can not create a project in [" << data.project_path.generic_string() << "], the folder is not empty");
+		VALIDATE(template_path.empty() || std::filesystem::is_directory(template_path, error_code), return false, "", "Template [" << template_path.generic_string() << "] is not a folder");
+
+		m_cancel.store(false, std::memory_order_relaxed);
+		m_copied_bytes.store(0, std::memory_order_relaxed);
+		m_total_bytes.store(0, std::memory_order_relaxed);
+		m_copied_files.store(0, std::memory_order_relaxed);
+		m_total_files.store(0, std::memory_order_relaxed);
+		set_message({});
+		set_stage(stage::scanning_template);
+		m_running.store(true, std::memory_order_release);
+		m_thread = std::thread(&project_creator::run, this, std::move(data), template_path, std::move(on_finished));
+		return true;
+	}
+
+
+	void project_creator::wait() {
+
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+
+	project_creator::progress project_creator::get_progress() const {
+
+		progress result{};
+		result.state = m_stage.load(std::memory_order_acquire);
+		result.copied_bytes = m_copied_bytes.load(std::memory_order_relaxed);
+		result.total_bytes = m_total_bytes.load(std::memory_order_relaxed);
+		result.copied_files = m_copied_files.load(std::memory_order_relaxed);
+		result.total_files = m_total_files.load(std::memory_order_relaxed);
+
+		std::lock_guard lock(m_message_mutex);
+		result.message = m_message;
+		return result;
+	}
+
+
+	const char* project_creator::get_stage_name(const stage value) {
+
+		switch (value) {
+			case stage::idle:					return "Idle";
+			case stage::scanning_template:		return "Reading template";
+			case stage::creating_layout:		return "Creating folders";
+			case stage::copying_files:			return "Copying files";
+			case stage::writing_project_file:	return "Writing project file";
+			case stage::creating_config:		return "Creating config files";
+			case stage::finished:				return "Finished";
+			case stage::cancelled:				return "Cancelled";
+			case stage::failed:					return "Failed";
+			default:							return "Unknown";
+		}
+	}
+
+
+	void project_creator::run(project_data data, std::filesystem::path template_path, finished_callback on_finished) {
+
+		LOG(Trace, "Creating project [" << data.display_name << "] in [" << data.project_path.generic_string() << "]");
+
+		std::vector<template_file> files{};
+		std::vector<std::filesystem::path> directories{};
+		if (!template_path.empty() && !scan_template(template_path, files, directories))
+			return fail("Failed to read the template [" + template_path.generic_string() + "]", data.project_path);
+
+		set_stage(stage::creating_layout);
+		for (const char* directory : { METADATA_DIR, CONFIG_DIR, CONTENT_DIR, SOURCE_DIR })
+			directories.emplace_back(directory);
+
+		std::error_code error_code;
+		std::filesystem::create_directories(data.project_path, error_code);
+		for (size_t x = 0; !error_code && x < directories.size(); x++)
+			std::filesystem::create_directories(data.project_path / directories[x], error_code);
+
+		if (error_code)
+			return fail("Failed to create the project folders: " + error_code.message(), data.project_path);
+
+		set_stage(stage::copying_files);
+		if (!copy_template(template_path, data.project_path, files))
+			return fail("Failed to copy [" + get_progress().message + "]", data.project_path);
+
+		set_stage(stage::writing_project_file);
+		const std::filesystem::path project_file = data.project_path / (data.name + PROJECT_EXTENTION);
+		data.last_modified = util::get_system_time();
+		data.serialize_project_file(project_file, serializer::option::save_to_file);
+		if (!std::filesystem::is_regular_file(project_file, error_code))
+			return fail("Failed to write the project file [" + project_file.generic_string() + "]", data.project_path);
+
+		set_stage(stage::creating_config);
+		config::create_config_files_for_project(data.project_path);
+		if (m_cancel.load(std::memory_order_relaxed))
+			return fail({}, data.project_path);
+
+		LOG(Info, "Created project [" << data.display_name << "] in [" << data.project_path.generic_string() << "]");
+		if (on_finished)
+			on_finished(project_file);
+
+		set_message({});
+		set_stage(stage::finished);
+		m_running.store(false, std::memory_order_release);
+	}
+
+
+	// files and folders of [template_path] relative to it, skips the folders a crawler skips (".git", "build", ...) and project files
+	bool project_creator::scan_template(const std::filesystem::path& template_path, std::vector<template_file>& files, std::vector<std::filesystem::path>& directories) {
+
+		const std::vector<std::string>& skipped = io::directory_crawler::default_skipped_directories();
+		std::error_code error_code;
+		auto iterator = std::filesystem::recursive_directory_iterator(template_path, std::filesystem::directory_options::skip_permission_denied, error_code);
+		for (const auto end = std::filesystem::recursive_directory_iterator(); !error_code && iterator != end; iterator.increment(error_code)) {
+
+			if (m_cancel.load(std::memory_order_relaxed))
+				return false;
+
+			std::error_code entry_error;
+			const std::filesystem::path& path = iterator->path();
+			if (iterator->is_directory(entry_error)) {
+
+				if (iterator->is_symlink(entry_error) || std::find(skipped.begin(), skipped.end(), path.filename().string()) != skipped.end()) {
+
+					iterator.disable_recursion_pending();
+					continue;
+				}
+
+				directories.push_back(path.lexically_relative(template_path));
+				continue;
+			}
+
+			if (!iterator->is_regular_file(entry_error) || path.extension() == PROJECT_EXTENTION)
+				continue;
+
+			const u64 size = iterator->file_size(entry_error);
+			files.push_back({ path.lexically_relative(template_path), entry_error ? 0 : size });
+			m_total_bytes.fetch_add(files.back().size, std::memory_order_relaxed);
+			m_total_files.fetch_add(1, std::memory_order_relaxed);
+		}
+		return !error_code;
+	}
+
+
+	bool project_creator::copy_template(const std::filesystem::path& template_path, const std::filesystem::path& project_path, const std::vector<template_file>& files) {
+
+		for (const auto& file : files) {
+
+			if (m_cancel.load(std::memory_order_relaxed))
+				return false;
+
+			set_message(file.relative_path.generic_string());
+			const u64 copied_before = m_copied_bytes.load(std::memory_order_relaxed);
+			const bool copied = io::copy_file_contents(template_path / file.relative_path, project_path / file.relative_path, [this, copied_before](const u64 copied_bytes) {
+
+				m_copied_bytes.store(copied_before + copied_bytes, std::memory_order_relaxed);
+				return !m_cancel.load(std::memory_order_relaxed);
+			});
+
+			if (!copied)
+				return false;
+
+			m_copied_bytes.store(copied_before + file.size, std::memory_order_relaxed);
+			m_copied_files.fetch_add(1, std::memory_order_relaxed);
+		}
+		return true;
+	}
+
+
+	void project_creator::set_stage(const stage value) { m_stage.store(value, std::memory_order_release); }
+
+
+	void project_creator::set_message(std::string message) {
+
+		std::lock_guard lock(m_message_mutex);
+		m_message = std::move(message);
+	}
+
+
+	// removes everything that was created, the folder itself only if it did not exist before
+	void project_creator::fail(std::string message, const std::filesystem::path& project_path) {
+
+		const bool cancelled = m_cancel.load(std::memory_order_relaxed);
+		if (cancelled)
+			LOG(Info, "Cancelled creating project in [" << project_path.generic_string() << "]")
+		else
+			LOG(Error, message);
+
+		std::error_code error_code;
+		if (!m_folder_existed) {
+
+			std::filesystem::remove_all(project_path, error_code);
+
+		} else {
+
+			std::vector<std::filesystem::path> entries{};
+			auto iterator = std::filesystem::directory_iterator(project_path, error_code);
+			for (const auto end = std::filesystem::directory_iterator(); !error_code && iterator != end; iterator.increment(error_code))
+				entries.push_back(iterator->path());
+
+			for (const auto& entry : entries)
+				std::filesystem::remove_all(entry, error_code);
+		}
+
+		set_message(cancelled ? std::string() : std::move(message));
+		set_stage(cancelled ? stage::cancelled : stage::failed);
+		m_running.store(false, std::memory_order_release);
+	}
+
+}
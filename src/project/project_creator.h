@@ -0,0 +1,101 @@
+#pragma once
+
+#include "util/pch.h"
+
+namespace AT {
+
+	struct project_data;
+
+	// Creates a new project on a worker thread: the folder layout, the files of a template, the project file and the project
+	// config files. Template files are copied with io::copy_file_contents() (cloned where the file system can), so even a
+	// template of several GB never blocks the calling thread. The progress can be read at any time (e.g. every frame) and the
+	// creation can be cancelled, a cancelled or failed creation removes everything it created.
+	//
+	//   project_creator creator;
+	//   creator.start(data, template_path, [](const std::filesystem::path& project_file) { ... });
+	//   ... creator.get_progress() ...
+	class project_creator {
+	public:
+
+		enum class stage : u8 {
+			idle = 0,
+			scanning_template,
+			creating_layout,
+			copying_files,
+			writing_project_file,
+			creating_config,
+			finished,
+			cancelled,
+			failed,
+		};
+
+		struct progress {
+			stage					state = stage::idle;
+			u64						copied_bytes = 0;
+			u64						total_bytes = 0;			// of all template files, known after [stage::scanning_template]
+			u32						copied_files = 0;
+			u32						total_files = 0;
+			std::string				message{};					// the file that is copied, or the reason of a failure
+
+			bool is_running() const									{ return state != stage::idle && state < stage::finished; }
+
+			// Share of the work that is done, copying the template counts for most of it.
+			f32 get_fraction() const;
+		};
+
+		// Called on the worker thread once the project was created.
+		using finished_callback = std::function<void(const std::filesystem::path& project_file)>;
+
+		project_creator() = default;
+
+		// Cancels a running creation and waits for it.
+		~project_creator();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(project_creator);
+
+		// Starts creating [data] in [data.project_path] (a folder that does not exist yet or is empty), the project file is
+		// named after [data.name]. Copies all files of [template_path] into the project, except project files, if it is not empty.
+		// @return false if a creation is still running or the target folder is not usable.
+		bool start(project_data data, const std::filesystem::path& template_path, finished_callback&& on_finished = {});
+
+		// Stops the running creation as soon as possible, does not block.
+		void cancel()												{ m_cancel.store(true, std::memory_order_relaxed); }
+
+		// Blocks until the running creation is finished, cancelled or failed.
+		void wait();
+
+		bool is_running() const										{ return m_running.load(std::memory_order_acquire); }
+
+		// Returns the progress of the current (or last) creation.
+		progress get_progress() const;
+
+		static const char* get_stage_name(const stage value);
+
+	private:
+
+		struct template_file {
+			std::filesystem::path	relative_path{};
+			u64						size = 0;
+		};
+
+		void run(project_data data, std::filesystem::path template_path, finished_callback on_finished);
+		bool scan_template(const std::filesystem::path& template_path, std::vector<template_file>& files, std::vector<std::filesystem::path>& directories);
+		bool copy_template(const std::filesystem::path& template_path, const std::filesystem::path& project_path, const std::vector<template_file>& files);
+		void set_stage(const stage value);
+		void set_message(std::string message);
+		void fail(std::string message, const std::filesystem::path& project_path);
+
+		std::thread									m_thread{};
+		std::atomic<bool>							m_running = false;
+		std::atomic<stage>							m_stage = stage::idle;
+		std::atomic<bool>							m_cancel = false;
+		std::atomic<u64>							m_copied_bytes = 0;
+		std::atomic<u64>							m_total_bytes = 0;
+		std::atomic<u32>							m_copied_files = 0;
+		std::atomic<u32>							m_total_files = 0;
+		bool										m_folder_existed = false;		// only the content is removed on rollback, worker thread only
+		mutable std::mutex							m_message_mutex{};
+		std::string									m_message{};					// guarded by [m_message_mutex]
+	};
+
+}
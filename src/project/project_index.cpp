@@ -0,0 +1,273 @@
+#include "util/pch.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#elif defined(PLATFORM_LINUX)
+	#include <sys/stat.h>
+#else
+	#error undefined platform
+#endif
+
+#include "util/io/io.h"
+#include "util/io/serializer_binary.h"
+
+#include "project_index.h"
+
+
+namespace AT {
+
+	static constexpr const char* INDEX_SECTION = "projects";
+
+
+	project_index::project_index(const std::filesystem::path& index_file)
+		: m_index_file(index_file) {}
+
+
+	std::optional<project_index::file_stamp> project_index::get_stamp(const std::filesystem::path& file) {
+
+#if defined(PLATFORM_WINDOWS)
+
+		WIN32_FILE_ATTRIBUTE_DATA attributes{};
+		if (!GetFileAttributesExW(file.wstring().c_str(), GetFileExInfoStandard, &attributes))
+			return std::nullopt;
+
+		// FILETIME counts 100ns intervals
+		const u64 write_time = (static_cast<u64>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+		const u64 size = (static_cast<u64>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+		return file_stamp{ static_cast<int64>(write_time) * 100, size, 0 };
+
+#elif defined(PLATFORM_LINUX)
+
+		struct stat status{};
+		if (::stat(file.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+			return std::nullopt;
+
+		return file_stamp{ static_cast<int64>(status.st_mtim.tv_sec) * 1'000'000'000 + status.st_mtim.tv_nsec, static_cast<u64>(status.st_size), static_cast<u64>(status.st_ino) };
+#endif
+	}
+
+
+	bool project_index::load() {
+
+		PROFILE_FUNCTION();
+
+		std::error_code error_code;
+		if (!std::filesystem::exists(m_index_file, error_code))
+			return false;
+
+		u32 version = 0;
+		std::vector<entry> entries{};
+		serializer::binary serializer(m_index_file, INDEX_SECTION, serializer::option::load_from_file);
+		serializer.entry(version);
+		VALIDATE(serializer.is_valid() && version == INDEX_VERSION, return false, "", "Ignoring project index [" << m_index_file.generic_string() << "] with version [" << version << "]");
+
+		serializer.vector(entries, [&entries](serializer::binary& inner, const u64 x) { serialize_entry(inner, entries[x]); });
+		VALIDATE(serializer.is_valid(), return false, "", "Project index [" << m_index_file.generic_string() << "] is corrupted, it is rebuilt by the next scan");
+
+		std::lock_guard lock(m_mutex);
+		m_entries = std::move(entries);
+		m_lookup.clear();
+		for (size_t x = 0; x < m_entries.size(); x++)
+			m_lookup[m_entries[x].project_file.generic_string()] = x;
+		m_dirty = false;
+
+		LOG(Trace, "Loaded [" << m_entries.size() << "] projects from the project index");
+		return true;
+	}
+
+
+	void project_index::save() {
+
+		PROFILE_FUNCTION();
+
+		std::lock_guard save_lock(m_save_mutex);
+		std::vector<entry> entries{};
+		{
+			std::lock_guard lock(m_mutex);
+			if (!m_dirty)
+				return;
+
+			entries = m_entries;
+			m_dirty = false;
+		}
+
+		io::create_directory(m_index_file.parent_path());
+		u32 version = INDEX_VERSION;
+		serializer::binary(m_index_file, INDEX_SECTION, serializer::option::save_to_file)
+			.entry(version)
+			.vector(entries, [&entries](serializer::binary& inner, const u64 x) { serialize_entry(inner, entries[x]); });
+	}
+
+
+	std::vector<project_data> project_index::get_projects() const {
+
+		std::lock_guard lock(m_mutex);
+		std::vector<project_data> projects{};
+		projects.reserve(m_entries.size());
+		for (const auto& entry : m_entries)
+			projects.push_back(entry.data);
+		return projects;
+	}
+
+
+	u32 project_index::get_project_count() const {
+
+		std::lock_guard lock(m_mutex);
+		return static_cast<u32>(m_entries.size());
+	}
+
+
+	u32 project_index::begin_scan() {
+
+		std::lock_guard lock(m_mutex);
+		return ++m_scan;
+	}
+
+
+	std::optional<project_data> project_index::update(const std::filesystem::path& project_file) {
+
+		const std::optional<file_stamp> stamp = get_stamp(project_file);
+		if (!stamp)
+			return std::nullopt;
+
+		const std::string key = project_file.generic_string();
+		{
+			std::lock_guard lock(m_mutex);
+			const auto found = m_lookup.find(key);
+			if (found != m_lookup.end()) {
+
+				entry& current = m_entries[found->second];
+				current.last_seen_scan = m_scan;
+				if (current.stamp == *stamp)
+					return std::nullopt;							// unchanged, nothing to parse
+			}
+		}
+
+		// parsed without the lock, several crawler threads parse at the same time
+		project_data data = parse(project_file);
+
+		std::lock_guard lock(m_mutex);
+		const auto found = m_lookup.find(key);
+		if (found == m_lookup.end()) {
+
+			m_lookup.emplace(key, m_entries.size());
+			m_entries.push_back({ project_file, *stamp, data, m_scan });
+
+		} else {
+
+			entry& current = m_entries[found->second];
+			data.statistics = current.data.statistics;				// only the project file changed, see [project_statistics_indexer]
+			current.stamp = *stamp;
+			current.data = data;
+			current.last_seen_scan = m_scan;
+		}
+		m_dirty = true;
+		return data;
+	}
+
+
+	void project_index::finish_scan(const u32 scan, std::vector<project_data>& changed, std::vector<std::filesystem::path>& removed) {
+
+		std::vector<std::filesystem::path> unseen{};
+		{
+			std::lock_guard lock(m_mutex);
+			for (const auto& entry : m_entries)
+				if (entry.last_seen_scan != scan)
+					unseen.push_back(entry.project_file);
+		}
+
+		for (const auto& project_file : unseen) {
+
+			if (!get_stamp(project_file)) {
+
+				std::lock_guard lock(m_mutex);
+				const auto found = m_lookup.find(project_file.generic_string());
+				if (found == m_lookup.end())
+					continue;
+
+				removed.push_back(m_entries[found->second].data.project_path);
+				remove_entry(found->second);
+				continue;
+			}
+
+			// outside of the scanned folders (added as a single file) or in a skipped folder
+			if (std::optional<project_data> data = update(project_file))
+				changed.push_back(std::move(*data));
+		}
+	}
+
+
+	void project_index::remove(const std::filesystem::path& project_file) {
+
+		std::lock_guard lock(m_mutex);
+		const auto found = m_lookup.find(project_file.generic_string());
+		if (found != m_lookup.end())
+			remove_entry(found->second);
+	}
+
+
+	void project_index::set_last_modified(const std::filesystem::path& project_file, const system_time& time) {
+
+		std::lock_guard lock(m_mutex);
+		const auto found = m_lookup.find(project_file.generic_string());
+		if (found == m_lookup.end() || m_entries[found->second].data.last_modified == time)
+			return;
+
+		m_entries[found->second].data.last_modified = time;
+		m_dirty = true;
+	}
+
+
+	bool project_index::set_statistics(const std::filesystem::path& project_file, const project_statistics& statistics) {
+
+		std::lock_guard lock(m_mutex);
+		const auto found = m_lookup.find(project_file.generic_string());
+		if (found == m_lookup.end())
+			return false;
+
+		m_entries[found->second].data.statistics = statistics;
+		m_dirty = true;
+		return true;
+	}
+
+
+	void project_index::serialize_entry(serializer::binary& serializer, entry& current) {
+
+		project_statistics& statistics = current.data.statistics;
+		serializer.entry(current.project_file)
+			.entry(current.stamp.modified)
+			.entry(current.stamp.size)
+			.entry(current.stamp.inode)
+			.fields(current.data)
+			.entry(current.data.tags)
+			.entry(statistics.disk_usage)
+			.entry(statistics.file_count)
+			.entry(statistics.mesh_count)
+			.entry(statistics.texture_count)
+			.entry(statistics.material_count)
+			.entry(statistics.last_build)
+			.entry(statistics.valid);
+	}
+
+
+	project_data project_index::parse(const std::filesystem::path& project_file) {
+
+		project_data data{};
+		data.serialize_project_file(project_file, serializer::option::load_from_file);
+		return data;
+	}
+
+
+	void project_index::remove_entry(const size_t index) {
+
+		m_lookup.erase(m_entries[index].project_file.generic_string());
+		if (index != m_entries.size() - 1) {
+
+			m_entries[index] = std::move(m_entries.back());
+			m_lookup[m_entries[index].project_file.generic_string()] = index;
+		}
+		m_entries.pop_back();
+		m_dirty = true;
+	}
+
+}
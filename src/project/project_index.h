@@ -0,0 +1,97 @@
+#pragma once
+
+#include "util/pch.h"
+
+#include "project.h"
+
+namespace AT {
+
+	namespace serializer { class binary; }
+
+	// Persistent list of all known projects, so the launcher can show them without parsing a single project file.
+	// Every entry keeps the loaded [project_data] together with the stamp (modification time, size, inode) of its project
+	// file. A rescan only parses project files whose stamp changed, its cost grows with the number of changed files.
+	// The index is stored as one section of a [serializer::binary] file and loaded with a single read.
+	// All functions are thread-safe, update() is called by the crawler threads of the project discovery.
+	class project_index {
+	public:
+
+		// Identifies a version of a project file without reading it.
+		struct file_stamp {
+			int64					modified = 0;			// last write time in nanoseconds
+			u64						size = 0;
+			u64						inode = 0;				// 0 if the platform has none (the file is then identified by time and size)
+
+			bool operator==(const file_stamp& other) const = default;
+		};
+
+		struct entry {
+			std::filesystem::path	project_file{};
+			file_stamp				stamp{};
+			project_data			data{};
+			u32						last_seen_scan = 0;		// not stored, used to find deleted projects after a scan
+		};
+
+		// @param index_file The file the index is loaded from and saved to.
+		explicit project_index(const std::filesystem::path& index_file);
+
+		// Reads the stamp of [file] with a single stat call.
+		// @return The stamp, or std::nullopt if the file does not exist.
+		static std::optional<file_stamp> get_stamp(const std::filesystem::path& file);
+
+		// Replaces all entries with the saved index. A missing, outdated or corrupted index is logged and leaves the index empty.
+		// @return true if the index was loaded.
+		bool load();
+
+		// Writes the index if it changed since it was loaded or saved.
+		void save();
+
+		// Returns the data of all projects.
+		std::vector<project_data> get_projects() const;
+
+		u32 get_project_count() const;
+
+		// Starts a new scan, update() marks the projects it sees as part of it.
+		// @return The id of the scan for finish_scan().
+		u32 begin_scan();
+
+		// Adds or refreshes the project of [project_file]. The file is only parsed if it is new or its stamp changed.
+		// @return The data of the project if it is new or changed, std::nullopt if nothing changed or the file is gone.
+		std::optional<project_data> update(const std::filesystem::path& project_file);
+
+		// Handles the projects that a complete scan did not find: deleted files are removed, files outside the scanned
+		// folders are kept and only parsed again if their stamp changed.
+		// @param changed Receives the data of projects that were parsed again.
+		// @param removed Receives the [project_path] of removed projects.
+		void finish_scan(const u32 scan, std::vector<project_data>& changed, std::vector<std::filesystem::path>& removed);
+
+		// Removes the project of [project_file] from the index.
+		void remove(const std::filesystem::path& project_file);
+
+		// Sets [last_modified] of the project of [project_file], e.g. when a file inside the project folder changed.
+		void set_last_modified(const std::filesystem::path& project_file, const system_time& time);
+
+		// Caches the statistics of the project of [project_file], they are kept when the project file is parsed again.
+		// @return false if the project is not in the index.
+		bool set_statistics(const std::filesystem::path& project_file, const project_statistics& statistics);
+
+		static constexpr u32 INDEX_VERSION = 3;						// written before the entries, other versions are ignored
+
+	private:
+
+		static project_data parse(const std::filesystem::path& project_file);
+		static void serialize_entry(serializer::binary& serializer, entry& current);
+
+		// expects [m_mutex] to be locked
+		void remove_entry(const size_t index);
+
+		std::filesystem::path							m_index_file{};
+		mutable std::mutex								m_mutex{};
+		std::mutex										m_save_mutex{};						// an older snapshot never overrides a newer one
+		std::vector<entry>								m_entries{};
+		std::unordered_map<std::string, size_t>			m_lookup{};			// generic path of the project file => index in [m_entries]
+		u32												m_scan = 0;
+		bool											m_dirty = false;
+	};
+
+}
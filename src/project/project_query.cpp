@@ -0,0 +1,271 @@
+#include "util/pch.h"
+
+#include <bit>
+
+#include "project_store.h"
+#include "project_query.h"
+
+
+namespace AT {
+
+	static constexpr std::string_view NO_TAGS_LABEL = "No tags";
+
+
+	u64 project_query::pack(const system_time& time) {
+
+		return (static_cast<u64>(time.year) << 36) | (static_cast<u64>(time.month) << 32) | (static_cast<u64>(time.day) << 27)
+			| (static_cast<u64>(time.hour) << 22) | (static_cast<u64>(time.minute) << 16) | (static_cast<u64>(time.secund) << 10) | time.millisecend;
+	}
+
+
+	u64 project_query::pack(const version& value) { return (static_cast<u64>(value.major) << 32) | (static_cast<u64>(value.minor) << 16) | value.patch; }
+
+
+	void project_query::rebuild(const project_store& projects) {
+
+		PROFILE_FUNCTION();
+
+		const u32 count = projects.size();
+
+		// tags keep the ids of the store, their facets are sorted by name
+		m_tag_words = projects.get_tag_words();
+		m_tag_bits.resize(static_cast<size_t>(count) * m_tag_words);
+		for (u32 x = 0; x < count; x++) {
+
+			const std::span<const u64> bits = projects.get_tag_bits(x);
+			std::copy(bits.begin(), bits.end(), m_tag_bits.begin() + static_cast<size_t>(x) * m_tag_words);
+		}
+
+		m_tag_labels.resize(projects.get_tag_count());
+		for (u32 x = 0; x < m_tag_labels.size(); x++)
+			m_tag_labels[x] = projects.get_tag(x);
+
+		// engine versions, ids from new to old
+		m_engine_versions.clear();
+		for (u32 x = 0; x < count; x++)
+			m_engine_versions.push_back(pack(projects.get_engine_version(x)));
+		std::sort(m_engine_versions.begin(), m_engine_versions.end(), std::greater<u64>());
+		m_engine_versions.erase(std::unique(m_engine_versions.begin(), m_engine_versions.end()), m_engine_versions.end());
+
+		m_engine_labels.clear();
+		for (const u64 packed : m_engine_versions)
+			m_engine_labels.push_back(std::to_string(packed >> 32) + '.' + std::to_string((packed >> 16) & 0xFFFF) + '.' + std::to_string(packed & 0xFFFF));
+
+		m_engine_ids.resize(count);
+		for (u32 x = 0; x < count; x++)
+			m_engine_ids[x] = static_cast<u32>(std::lower_bound(m_engine_versions.begin(), m_engine_versions.end(), pack(projects.get_engine_version(x)), std::greater<u64>()) - m_engine_versions.begin());
+
+		// one ascending order per sort key, sorted as (key, index) pairs so equal keys keep the order of the project list
+		std::vector<std::pair<u64, u32>> keys(count);
+		auto sort_by = [&](const sort_key key, const auto& key_of) {
+
+			for (u32 x = 0; x < count; x++)
+				keys[x] = { key_of(x), x };
+			std::sort(keys.begin(), keys.end());
+
+			std::vector<u32>& order = m_orders[static_cast<size_t>(key)];
+			order.resize(count);
+			for (u32 x = 0; x < count; x++)
+				order[x] = keys[x].second;
+		};
+
+		sort_by(sort_key::last_modified, [&](const u32 x) { return pack(projects.get_last_modified(x)); });
+		sort_by(sort_key::engine_version, [&](const u32 x) { return pack(projects.get_engine_version(x)); });
+		sort_by(sort_key::project_version, [&](const u32 x) { return pack(projects.get_project_version(x)); });
+
+		// names: the first 8 characters (lower case) as the key, only runs with an equal key compare the whole name
+		std::vector<std::string> names(count);
+		for (u32 x = 0; x < count; x++) {
+
+			names[x] = projects.get_display_name(x);
+			std::transform(names[x].begin(), names[x].end(), names[x].begin(), [](const char character) { return static_cast<char>(std::tolower(static_cast<unsigned char>(character))); });
+		}
+
+		sort_by(sort_key::name, [&names](const u32 x) {
+			const std::string& name = names[x];
+			u64 key = 0;
+			for (size_t x = 0; x < 8; x++)
+				key = (key << 8) | (x < name.size() ? static_cast<u8>(name[x]) : 0);
+			return key;
+		});
+
+		std::vector<u32>& name_order = m_orders[static_cast<size_t>(sort_key::name)];
+		for (u32 first = 0; first < count; ) {
+
+			u32 last = first + 1;
+			while (last < count && keys[last].first == keys[first].first)
+				last++;
+
+			if (last - first > 1) {
+
+				std::sort(name_order.begin() + first, name_order.begin() + last, [&names](const u32 left, const u32 right) {
+					const int result = std::string_view(names[left]).substr(std::min<size_t>(names[left].size(), 8)).compare(std::string_view(names[right]).substr(std::min<size_t>(names[right].size(), 8)));
+					return result != 0 ? result < 0 : left < right;
+				});
+			}
+			first = last;
+		}
+
+		m_tag_facets.clear();
+		for (u32 x = 0; x < m_tag_labels.size(); x++)
+			m_tag_facets.push_back({ m_tag_labels[x], x, 0 });
+		std::sort(m_tag_facets.begin(), m_tag_facets.end(), [](const facet& left, const facet& right) { return left.label < right.label; });
+
+		m_facet_of_tag.resize(m_tag_facets.size());
+		for (u32 x = 0; x < m_tag_facets.size(); x++)
+			m_facet_of_tag[m_tag_facets[x].id] = x;
+
+		m_engine_facets.clear();
+		for (u32 x = 0; x < m_engine_labels.size(); x++)
+			m_engine_facets.push_back({ m_engine_labels[x], x, 0, m_engine_versions[x] });
+
+		m_result_valid = false;
+	}
+
+
+	std::span<const u32> project_query::execute(const parameters& query) {
+
+		if (m_result_valid && query == m_last_query)
+			return m_result;
+
+		PROFILE_FUNCTION();
+
+		m_last_query = query;
+		m_result_valid = true;
+
+		// the filters are given by value, the ids change with every rebuild()
+		m_required_bits.assign(m_tag_words, 0);
+		m_unknown_tag = false;
+		for (const auto& tag : query.required_tags) {
+
+			const auto found = std::lower_bound(m_tag_facets.begin(), m_tag_facets.end(), tag, [](const facet& entry, const std::string& label) { return entry.label < label; });
+			if (found == m_tag_facets.end() || found->label != tag) {
+
+				m_unknown_tag = true;
+				continue;
+			}
+			const u32 id = found->id;
+			m_required_bits[id / 64] |= u64(1) << (id % 64);
+		}
+
+		m_required_engine.reset();
+		if (query.engine_version) {
+
+			const auto found = std::lower_bound(m_engine_versions.begin(), m_engine_versions.end(), *query.engine_version, std::greater<u64>());
+			m_required_engine = (found != m_engine_versions.end() && *found == *query.engine_version) ? static_cast<u32>(found - m_engine_versions.begin()) : static_cast<u32>(m_engine_versions.size());
+		}
+
+		// filter while walking the precomputed order
+		const std::vector<u32>& order = m_orders[static_cast<size_t>(query.sort)];
+		const u32 count = static_cast<u32>(order.size());
+		m_filtered.clear();
+		for (u32 x = 0; x < count; x++) {
+
+			const u32 index = query.descending ? order[count - 1 - x] : order[x];
+			if (passes_filters(index))
+				m_filtered.push_back(index);
+		}
+
+		// facets
+		for (auto& facet : m_tag_facets)
+			facet.count = 0;
+		for (auto& facet : m_engine_facets)
+			facet.count = 0;
+
+		u32 untagged = 0;
+		for (const u32 index : m_filtered) {
+
+			m_engine_facets[m_engine_ids[index]].count++;
+
+			bool tagged = false;
+			for (u32 word = 0; word < m_tag_words; word++) {
+
+				for (u64 bits = m_tag_bits[static_cast<size_t>(index) * m_tag_words + word]; bits; bits &= bits - 1) {
+
+					m_tag_facets[m_facet_of_tag[word * 64 + std::countr_zero(bits)]].count++;
+					tagged = true;
+				}
+			}
+			untagged += tagged ? 0 : 1;
+		}
+
+		m_groups.clear();
+		switch (query.group) {
+
+			case group_key::none: {
+
+				m_result.assign(m_filtered.begin(), m_filtered.end());
+				m_groups.push_back({ {}, 0, static_cast<u32>(m_result.size()) });
+			} break;
+
+			// counting sort into the groups, stable so every group keeps the sort order
+			case group_key::engine_version: {
+
+				m_offsets.resize(m_engine_facets.size());
+				u32 offset = 0;
+				for (const auto& facet : m_engine_facets) {
+
+					m_offsets[facet.id] = offset;
+					if (facet.count)
+						m_groups.push_back({ facet.label, offset, facet.count });
+					offset += facet.count;
+				}
+
+				m_result.resize(offset);
+				for (const u32 index : m_filtered)
+					m_result[m_offsets[m_engine_ids[index]]++] = index;
+			} break;
+
+			case group_key::tag: {
+
+				m_offsets.resize(m_tag_facets.size() + 1);				// the last group holds the projects without tags
+				u32 offset = 0;
+				for (const auto& facet : m_tag_facets) {
+
+					m_offsets[facet.id] = offset;
+					if (facet.count)
+						m_groups.push_back({ facet.label, offset, facet.count });
+					offset += facet.count;
+				}
+				m_offsets.back() = offset;
+				if (untagged)
+					m_groups.push_back({ NO_TAGS_LABEL, offset, untagged });
+
+				m_result.resize(offset + untagged);
+				for (const u32 index : m_filtered) {
+
+					bool tagged = false;
+					for (u32 word = 0; word < m_tag_words; word++) {
+
+						for (u64 bits = m_tag_bits[static_cast<size_t>(index) * m_tag_words + word]; bits; bits &= bits - 1) {
+
+							m_result[m_offsets[word * 64 + std::countr_zero(bits)]++] = index;
+							tagged = true;
+						}
+					}
+					if (!tagged)
+						m_result[m_offsets.back()++] = index;
+				}
+			} break;
+		}
+
+		return m_result;
+	}
+
+
+	bool project_query::matches(const u32 index) const { return m_result_valid && index < m_engine_ids.size() && passes_filters(index); }
+
+
+	bool project_query::passes_filters(const u32 index) const {
+
+		if (m_unknown_tag || (m_required_engine && m_engine_ids[index] != *m_required_engine))
+			return false;
+
+		const u64* bits = m_tag_bits.data() + static_cast<size_t>(index) * m_tag_words;
+		for (u32 word = 0; word < m_tag_words; word++)
+			if ((bits[word] & m_required_bits[word]) != m_required_bits[word])
+				return false;
+		return true;
+	}
+
+}
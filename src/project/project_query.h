@@ -0,0 +1,111 @@
+#pragma once
+
+#include "util/pch.h"
+
+namespace AT {
+
+	class project_store;
+
+	// Sorts, filters and groups the user projects for the projects view, and counts them per tag and engine version (facets).
+	// rebuild() reads the arrays of a [project_store]: every sort key is packed into an integer and the sorted order for
+	// every key is computed once, tags keep the bit per tag of the store and engine versions are interned into small ids.
+	// execute() then only walks a precomputed order and tests bits, it reuses its buffers and returns the cached result
+	// while the parameters and the projects did not change, so it can be called every frame.
+	class project_query {
+	public:
+
+		enum class sort_key : u8 {
+			last_modified = 0,
+			name,
+			engine_version,
+			project_version,
+			count,
+		};
+
+		enum class group_key : u8 {
+			none = 0,
+			tag,
+			engine_version,
+		};
+
+		struct parameters {
+			sort_key				sort = sort_key::last_modified;
+			bool					descending = true;
+			group_key				group = group_key::none;
+			std::vector<std::string>	required_tags{};		// tags a project needs all of
+			std::optional<u64>		engine_version{};			// the only engine version that is shown, see pack()
+
+			bool operator==(const parameters& other) const = default;
+		};
+
+		// A tag or engine version with the number of projects of the current result that have it.
+		struct facet {
+			std::string_view		label{};
+			u32						id = 0;
+			u32						count = 0;
+			u64						engine_version = 0;			// packed, only set for engine version facets
+		};
+
+		// A range of the result of execute(), every group is sorted by the sort key.
+		struct group {
+			std::string_view		label{};
+			u32						first = 0;
+			u32						count = 0;
+		};
+
+		// Reads [projects], the indices of all results refer to the store. Call again after the store changed.
+		void rebuild(const project_store& projects);
+
+		// @return Indices of the projects that pass the filters of [query], sorted and grouped. With a [group_key::tag]
+		//         a project is listed once for every tag (and in "No tags" without one). Valid until the next rebuild() or execute().
+		std::span<const u32> execute(const parameters& query);
+
+		// Checks the filters of the last execute() for a single project, e.g. for a search result.
+		bool matches(const u32 index) const;
+
+		// Groups of the last execute(), empty groups are left out. A single unnamed group without [group_key].
+		std::span<const group> get_groups() const						{ return m_groups; }
+
+		// All tags in alphabetical order, counted over the last execute().
+		std::span<const facet> get_tag_facets() const					{ return m_tag_facets; }
+
+		// All engine versions from new to old, counted over the last execute().
+		std::span<const facet> get_engine_version_facets() const		{ return m_engine_facets; }
+
+		u32 size() const												{ return static_cast<u32>(m_engine_ids.size()); }
+
+		// Packs [time] into an integer with the same order as the comparison operators of [system_time].
+		static u64 pack(const system_time& time);
+
+		// Packs [value] into an integer that sorts like major, minor, patch.
+		static u64 pack(const version& value);
+
+	private:
+
+		bool passes_filters(const u32 index) const;
+
+		u32											m_tag_words = 0;			// u64 words per project in [m_tag_bits]
+		std::vector<u64>							m_tag_bits{};				// [m_tag_words] per project, bit = tag id
+		std::vector<u32>							m_engine_ids{};				// engine version id per project
+		std::vector<u64>							m_engine_versions{};		// packed, by id
+		std::array<std::vector<u32>, static_cast<size_t>(sort_key::count)>	m_orders{};		// ascending order of every sort key
+
+		std::vector<std::string>					m_tag_labels{};				// by tag id
+		std::vector<u32>							m_facet_of_tag{};			// tag id => index in [m_tag_facets]
+		std::vector<std::string>					m_engine_labels{};
+		std::vector<facet>							m_tag_facets{};
+		std::vector<facet>							m_engine_facets{};
+
+		// buffers of execute(), reused every call
+		parameters									m_last_query{};
+		bool										m_result_valid = false;
+		std::vector<u64>							m_required_bits{};
+		std::optional<u32>							m_required_engine{};		// id, [m_engine_versions].size() if the version is unknown
+		bool										m_unknown_tag = false;		// a required tag no project has, nothing passes
+		std::vector<u32>							m_filtered{};
+		std::vector<u32>							m_result{};
+		std::vector<u32>							m_offsets{};
+		std::vector<group>							m_groups{};
+	};
+
+}
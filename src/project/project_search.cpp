@@ -0,0 +1,252 @@
+#include "util/pch.h"
+
+#include "project_search.h"
+
+
+namespace AT {
+
+	// scoring of fzf (algorithm v1), the best window is found by a forward and a backward scan
+	static constexpr int32 SCORE_MATCH = 16;
+	static constexpr int32 SCORE_GAP_START = -3;
+	static constexpr int32 SCORE_GAP_EXTENSION = -1;
+	static constexpr u8 BONUS_WHITESPACE = 10;				// start of a field or word
+	static constexpr u8 BONUS_DELIMITER = 9;				// after '/', '_', '-', ...
+	static constexpr u8 BONUS_CAMEL_CASE = 7;				// "projectName", "level2"
+	static constexpr u8 BONUS_CONSECUTIVE = 4;
+	static constexpr int32 BONUS_FIRST_CHAR_MULTIPLIER = 2;
+
+	static constexpr char FIELD_SEPARATOR = '\n';
+
+	enum class char_class : u8 { whitespace, delimiter, lower, upper, digit, other };
+
+	static char_class classify(const char character) {
+
+		if (character >= 'a' && character <= 'z')				return char_class::lower;
+		if (character >= 'A' && character <= 'Z')				return char_class::upper;
+		if (character >= '0' && character <= '9')				return char_class::digit;
+		if (character == ' ' || character == '\t' || character == FIELD_SEPARATOR)
+																return char_class::whitespace;
+		if (std::string_view("/\\_-.,:;").find(character) != std::string_view::npos)
+																return char_class::delimiter;
+		return char_class::other;
+	}
+
+	static u8 bonus_for(const char_class previous, const char_class current) {
+
+		if (current == char_class::whitespace || current == char_class::delimiter)
+			return 0;
+		if (previous == char_class::whitespace)
+			return BONUS_WHITESPACE;
+		if (previous == char_class::delimiter)
+			return BONUS_DELIMITER;
+		if ((previous == char_class::lower && current == char_class::upper) || (previous != char_class::digit && current == char_class::digit))
+			return BONUS_CAMEL_CASE;
+		return 0;
+	}
+
+	static char to_lower(const char character) { return (character >= 'A' && character <= 'Z') ? static_cast<char>(character + ('a' - 'A')) : character; }
+
+
+	u64 project_search::character_mask(std::string_view text) {
+
+		// letters and digits get their own bit, other characters share the remaining bits (a shared bit can only let a project through)
+		u64 mask = 0;
+		for (const char character : text) {
+
+			const u8 value = static_cast<u8>(character);
+			if (value >= 'a' && value <= 'z')
+				mask |= u64(1) << (value - 'a');
+			else if (value >= '0' && value <= '9')
+				mask |= u64(1) << (26 + value - '0');
+			else
+				mask |= u64(1) << (36 + value % 28);
+		}
+		return mask;
+	}
+
+
+	project_search::entry project_search::make_entry(const project_data& project) {
+
+		std::string original = project.display_name;
+		for (const std::string& field : { project.name, project.project_path.generic_string(), project.description })
+			original.append(1, FIELD_SEPARATOR).append(field);
+		for (const std::string& tag : project.tags)
+			original.append(1, FIELD_SEPARATOR).append(tag);
+
+		entry result{};
+		result.text.resize(original.size());
+		result.bonus.resize(original.size());
+		char_class previous = char_class::whitespace;
+		for (size_t x = 0; x < original.size(); x++) {
+
+			const char_class current = classify(original[x]);
+			result.text[x] = to_lower(original[x]);
+			result.bonus[x] = bonus_for(previous, current);
+			previous = current;
+		}
+		return result;
+	}
+
+
+	void project_search::rebuild(const std::vector<project_data>& projects) {
+
+		m_masks.clear();
+		m_entries.clear();
+		m_masks.reserve(projects.size());
+		m_entries.reserve(projects.size());
+		for (const auto& project : projects)
+			append(project);
+	}
+
+
+	void project_search::append(const project_data& project) {
+
+		m_entries.push_back(make_entry(project));
+		m_masks.push_back(character_mask(m_entries.back().text));
+		m_results_valid = false;
+	}
+
+
+	void project_search::set(const u32 index, const project_data& project) {
+
+		VALIDATE(index < m_entries.size(), return, "", "Search entry [" << index << "] does not exist");
+		m_entries[index] = make_entry(project);
+		m_masks[index] = character_mask(m_entries[index].text);
+		m_results_valid = false;
+	}
+
+
+	void project_search::erase(const u32 index) {
+
+		VALIDATE(index < m_entries.size(), return, "", "Search entry [" << index << "] does not exist");
+		m_entries.erase(m_entries.begin() + index);
+		m_masks.erase(m_masks.begin() + index);
+		m_results_valid = false;
+	}
+
+
+	std::span<const u32> project_search::search(std::string_view query) {
+
+		PROFILE_FUNCTION();
+
+		std::string lower_query(query.size(), '\0');
+		std::transform(query.begin(), query.end(), lower_query.begin(), to_lower);
+		std::erase_if(lower_query, [](const char character) { return character == ' ' || character == '\t'; });
+
+		if (lower_query.empty()) {
+
+			m_results.resize(m_entries.size());
+			for (u32 index = 0; index < m_results.size(); index++)
+				m_results[index] = index;
+			m_last_query.clear();
+			m_results_valid = true;
+			return m_results;
+		}
+
+		// a longer query matches a subset of the projects of a shorter one
+		const bool narrow = m_results_valid && !m_last_query.empty() && lower_query.starts_with(m_last_query);
+		const u64 query_mask = character_mask(lower_query);
+		m_ranking.clear();
+
+		auto rank = [&](const u32 index) {
+
+			if ((m_masks[index] & query_mask) != query_mask)
+				return;
+
+			const std::optional<int32> result = score(m_entries[index].text, m_entries[index].bonus.data(), lower_query);
+			if (!result)
+				return;
+
+			// higher scores first, equal scores keep the order of the project list. Scores can be negative (gap penalties),
+			// unsigned arithmetic wraps them above every positive score instead of overflowing
+			const u32 inverted = 0x7FFFFFFFu - static_cast<u32>(*result);
+			const u64 key = (static_cast<u64>(inverted) << 32) | index;
+			m_ranking.push_back(key);
+		};
+
+		if (narrow) {
+
+			for (const u32 index : m_results)
+				rank(index);
+
+		} else {
+
+			for (u32 index = 0; index < m_entries.size(); index++)
+				rank(index);
+		}
+
+		std::sort(m_ranking.begin(), m_ranking.end());
+		m_results.resize(m_ranking.size());
+		for (size_t x = 0; x < m_ranking.size(); x++)
+			m_results[x] = static_cast<u32>(m_ranking[x] & 0xFFFFFFFF);
+
+		m_last_query = std::move(lower_query);
+		m_results_valid = true;
+		return m_results;
+	}
+
+
+	std::optional<int32> project_search::score(std::string_view text, const u8* bonus, std::string_view query) {
+
+		if (query.empty())
+			return 0;
+
+		// forward: the first position where all query characters appeared in order, memchr skips the gaps
+		size_t position = 0;
+		for (const char character : query) {
+
+			const void* found = (position < text.size()) ? std::memchr(text.data() + position, character, text.size() - position) : nullptr;
+			if (!found)
+				return std::nullopt;
+			position = static_cast<const char*>(found) - text.data() + 1;
+		}
+		const size_t end = position;
+
+		// backward: the shortest window that ends there
+		size_t start = end;
+		for (size_t query_index = query.size(); query_index > 0; ) {
+
+			start--;
+			if (text[start] == query[query_index - 1])
+				query_index--;
+		}
+
+		int32 result = 0;
+		size_t query_index = 0;
+		bool in_gap = false;
+		u32 consecutive = 0;
+		u8 first_bonus = 0;
+		for (size_t x = start; x < end; x++) {
+
+			if (query_index < query.size() && text[x] == query[query_index]) {
+
+				u8 current = bonus[x];
+				if (consecutive == 0) {
+
+					first_bonus = current;
+
+				} else {
+
+					// a run of matches keeps the bonus of its start, a better boundary inside the run replaces it
+					if (current >= BONUS_DELIMITER && current > first_bonus)
+						first_bonus = current;
+					current = std::max({ current, first_bonus, BONUS_CONSECUTIVE });
+				}
+
+				result += SCORE_MATCH + (query_index == 0 ? current * BONUS_FIRST_CHAR_MULTIPLIER : current);
+				in_gap = false;
+				consecutive++;
+				query_index++;
+
+			} else {
+
+				result += in_gap ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+				in_gap = true;
+				consecutive = 0;
+				first_bonus = 0;
+			}
+		}
+		return result;
+	}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "util/pch.h"
+
+#include "project.h"
+
+namespace AT {
+
+	// Fuzzy search over the user projects (display name, name, tags, description and path), ranked like fzf:
+	// the query characters have to appear in order, consecutive characters and characters at word starts score higher.
+	// Every project keeps its searchable text in lower case together with the bonus of every character, both are computed
+	// when the project is added, so a search does no allocation per project. A mask of the characters of every project is
+	// checked first, most projects are rejected by one AND over a contiguous array.
+	// A query that extends the previous one only searches the previous matches, so typing gets cheaper with every key.
+	// The entries mirror the order of the project list, results are indices into that list.
+	class project_search {
+	public:
+
+		// Replaces all entries with [projects].
+		void rebuild(const std::vector<project_data>& projects);
+
+		void append(const project_data& project);
+
+		// Replaces the entry at [index] (e.g. a project that was loaded again).
+		void set(const u32 index, const project_data& project);
+
+		// Removes the entry at [index], the following entries move one index down like in the project list.
+		void erase(const u32 index);
+
+		u32 size() const															{ return static_cast<u32>(m_masks.size()); }
+
+		// Searches the projects for [query], case is ignored.
+		// @return Indices of the matching projects, best match first. All indices in order if [query] is empty.
+		//         Valid until the next call of a non-const function.
+		std::span<const u32> search(std::string_view query);
+
+		// Scores [text] (lower case) with the [bonus] of each of its characters for [query] (lower case).
+		// @return The score, or std::nullopt if [text] does not contain the characters of [query] in order.
+		static std::optional<int32> score(std::string_view text, const u8* bonus, std::string_view query);
+
+	private:
+
+		struct entry {
+			std::string				text{};				// searchable fields in lower case, separated by '\n'
+			std::vector<u8>			bonus{};			// bonus of a match at each character of [text]
+		};
+
+		static entry make_entry(const project_data& project);
+		static u64 character_mask(std::string_view text);
+
+		std::vector<u64>			m_masks{};			// characters contained in an entry, kept apart from [m_entries] for a dense scan
+		std::vector<entry>			m_entries{};
+		std::vector<u32>			m_results{};
+		std::vector<u64>			m_ranking{};		// score and index of a match packed into one sort key
+		std::string					m_last_query{};
+		bool						m_results_valid = false;		// [m_results] are the matches of [m_last_query] over the current entries
+	};
+
+}
@@ -0,0 +1,222 @@
+#include "util/pch.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#elif defined(PLATFORM_LINUX)
+	#include <fcntl.h>
+	#include <sys/stat.h>
+#else
+	#error undefined platform
+#endif
+
+#include "util/io/directory_crawler.h"
+
+#include "project_statistics.h"
+
+
+namespace AT {
+
+	struct file_usage {
+		u64						allocated = 0;				// bytes on disk
+		int64					modified = 0;				// ns since epoch
+	};
+
+
+	static std::optional<file_usage> get_file_usage(const std::filesystem::path& file) {
+
+#if defined(PLATFORM_WINDOWS)
+
+		WIN32_FILE_ATTRIBUTE_DATA attributes{};
+		if (!GetFileAttributesExW(file.wstring().c_str(), GetFileExInfoStandard, &attributes))
+			return std::nullopt;
+
+		// FILETIME counts 100ns intervals since 1601, the allocation size would need a handle per file, the size is close enough
+		static constexpr u64 UNIX_EPOCH = 116444736000000000;
+		const u64 write_time = (static_cast<u64>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+		const u64 size = (static_cast<u64>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+		return file_usage{ size, static_cast<int64>(write_time - UNIX_EPOCH) * 100 };
+
+#elif defined(PLATFORM_LINUX)
+
+		// only the requested fields, and no round trip to the server on network file systems
+		struct statx status{};
+		if (::statx(AT_FDCWD, file.c_str(), AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, STATX_BLOCKS | STATX_MTIME, &status) != 0)
+			return std::nullopt;
+
+		return file_usage{ static_cast<u64>(status.stx_blocks) * 512, static_cast<int64>(status.stx_mtime.tv_sec) * 1'000'000'000 + status.stx_mtime.tv_nsec };
+#endif
+	}
+
+
+	project_statistics_indexer::project_statistics_indexer(const u32 thread_count)
+		: m_crawler(std::make_unique<io::directory_crawler>(thread_count)) {
+
+		m_crawler->set_skipped_directories({});						// everything in the content folder counts
+	}
+
+
+	project_statistics_indexer::~project_statistics_indexer() { stop(); }
+
+
+	void project_statistics_indexer::request(const std::filesystem::path& project_path, const std::filesystem::path& build_path) {
+
+		{
+			std::lock_guard lock(m_mutex);
+			if (!m_queued.insert(project_path.generic_string()).second)
+				return;
+
+			m_queue.push_back({ project_path, build_path });
+			if (!m_thread.joinable()) {
+
+				m_stop = false;
+				m_thread = std::thread(&project_statistics_indexer::run, this);
+			}
+		}
+		m_condition.notify_one();
+	}
+
+
+	void project_statistics_indexer::collect(std::vector<result>& results) {
+
+		std::lock_guard lock(m_mutex);
+		std::move(m_results.begin(), m_results.end(), std::back_inserter(results));
+		m_results.clear();
+	}
+
+
+	void project_statistics_indexer::stop() {
+
+		{
+			std::lock_guard lock(m_mutex);
+			m_stop = true;
+			m_queue.clear();
+			m_queued.clear();
+		}
+		m_crawler->cancel();
+		m_condition.notify_all();
+
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+
+	bool project_statistics_indexer::is_running() const {
+
+		std::lock_guard lock(m_mutex);
+		return m_busy || !m_queue.empty();
+	}
+
+
+	project_statistics_indexer::asset_type project_statistics_indexer::get_asset_type(std::string_view file_name) {
+
+		static const std::unordered_map<std::string_view, asset_type> s_types = {
+			{ "gltf", asset_type::mesh },		{ "glb", asset_type::mesh },		{ "fbx", asset_type::mesh },		{ "obj", asset_type::mesh },
+			{ "dae", asset_type::mesh },		{ "blend", asset_type::mesh },		{ "3ds", asset_type::mesh },
+			{ "png", asset_type::texture },		{ "jpg", asset_type::texture },		{ "jpeg", asset_type::texture },	{ "tga", asset_type::texture },
+			{ "bmp", asset_type::texture },		{ "hdr", asset_type::texture },		{ "exr", asset_type::texture },		{ "dds", asset_type::texture },
+			{ "ktx", asset_type::texture },		{ "ktx2", asset_type::texture },	{ "psd", asset_type::texture },
+			{ "mat", asset_type::material },	{ "material", asset_type::material },	{ "mtl", asset_type::material },	{ "matinst", asset_type::material },
+		};
+
+		const size_t dot = file_name.rfind('.');
+		if (dot == std::string_view::npos || file_name.size() - dot - 1 > 8)
+			return asset_type::other;
+
+		char extension[9]{};
+		for (size_t x = dot + 1; x < file_name.size(); x++)
+			extension[x - dot - 1] = static_cast<char>(std::tolower(static_cast<unsigned char>(file_name[x])));
+
+		const auto found = s_types.find(extension);
+		return found != s_types.end() ? found->second : asset_type::other;
+	}
+
+
+	void project_statistics_indexer::run() {
+
+		while (true) {
+
+			request_entry next{};
+			{
+				std::unique_lock lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+				if (m_stop)
+					return;
+
+				next = std::move(m_queue.front());
+				m_queue.pop_front();
+				m_queued.erase(next.project_path.generic_string());
+				m_busy = true;
+			}
+
+			result current{ next.project_path, project_data::find_project_file(next.project_path), compute(next.project_path, next.build_path) };
+
+			std::lock_guard lock(m_mutex);
+			m_busy = false;
+			if (m_stop)
+				return;															// a cancelled walk is incomplete
+
+			m_results.push_back(std::move(current));
+		}
+	}
+
+
+	project_statistics project_statistics_indexer::compute(const std::filesystem::path& project_path, const std::filesystem::path& build_path) {
+
+		PROFILE_FUNCTION();
+
+		struct counters {
+			std::atomic<u64>	disk_usage = 0;
+			std::atomic<u32>	files = 0;
+			std::atomic<u32>	meshes = 0;
+			std::atomic<u32>	textures = 0;
+			std::atomic<u32>	materials = 0;
+		} totals{};
+
+		std::error_code error_code;
+		const std::filesystem::path content_path = project_path / CONTENT_DIR;
+		if (std::filesystem::is_directory(content_path, error_code)) {
+
+			{
+				// under the lock, stop() either comes first or cancels this walk
+				std::lock_guard lock(m_mutex);
+				if (m_stop)
+					return {};
+
+				m_crawler->start({ content_path }, [](std::string_view) { return true; }, [&totals](const std::filesystem::path& file) {
+
+					const std::optional<file_usage> usage = get_file_usage(file);
+					if (!usage)
+						return;
+
+					totals.disk_usage.fetch_add(usage->allocated, std::memory_order_relaxed);
+					totals.files.fetch_add(1, std::memory_order_relaxed);
+					switch (get_asset_type(file.filename().string())) {
+						case asset_type::mesh:		totals.meshes.fetch_add(1, std::memory_order_relaxed); break;
+						case asset_type::texture:	totals.textures.fetch_add(1, std::memory_order_relaxed); break;
+						case asset_type::material:	totals.materials.fetch_add(1, std::memory_order_relaxed); break;
+						default: break;
+					}
+				});
+			}
+			m_crawler->wait();
+		}
+
+		project_statistics statistics{};
+		statistics.disk_usage = totals.disk_usage.load();
+		statistics.file_count = totals.files.load();
+		statistics.mesh_count = totals.meshes.load();
+		statistics.texture_count = totals.textures.load();
+		statistics.material_count = totals.materials.load();
+		statistics.valid = true;
+
+		// top level only, a build replaces the files of its output folder
+		const std::filesystem::path build_folder = build_path.empty() ? project_path / PROJECT_TEMP_DLL_PATH : project_path / build_path;
+		auto iterator = std::filesystem::directory_iterator(build_folder, error_code);
+		for (const auto end = std::filesystem::directory_iterator(); !error_code && iterator != end; iterator.increment(error_code))
+			if (const std::optional<file_usage> usage = get_file_usage(iterator->path()))
+				statistics.last_build = std::max(statistics.last_build, usage->modified);
+
+		return statistics;
+	}
+
+}
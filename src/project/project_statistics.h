@@ -0,0 +1,80 @@
+#pragma once
+
+#include "util/pch.h"
+
+#include "project.h"
+
+namespace AT {
+
+	namespace io { class directory_crawler; }
+
+	// Computes [project_statistics] on a worker thread, so the size of a large project is never computed on the UI thread.
+	// Projects are queued with request() and computed one after another: the content folder of a project is walked by the
+	// threads of an [io::directory_crawler] and every file is stat-ed on these threads (statx without syncing on Linux).
+	// Assets are counted by their file extension. The last build time is the newest write time in the build folder.
+	//
+	//   project_statistics_indexer indexer;
+	//   indexer.request(project_path, build_path);
+	//   ... every frame:
+	//   indexer.collect(results);
+	class project_statistics_indexer {
+	public:
+
+		struct result {
+			std::filesystem::path	project_path{};
+			std::filesystem::path	project_file{};				// empty if the folder has no project file
+			project_statistics		statistics{};
+		};
+
+		enum class asset_type : u8 {
+			other = 0,
+			mesh,
+			texture,
+			material,
+		};
+
+		// @param thread_count Threads that walk a project, 0 uses std::thread::hardware_concurrency().
+		explicit project_statistics_indexer(const u32 thread_count = 0);
+
+		// Stops the worker, see stop().
+		~project_statistics_indexer();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(project_statistics_indexer);
+
+		// Queues [project_path], a project that is already queued is not queued again.
+		// @param build_path The build folder of the project, relative to [project_path] or absolute. The default build folder if empty.
+		void request(const std::filesystem::path& project_path, const std::filesystem::path& build_path);
+
+		// Moves the statistics that were computed since the last call into [results].
+		void collect(std::vector<result>& results);
+
+		// Drops the queue, cancels the running walk and waits for the worker. request() starts it again.
+		void stop();
+
+		// Returns true while projects are queued or being computed.
+		bool is_running() const;
+
+		static asset_type get_asset_type(std::string_view file_name);
+
+	private:
+
+		struct request_entry {
+			std::filesystem::path	project_path{};
+			std::filesystem::path	build_path{};
+		};
+
+		void run();
+		project_statistics compute(const std::filesystem::path& project_path, const std::filesystem::path& build_path);
+
+		std::unique_ptr<io::directory_crawler>		m_crawler{};
+		std::thread									m_thread{};
+		mutable std::mutex							m_mutex{};
+		std::condition_variable						m_condition{};
+		std::deque<request_entry>					m_queue{};						// guarded by [m_mutex], like the fields below
+		std::unordered_set<std::string>				m_queued{};						// generic [project_path] of [m_queue]
+		std::vector<result>							m_results{};
+		bool										m_busy = false;
+		bool										m_stop = false;
+	};
+
+}
@@ -0,0 +1,283 @@
+#include "util/pch.h"
+
+#include "project_store.h"
+
+
+namespace AT {
+
+	void project_store::clear() {
+
+		m_strings.clear();
+		m_compacted_bytes = 0;
+		m_ids.clear();
+		m_display_names.clear();
+		m_last_modified.clear();
+		m_engine_versions.clear();
+		m_project_versions.clear();
+		m_statistics.clear();
+		m_tag_bits.clear();
+		m_tag_words = 1;
+		m_cold.clear();
+		m_tag_names.clear();
+		m_tag_ids.clear();
+		m_indices.clear();
+		m_id_indices.clear();
+	}
+
+
+	void project_store::assign(const std::vector<project_data>& projects) {
+
+		PROFILE_FUNCTION();
+
+		clear();
+		m_ids.reserve(projects.size());
+		m_display_names.reserve(projects.size());
+		m_last_modified.reserve(projects.size());
+		m_engine_versions.reserve(projects.size());
+		m_project_versions.reserve(projects.size());
+		m_statistics.reserve(projects.size());
+		m_cold.reserve(projects.size());
+		for (const auto& project : projects)
+			add(project);
+		m_compacted_bytes = m_strings.get_used_bytes();
+	}
+
+
+	u32 project_store::add(const project_data& project) {
+
+		const u32 index = size();
+		m_ids.emplace_back();
+		m_display_names.emplace_back();
+		m_last_modified.emplace_back();
+		m_engine_versions.emplace_back();
+		m_project_versions.emplace_back();
+		m_statistics.emplace_back();
+		m_tag_bits.resize(m_tag_bits.size() + m_tag_words, 0);
+		m_cold.emplace_back();
+		write(index, project);
+		return index;
+	}
+
+
+	void project_store::set(const u32 index, const project_data& project) {
+
+		VALIDATE(index < size(), return, "", "Project [" << index << "] does not exist");
+		m_indices.erase(m_cold[index].project_path);
+		m_id_indices.erase(m_ids[index]);
+		std::fill_n(m_tag_bits.begin() + static_cast<size_t>(index) * m_tag_words, m_tag_words, 0);
+		write(index, project);
+		compact_strings();
+	}
+
+
+	void project_store::erase(const u32 index) {
+
+		VALIDATE(index < size(), return, "", "Project [" << index << "] does not exist");
+		m_indices.erase(m_cold[index].project_path);
+		m_id_indices.erase(m_ids[index]);
+		m_ids.erase(m_ids.begin() + index);
+		m_display_names.erase(m_display_names.begin() + index);
+		m_last_modified.erase(m_last_modified.begin() + index);
+		m_engine_versions.erase(m_engine_versions.begin() + index);
+		m_project_versions.erase(m_project_versions.begin() + index);
+		m_statistics.erase(m_statistics.begin() + index);
+		m_tag_bits.erase(m_tag_bits.begin() + static_cast<size_t>(index) * m_tag_words, m_tag_bits.begin() + static_cast<size_t>(index + 1) * m_tag_words);
+		m_cold.erase(m_cold.begin() + index);
+
+		for (auto& [path, stored_index] : m_indices)
+			if (stored_index > index)
+				stored_index--;
+
+		for (auto& [id, stored_index] : m_id_indices)
+			if (stored_index > index)
+				stored_index--;
+
+		compact_strings();
+	}
+
+
+	std::optional<u32> project_store::find(const std::filesystem::path& project_path) const {
+
+		const std::optional<string_handle> path = m_strings.find(project_path.generic_string());
+		if (!path)
+			return std::nullopt;
+
+		const auto found = m_indices.find(*path);
+		if (found == m_indices.end())
+			return std::nullopt;
+		return found->second;
+	}
+
+
+	std::optional<u32> project_store::find(const UUID& id) const {
+
+		const auto found = m_id_indices.find(id);
+		if (found == m_id_indices.end())
+			return std::nullopt;
+		return found->second;
+	}
+
+
+	void project_store::set_last_modified(const u32 index, const system_time& time) {
+
+		VALIDATE(index < size(), return, "", "Project [" << index << "] does not exist");
+		m_last_modified[index] = time;
+		format_time(time, m_cold[index].last_modified_text);
+	}
+
+
+	void project_store::set_statistics(const u32 index, const project_statistics& statistics) {
+
+		VALIDATE(index < size(), return, "", "Project [" << index << "] does not exist");
+		m_statistics[index] = statistics;
+	}
+
+
+	project_data project_store::get_data(const u32 index) const {
+
+		const cold_fields& cold = m_cold[index];
+		project_data data{};
+		data.ID = m_ids[index];
+		data.name = get(cold.name);
+		data.display_name = get(m_display_names[index]);
+		data.description = get(cold.description);
+		data.project_path = get(cold.project_path);
+		data.last_modified = m_last_modified[index];
+		for (const string_handle tag : cold.tags)
+			data.tags.emplace_back(get(tag));
+		data.engine_version = m_engine_versions[index];
+		data.project_version = m_project_versions[index];
+		data.build_path = get(cold.build_path);
+		data.start_world = get(cold.start_world);
+		data.editor_start_world = get(cold.editor_start_world);
+		for (const string_handle plugin : cold.engine_plugins)
+			data.engine_plugins.emplace_back(get(plugin));
+		for (const string_handle library : cold.external_libraries)
+			data.external_libraries.emplace_back(get(library));
+		data.statistics = m_statistics[index];
+		return data;
+	}
+
+
+	// expects the tag bits of [index] to be cleared
+	void project_store::write(const u32 index, const project_data& project) {
+
+		m_ids[index] = project.ID;
+		m_display_names[index] = m_strings.intern(project.display_name);
+		m_last_modified[index] = project.last_modified;
+		m_engine_versions[index] = project.engine_version;
+		m_project_versions[index] = project.project_version;
+		m_statistics[index] = project.statistics;
+
+		cold_fields& cold = m_cold[index];
+		cold.name = m_strings.intern(project.name);
+		cold.description = m_strings.intern(project.description);
+		cold.project_path = m_strings.intern(project.project_path.generic_string());
+		cold.build_path = m_strings.intern(project.build_path.generic_string());
+		cold.start_world = m_strings.intern(project.start_world.generic_string());
+		cold.editor_start_world = m_strings.intern(project.editor_start_world.generic_string());
+		cold.engine_version_text = format_version(project.engine_version);
+		cold.project_version_text = format_version(project.project_version);
+		format_time(project.last_modified, cold.last_modified_text);
+
+		cold.engine_plugins.clear();
+		for (const auto& plugin : project.engine_plugins)
+			cold.engine_plugins.push_back(m_strings.intern(plugin));
+
+		cold.external_libraries.clear();
+		for (const auto& library : project.external_libraries)
+			cold.external_libraries.push_back(m_strings.intern(library));
+
+		cold.tags.clear();
+		for (const auto& tag : project.tags) {
+
+			const u32 tag_id = intern_tag(tag);						// can widen [m_tag_bits], index afterwards
+			cold.tags.push_back(m_tag_names[tag_id]);
+			m_tag_bits[static_cast<size_t>(index) * m_tag_words + tag_id / 64] |= u64(1) << (tag_id % 64);
+		}
+
+		m_indices[cold.project_path] = index;
+		m_id_indices[project.ID] = index;
+	}
+
+
+	u32 project_store::intern_tag(const std::string& tag) {
+
+		const string_handle name = m_strings.intern(tag);
+		const auto found = m_tag_ids.find(name);
+		if (found != m_tag_ids.end())
+			return found->second;
+
+		const u32 tag_id = static_cast<u32>(m_tag_names.size());
+		m_tag_names.push_back(name);
+		m_tag_ids.emplace(name, tag_id);
+
+		// one more word per project once every bit is used
+		if (m_tag_names.size() > static_cast<size_t>(m_tag_words) * 64) {
+
+			const u32 new_words = m_tag_words + 1;
+			std::vector<u64> widened(static_cast<size_t>(m_ids.size()) * new_words, 0);
+			for (size_t x = 0; x < m_ids.size(); x++)
+				std::copy_n(m_tag_bits.begin() + x * m_tag_words, m_tag_words, widened.begin() + x * new_words);
+
+			m_tag_bits = std::move(widened);
+			m_tag_words = new_words;
+		}
+		return tag_id;
+	}
+
+
+	// replaced and removed projects leave their strings behind, the pool is rebuilt from the live ones. Tags are interned
+	// first in the order of their ids, so the ids and the tag bits stay the same
+	void project_store::compact_strings() {
+
+		if (m_strings.get_used_bytes() <= 2 * std::max(m_compacted_bytes, MIN_COMPACT_BYTES))
+			return;
+
+		PROFILE_FUNCTION();
+
+		std::vector<project_data> projects{};
+		projects.reserve(size());
+		for (u32 x = 0; x < size(); x++)
+			projects.push_back(get_data(x));
+
+		std::vector<std::string> tags{};
+		tags.reserve(m_tag_names.size());
+		for (const string_handle tag : m_tag_names)
+			tags.emplace_back(get(tag));
+
+		const u64 used_bytes = m_strings.get_used_bytes();
+		m_strings.clear();
+		m_tag_ids.clear();
+		for (u32 tag_id = 0; tag_id < tags.size(); tag_id++) {
+
+			m_tag_names[tag_id] = m_strings.intern(tags[tag_id]);
+			m_tag_ids.emplace(m_tag_names[tag_id], tag_id);
+		}
+
+		m_indices.clear();
+		m_id_indices.clear();
+		std::fill(m_tag_bits.begin(), m_tag_bits.end(), 0);
+		for (u32 x = 0; x < size(); x++)
+			write(x, projects[x]);
+
+		m_compacted_bytes = m_strings.get_used_bytes();
+		LOG(Trace, "Rebuilt the project strings, [" << used_bytes << "] => [" << m_compacted_bytes << "] bytes");
+	}
+
+
+	void project_store::format_time(const system_time& time, char (&text)[20]) {
+
+		std::snprintf(text, sizeof(text), "%u-%u-%u %u:%u:%u", (u32)time.year, (u32)time.month, (u32)time.day,
+			(u32)time.hour, (u32)time.minute, (u32)time.secund);
+	}
+
+
+	project_store::string_handle project_store::format_version(const version& value) {
+
+		std::ostringstream oss;
+		oss << (u16)value.major << '-' << (u16)value.minor << '-' << (u16)value.patch;
+		return m_strings.intern(oss.str());
+	}
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "util/pch.h"
+#include "util/data_structures/string_pool.h"
+
+#include "project.h"
+
+namespace AT {
+
+	// The user projects as a struct of arrays.
+	// The fields the projects view reads for every project (ID, display name, timestamps, versions, tags, statistics) are kept in
+	// contiguous arrays, everything else of [project_data] is kept apart and only read by tooltips or when a project is opened.
+	// Strings are interned in one [util::string_pool] and referred to by handles. The pool never frees single strings, so
+	// set() and erase() rebuild it from the stored projects once it grew to twice its size after the last rebuild: handles
+	// and characters stay valid until the next set(), erase() or clear(), tag ids do not change.
+	// Display strings (versions, dates) are formatted once when a project is added, not every frame. The date changes with
+	// every watched edit and is kept in a fixed buffer per project instead of the pool.
+	// Projects are addressed by index, erase() moves the following projects one index down.
+	class project_store {
+	public:
+
+		using string_handle = util::string_pool::handle;
+
+		// fields that are not read for every project
+		struct cold_fields {
+			string_handle					name = util::string_pool::EMPTY;
+			string_handle					description = util::string_pool::EMPTY;
+			string_handle					project_path = util::string_pool::EMPTY;			// generic format
+			string_handle					build_path = util::string_pool::EMPTY;
+			string_handle					start_world = util::string_pool::EMPTY;
+			string_handle					editor_start_world = util::string_pool::EMPTY;
+			string_handle					engine_version_text = util::string_pool::EMPTY;
+			string_handle					project_version_text = util::string_pool::EMPTY;
+			char							last_modified_text[20]{};			// "year-month-day hour:minute:second"
+			std::vector<string_handle>		tags{};
+			std::vector<string_handle>		engine_plugins{};
+			std::vector<string_handle>		external_libraries{};
+		};
+
+		u32 size() const															{ return static_cast<u32>(m_ids.size()); }
+		bool empty() const															{ return m_ids.empty(); }
+
+		// Removes all projects and strings.
+		void clear();
+
+		// Replaces all projects with [projects].
+		void assign(const std::vector<project_data>& projects);
+
+		// Appends [project].
+		// @return The index of the project.
+		u32 add(const project_data& project);
+
+		// Replaces the project at [index], can rebuild the string pool.
+		void set(const u32 index, const project_data& project);
+
+		// Removes the project at [index], the following projects move one index down. Can rebuild the string pool.
+		void erase(const u32 index);
+
+		// @return The index of the project in [project_path], or std::nullopt if it is not stored.
+		std::optional<u32> find(const std::filesystem::path& project_path) const;
+
+		// @return The index of the project with [id], or std::nullopt if it is not stored. IDs are expected to be unique in a store.
+		std::optional<u32> find(const UUID& id) const;
+
+		// Sets [last_modified] of the project at [index] and formats its display string again.
+		void set_last_modified(const u32 index, const system_time& time);
+
+		void set_statistics(const u32 index, const project_statistics& statistics);
+
+		// ------------------------------- hot fields -------------------------------
+		const UUID& get_id(const u32 index) const									{ return m_ids[index]; }
+		const char* get_display_name(const u32 index) const							{ return m_strings.c_str(m_display_names[index]); }
+		const system_time& get_last_modified(const u32 index) const					{ return m_last_modified[index]; }
+		const version& get_engine_version(const u32 index) const					{ return m_engine_versions[index]; }
+		const version& get_project_version(const u32 index) const					{ return m_project_versions[index]; }
+		const project_statistics& get_statistics(const u32 index) const				{ return m_statistics[index]; }
+
+		// Tags of the project at [index], one bit per tag id (see get_tag()), get_tag_words() words.
+		std::span<const u64> get_tag_bits(const u32 index) const					{ return { m_tag_bits.data() + static_cast<size_t>(index) * m_tag_words, m_tag_words }; }
+		u32 get_tag_words() const													{ return m_tag_words; }
+
+		// Number of distinct tags, tag ids are below this number.
+		u32 get_tag_count() const													{ return static_cast<u32>(m_tag_names.size()); }
+		std::string_view get_tag(const u32 tag_id) const							{ return m_strings.get(m_tag_names[tag_id]); }
+
+		// ------------------------------- cold fields -------------------------------
+		const cold_fields& get_cold(const u32 index) const							{ return m_cold[index]; }
+		std::string_view get(const string_handle handle) const						{ return m_strings.get(handle); }
+		const char* c_str(const string_handle handle) const							{ return m_strings.c_str(handle); }
+		std::filesystem::path get_project_path(const u32 index) const				{ return std::filesystem::path(m_strings.get(m_cold[index].project_path)); }
+
+		// Copies the project at [index] into a [project_data], e.g. to edit or save it.
+		project_data get_data(const u32 index) const;
+
+		// Bytes used by the interned strings, including strings of replaced projects until the pool is rebuilt.
+		u64 get_strings_used_bytes() const											{ return m_strings.get_used_bytes(); }
+
+	private:
+
+		void write(const u32 index, const project_data& project);
+		u32 intern_tag(const std::string& tag);
+		void compact_strings();
+		static void format_time(const system_time& time, char (&text)[20]);
+		string_handle format_version(const version& value);
+
+		static constexpr u64 MIN_COMPACT_BYTES = 64 * 1024;				// smaller pools are not rebuilt
+
+		util::string_pool							m_strings{};
+		u64											m_compacted_bytes = 0;		// used bytes of [m_strings] after the last rebuild
+
+		// hot, one entry per project
+		std::vector<UUID>							m_ids{};
+		std::vector<string_handle>					m_display_names{};
+		std::vector<system_time>					m_last_modified{};
+		std::vector<version>						m_engine_versions{};
+		std::vector<version>						m_project_versions{};
+		std::vector<project_statistics>				m_statistics{};
+		std::vector<u64>							m_tag_bits{};				// [m_tag_words] per project
+		u32											m_tag_words = 1;
+
+		// cold, one entry per project
+		std::vector<cold_fields>					m_cold{};
+
+		std::vector<string_handle>					m_tag_names{};				// tag id => name
+		std::unordered_map<string_handle, u32>		m_tag_ids{};				// name => tag id
+		std::unordered_map<string_handle, u32>		m_indices{};				// [cold_fields::project_path] => index
+		std::unordered_map<UUID, u32>				m_id_indices{};				// [m_ids] => index
+	};
+
+}
@@ -20,7 +20,8 @@
 
 
 #define ASSET_EXTENTION			    ".atasset"      // Extension for asset files
-#define PROJECT_EXTENTION    		".atproj"       // Extension for project files
+#define PROJECT_EXTENTION    		".gltproj"      // Extension for project files
+#define PACKAGE_EXTENTION    		".gltpkg"       // Extension for project packages (see io::package_writer)
 #define CONFIG_FILE_EXTENSION   	".yml"        	// Extension for YAML config files
 #define INI_FILE_EXTENSION      	".ini"          // Extension for INI config files
 #define PROJECT_TEMP_DLL_PATH 		"build_DLL"     // Temporary directory for DLL builds
@@ -8,9 +8,9 @@ namespace AT {
 
 //#define USE_EXPERIMENTAL_COLLISION_AVOIDANCE
 
-	static std::random_device s_RandomDevice;
-	static std::mt19937_64 s_Engine(s_RandomDevice());
-	static std::uniform_int_distribution<u64> s_UniformDistribution;
+	// per thread, projects are parsed (and get their default ID) on the threads of a crawler
+	static thread_local std::mt19937_64 s_Engine(std::random_device{}());
+	static thread_local std::uniform_int_distribution<u64> s_UniformDistribution;
 
 #ifdef USE_EXPERIMENTAL_COLLISION_AVOIDANCE
 	static std::unordered_set<u64> s_generated_UUIDs;		// To track generated UUIDs and avoid duplicates
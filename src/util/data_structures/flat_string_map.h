@@ -0,0 +1,138 @@
+#pragma once
+
+#include "util/data_structures/string_manipulation.h"
+
+namespace AT::util {
+
+    // @brief Flat, open-addressing hash map (linear probing) from string keys to [value_type].
+    //          Keys are stored as [std::string_view], the caller owns the referenced characters (e.g. a file buffer)
+    //          and must keep them alive while the map is used. Hashes come from [hash_string] and can be passed in
+    //          precomputed (e.g. from [serializer::field]). All slots live in one contiguous vector; [clear()] keeps
+    //          the allocation, so a map can be refilled many times without touching the heap again.
+    // @tparam value_type The mapped type, should be cheap to copy (e.g. [std::string_view] or an index).
+    template<typename value_type>
+    class flat_string_map {
+    public:
+
+        // @brief Removes all entries but keeps the allocated slots.
+        void clear() {
+
+            for (auto& slot : m_slots)
+                slot.used = false;
+            m_size = 0;
+        }
+
+        // @brief Makes sure [count] entries fit without rehashing.
+        // @param [count] The number of entries that will be inserted.
+        void reserve(const size_t count) {
+
+            size_t capacity = MIN_CAPACITY;
+            while (capacity < count * 2)
+                capacity *= 2;
+
+            if (capacity > m_slots.size())
+                rehash(capacity);
+        }
+
+        // @brief Returns the number of stored entries.
+        size_t size() const                                                 { return m_size; }
+
+        // @brief Returns true if no entry is stored.
+        bool empty() const                                                  { return m_size == 0; }
+
+        // @brief Inserts [key] or overrides the value of an existing entry with the same key.
+        // @param [key] The key, must outlive the map (only the view is stored).
+        // @param [value] The value to store.
+        // @param [hash] The precomputed [hash_string] of [key].
+        // @return A reference to the stored value.
+        value_type& insert_or_assign(const std::string_view key, const value_type& value, const u64 hash) {
+
+            if ((m_size + 1) * 2 > m_slots.size())                          // keep load factor below 0.5
+                rehash(m_slots.empty() ? MIN_CAPACITY : m_slots.size() * 2);
+
+            const size_t mask = m_slots.size() - 1;
+            for (size_t index = hash & mask; ; index = (index + 1) & mask) {
+
+                slot& current = m_slots[index];
+                if (!current.used) {
+
+                    current = { hash, key, value, true };
+                    m_size++;
+                    return current.value;
+                }
+
+                if (current.hash == hash && current.key == key) {
+
+                    current.value = value;
+                    return current.value;
+                }
+            }
+        }
+
+        value_type& insert_or_assign(const std::string_view key, const value_type& value)   { return insert_or_assign(key, value, hash_string(key)); }
+
+        // @brief Looks up [key].
+        // @param [key] The key to search for.
+        // @param [hash] The precomputed [hash_string] of [key].
+        // @return A pointer to the stored value, or nullptr if [key] is not in the map.
+        const value_type* find(const std::string_view key, const u64 hash) const {
+
+            if (m_size == 0)
+                return nullptr;
+
+            const size_t mask = m_slots.size() - 1;
+            for (size_t index = hash & mask; m_slots[index].used; index = (index + 1) & mask) {
+
+                if (m_slots[index].hash == hash && m_slots[index].key == key)
+                    return &m_slots[index].value;
+            }
+            return nullptr;
+        }
+
+        value_type* find(const std::string_view key, const u64 hash)       { return const_cast<value_type*>(std::as_const(*this).find(key, hash)); }
+
+        const value_type* find(const std::string_view key) const            { return find(key, hash_string(key)); }
+
+        value_type* find(const std::string_view key)                        { return find(key, hash_string(key)); }
+
+        // @brief Calls [function] with (key, value) for every entry, in slot order (not insertion order).
+        template<typename function_type>
+        void for_each(function_type&& function) const {
+
+            for (const auto& slot : m_slots)
+                if (slot.used)
+                    function(slot.key, slot.value);
+        }
+
+    private:
+
+        static constexpr size_t MIN_CAPACITY = 16;
+
+        struct slot {
+            u64                 hash = 0;
+            std::string_view    key{};
+            value_type          value{};
+            bool                used = false;
+        };
+
+        void rehash(const size_t new_capacity) {
+
+            std::vector<slot> old_slots = std::exchange(m_slots, std::vector<slot>(new_capacity));
+            const size_t mask = new_capacity - 1;
+            for (auto& old_slot : old_slots) {
+
+                if (!old_slot.used)
+                    continue;
+
+                size_t index = old_slot.hash & mask;
+                while (m_slots[index].used)
+                    index = (index + 1) & mask;
+                m_slots[index] = std::move(old_slot);
+            }
+        }
+
+        std::vector<slot>       m_slots{};
+        size_t                  m_size = 0;
+    };
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "util/pch.h"
+
+#include <limits>
+
+namespace AT::util {
+
+    // @brief Most-recently-used list of at most [capacity] keys with O(1) updates.
+    //          A hash map finds the node of a key, the nodes form a doubly linked list (indices into one vector, no
+    //          allocation per node) ordered from the most to the least recently used key. touch() moves a key to the
+    //          front, adding it if needed, and evicts the least recently used key once the list is full.
+    // @tparam key_type The key, e.g. an [UUID], needs std::hash and operator==.
+    template<typename key_type, typename hash_type = std::hash<key_type>>
+    class lru_list {
+    public:
+
+        static constexpr u32 INVALID = std::numeric_limits<u32>::max();
+
+        // @brief Iterates from the most to the least recently used key.
+        class iterator {
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = key_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const key_type*;
+            using reference = const key_type&;
+
+            iterator() = default;
+            iterator(const lru_list* list, const u32 node) : m_list(list), m_node(node) {}
+
+            reference operator*() const                                     { return m_list->m_nodes[m_node].key; }
+            pointer operator->() const                                      { return &m_list->m_nodes[m_node].key; }
+            iterator& operator++()                                          { m_node = m_list->m_nodes[m_node].next; return *this; }
+            iterator operator++(int)                                        { iterator previous = *this; ++*this; return previous; }
+            bool operator==(const iterator& other) const                    { return m_node == other.m_node; }
+
+        private:
+
+            const lru_list*     m_list = nullptr;
+            u32                 m_node = INVALID;
+        };
+
+        // @param [capacity] The number of keys that are kept, at least 1.
+        explicit lru_list(const u32 capacity) : m_capacity(std::max(capacity, 1u)) { m_nodes.reserve(m_capacity); }
+
+        // @brief Moves [key] to the front, adds it if it is not in the list. The least recently used key is evicted if the list is full.
+        // @return true if [key] was added, false if it was already in the list.
+        bool touch(const key_type& key) {
+
+            if (const auto found = m_lookup.find(key); found != m_lookup.end()) {
+
+                unlink(found->second);
+                link_front(found->second);
+                return false;
+            }
+
+            u32 node = INVALID;
+            if (m_lookup.size() == m_capacity) {                            // reuse the node of the evicted key
+
+                node = m_tail;
+                unlink(node);
+                m_lookup.erase(m_nodes[node].key);
+                m_nodes[node].key = key;
+
+            } else if (m_free != INVALID) {
+
+                node = m_free;
+                m_free = m_nodes[node].next;
+                m_nodes[node].key = key;
+
+            } else {
+
+                node = static_cast<u32>(m_nodes.size());
+                m_nodes.push_back({ key });
+            }
+
+            m_lookup.emplace(key, node);
+            link_front(node);
+            return true;
+        }
+
+        // @brief Removes [key] from the list.
+        // @return false if [key] was not in the list.
+        bool erase(const key_type& key) {
+
+            const auto found = m_lookup.find(key);
+            if (found == m_lookup.end())
+                return false;
+
+            const u32 node = found->second;
+            unlink(node);
+            m_lookup.erase(found);
+            m_nodes[node].next = m_free;
+            m_free = node;
+            return true;
+        }
+
+        // @brief Removes all keys, the capacity is kept.
+        void clear() {
+
+            m_nodes.clear();
+            m_lookup.clear();
+            m_head = m_tail = m_free = INVALID;
+        }
+
+        bool contains(const key_type& key) const                            { return m_lookup.contains(key); }
+        u32 size() const                                                    { return static_cast<u32>(m_lookup.size()); }
+        bool empty() const                                                  { return m_lookup.empty(); }
+        u32 capacity() const                                                { return m_capacity; }
+
+        iterator begin() const                                              { return iterator(this, m_head); }
+        iterator end() const                                                { return iterator(this, INVALID); }
+
+        // @brief Returns the keys from the most to the least recently used one, e.g. to store the list.
+        std::vector<key_type> get_keys() const                              { return std::vector<key_type>(begin(), end()); }
+
+    private:
+
+        struct node {
+            key_type            key{};
+            u32                 previous = INVALID;
+            u32                 next = INVALID;
+        };
+
+        void unlink(const u32 index) {
+
+            node& current = m_nodes[index];
+            (current.previous != INVALID ? m_nodes[current.previous].next : m_head) = current.next;
+            (current.next != INVALID ? m_nodes[current.next].previous : m_tail) = current.previous;
+            current.previous = current.next = INVALID;
+        }
+
+        void link_front(const u32 index) {
+
+            node& current = m_nodes[index];
+            current.previous = INVALID;
+            current.next = m_head;
+            if (m_head != INVALID)
+                m_nodes[m_head].previous = index;
+            m_head = index;
+            if (m_tail == INVALID)
+                m_tail = index;
+        }
+
+        std::vector<node>                                   m_nodes{};
+        std::unordered_map<key_type, u32, hash_type>        m_lookup{};             // key => index in [m_nodes]
+        u32                                                 m_capacity = 0;
+        u32                                                 m_head = INVALID;       // most recently used
+        u32                                                 m_tail = INVALID;       // least recently used
+        u32                                                 m_free = INVALID;       // erased nodes, linked by [node::next]
+    };
+}
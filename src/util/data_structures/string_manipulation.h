@@ -37,6 +37,30 @@ namespace AT::util {
     // @return A string containing the name of the variable extracted from the input string.
     std::string extract_variable_name(const std::string& input);
 
+    // @brief Compile-time version of [extract_variable_name]. Used by [KEY_VALUE] so the stringified
+    //          expression is reduced to the plain variable name during compilation instead of on every call.
+    // @param [input] The stringified variable access chain (e.g., "m_data.title").
+    // @return A view of the variable name inside [input] ("title" in this example).
+    consteval std::string_view variable_name(std::string_view input) {
+
+        const size_t found = input.find_last_of("->.");
+        return (found == std::string_view::npos) ? input : input.substr(found + 1);
+    }
+
+    // @brief 64-bit FNV-1a hash of a string. Can be evaluated at compile time so key hashes
+    //          for serializer fields and config keys are computed once during compilation.
+    // @param [string] The string to hash.
+    // @return The 64-bit hash value.
+    constexpr u64 hash_string(std::string_view string) {
+
+        u64 hash = 14695981039346656037ull;
+        for (const char character : string) {
+            hash ^= static_cast<u8>(character);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
     //@brief Converts a string to a boolean value.
     //@param [string] The string to convert.
     //@return true if the string is "true", false otherwise.
@@ -0,0 +1,77 @@
+#include "util/pch.h"
+
+#include "string_pool.h"
+
+
+namespace AT::util {
+
+    string_pool::string_pool() { m_strings.emplace_back("", 0); }
+
+
+    string_pool::handle string_pool::intern(const std::string_view string) {
+
+        if (string.empty())
+            return EMPTY;
+
+        const u64 hash = hash_string(string);
+        if (const handle* found = m_lookup.find(string, hash))
+            return *found;
+
+        // null terminated, so c_str() needs no copy
+        char* characters = allocate(string.size() + 1);
+        std::memcpy(characters, string.data(), string.size());
+        characters[string.size()] = '\0';
+
+        const handle id = static_cast<handle>(m_strings.size());
+        m_strings.emplace_back(characters, string.size());
+        m_lookup.insert_or_assign(m_strings.back(), id, hash);
+        return id;
+    }
+
+
+    std::optional<string_pool::handle> string_pool::find(const std::string_view string) const {
+
+        if (string.empty())
+            return EMPTY;
+
+        if (const handle* found = m_lookup.find(string))
+            return *found;
+        return std::nullopt;
+    }
+
+
+    void string_pool::clear() {
+
+        m_blocks.clear();
+        m_block_offset = BLOCK_SIZE;
+        m_used_bytes = 0;
+        m_strings.resize(1);
+        m_lookup.clear();
+    }
+
+
+    char* string_pool::allocate(const size_t size) {
+
+        m_used_bytes += size;
+
+        // a string larger than a block gets its own block, the current block stays open for the next strings
+        if (size > BLOCK_SIZE / 4) {
+
+            auto block = std::make_unique<char[]>(size);
+            char* result = block.get();
+            m_blocks.insert(m_blocks.end() - (m_blocks.empty() ? 0 : 1), std::move(block));
+            return result;
+        }
+
+        if (m_block_offset + size > BLOCK_SIZE) {
+
+            m_blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            m_block_offset = 0;
+        }
+
+        char* result = m_blocks.back().get() + m_block_offset;
+        m_block_offset += size;
+        return result;
+    }
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "util/data_structures/flat_string_map.h"
+
+namespace AT::util {
+
+    // @brief Interns strings: every distinct string is stored once and referred to by a small [handle].
+    //          The characters live in fixed size blocks that never move, so views and C strings returned by the pool
+    //          stay valid until [clear()], and equal strings are compared by comparing their handles.
+    //          Strings are never freed one by one, a pool is cleared as a whole.
+    class string_pool {
+    public:
+
+        using handle = u32;
+
+        static constexpr handle EMPTY = 0;                                  // the empty string, always present
+
+        string_pool();
+
+        DELETE_COPY_MOVE_CONSTRUCTOR(string_pool);
+
+        // @brief Returns the handle of [string], copies it into the pool if it is not interned yet.
+        handle intern(const std::string_view string);
+
+        // @brief Returns the handle of [string] without adding it.
+        // @return The handle, or std::nullopt if [string] is not interned.
+        std::optional<handle> find(const std::string_view string) const;
+
+        // @brief Returns the characters of [id], stable until [clear()].
+        std::string_view get(const handle id) const                         { return m_strings[id]; }
+
+        // @brief Returns the characters of [id] as a null terminated string, stable until [clear()].
+        const char* c_str(const handle id) const                            { return m_strings[id].data(); }
+
+        // @brief Returns the number of distinct strings (including the empty string).
+        u32 size() const                                                    { return static_cast<u32>(m_strings.size()); }
+
+        // @brief Returns the number of bytes that are used by the characters.
+        u64 get_used_bytes() const                                          { return m_used_bytes; }
+
+        // @brief Removes all strings except the empty string and frees their memory.
+        void clear();
+
+    private:
+
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+        char* allocate(const size_t size);
+
+        std::vector<std::unique_ptr<char[]>>        m_blocks{};
+        size_t                                      m_block_offset = BLOCK_SIZE;        // used bytes of the last block
+        u64                                         m_used_bytes = 0;
+        std::vector<std::string_view>               m_strings{};
+        flat_string_map<handle>                     m_lookup{};                        // keys point into [m_blocks]
+    };
+
+}
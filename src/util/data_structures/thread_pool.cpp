@@ -0,0 +1,83 @@
+#include "util/pch.h"
+#include "thread_pool.h"
+
+
+namespace AT::util {
+
+
+    thread_pool::thread_pool(u32 thread_count) {
+
+        if (thread_count == 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+        m_workers.reserve(thread_count);
+        for (u32 x = 0; x < thread_count; x++)
+            m_workers.emplace_back(&thread_pool::worker_loop, this);
+    }
+
+
+    thread_pool::~thread_pool() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_task_available.notify_all();
+
+        for (auto& worker : m_workers)
+            worker.join();
+    }
+
+
+    void thread_pool::push_task(std::function<void()>&& task) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_task_available.notify_one();
+    }
+
+
+    void thread_pool::wait() {
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_all_done.wait(lock, [this]() { return m_tasks.empty() && m_active_tasks == 0; });
+    }
+
+
+    void thread_pool::worker_loop() {
+
+        while (true) {
+
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_task_available.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+                if (m_tasks.empty())                    // only reached when stopping, queued tasks are finished first
+                    return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+                m_active_tasks++;
+            }
+
+            try {
+                task();
+            } catch (const std::exception& exception) {
+                LOG(Error, "Task in thread pool threw an exception: " << exception.what());
+            } catch (...) {
+                LOG(Error, "Task in thread pool threw an unknown exception");
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_active_tasks--;
+                if (m_tasks.empty() && m_active_tasks == 0)
+                    m_all_done.notify_all();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "util/pch.h"
+
+
+namespace AT::util {
+
+    // @brief A small fixed-size pool of worker threads that execute queued tasks in FIFO order.
+    //        Tasks that throw are caught and logged so one failing task does not take down the pool.
+    //        The destructor finishes all queued tasks before joining the workers.
+    class thread_pool {
+    public:
+
+        // @brief Starts the worker threads.
+        // @param [thread_count] Number of workers, 0 uses std::thread::hardware_concurrency().
+        explicit thread_pool(u32 thread_count = 0);
+        ~thread_pool();
+
+        DELETE_COPY_MOVE_CONSTRUCTOR(thread_pool);
+
+        // @brief Adds a task to the queue, it is executed by the next idle worker.
+        // @param [task] The function to execute on a worker thread.
+        void push_task(std::function<void()>&& task);
+
+        // @brief Blocks until the queue is empty and no worker is executing a task.
+        void wait();
+
+        // @brief Returns the number of worker threads.
+        u32 get_thread_count() const                    { return static_cast<u32>(m_workers.size()); }
+
+    private:
+
+        void worker_loop();
+
+        std::vector<std::thread>                m_workers{};
+        std::deque<std::function<void()>>       m_tasks{};
+        std::mutex                              m_mutex{};
+        std::condition_variable                 m_task_available{};
+        std::condition_variable                 m_all_done{};
+        u32                                     m_active_tasks = 0;
+        bool                                    m_stop = false;
+    };
+}
@@ -0,0 +1,176 @@
+#include "util/pch.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#elif defined(PLATFORM_LINUX)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/stat.h>
+#else
+	#error undefined platform
+#endif
+
+#include "atomic_file_writer.h"
+
+
+namespace AT::io {
+
+	// unique name in the directory of the target, so concurrent writers never share a temporary file
+	static std::filesystem::path make_temporary_path(const std::filesystem::path& target) {
+
+		static std::atomic<u32> s_counter = 0;
+#if defined(PLATFORM_WINDOWS)
+		const u64 process_id = GetCurrentProcessId();
+#else
+		const u64 process_id = static_cast<u64>(getpid());
+#endif
+		std::filesystem::path temporary = target;
+		temporary += "." + std::to_string(process_id) + "." + std::to_string(s_counter++) + ".tmp";
+		return temporary;
+	}
+
+
+	atomic_file_writer::atomic_file_writer(const std::filesystem::path& target, const bool sync_directory)
+		: m_target(target), m_temporary(make_temporary_path(target)), m_sync_directory(sync_directory) {
+
+#if defined(PLATFORM_WINDOWS)
+
+		HANDLE handle = CreateFileW(m_temporary.wstring().c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+		VALIDATE(handle != INVALID_HANDLE_VALUE, m_failed = true; return, "", "Failed to create temporary file [" << m_temporary.generic_string() << "]");
+		m_handle = handle;
+
+#elif defined(PLATFORM_LINUX)
+
+		// keep the permissions of the file that is replaced
+		mode_t mode = 0644;
+		struct stat target_status{};
+		if (stat(m_target.c_str(), &target_status) == 0)
+			mode = target_status.st_mode & 07777;
+
+		m_file = ::open(m_temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+		VALIDATE(m_file >= 0, m_failed = true; return, "", "Failed to create temporary file [" << m_temporary.generic_string() << "]: " << std::strerror(errno));
+#endif
+	}
+
+
+	atomic_file_writer::~atomic_file_writer() { discard(); }
+
+
+	bool atomic_file_writer::is_open() const {
+
+#if defined(PLATFORM_WINDOWS)
+		return !m_failed && m_handle != nullptr;
+#elif defined(PLATFORM_LINUX)
+		return !m_failed && m_file >= 0;
+#endif
+	}
+
+
+	bool atomic_file_writer::write(const void* data, const size_t size) {
+
+		if (!is_open())
+			return false;
+
+		const u8* bytes = static_cast<const u8*>(data);
+		size_t written = 0;
+		while (written < size) {
+
+#if defined(PLATFORM_WINDOWS)
+			DWORD chunk = 0;
+			const DWORD request = static_cast<DWORD>(std::min<size_t>(size - written, 1u << 30));
+			if (!WriteFile(static_cast<HANDLE>(m_handle), bytes + written, request, &chunk, nullptr) || chunk == 0) {
+
+				LOG(Error, "Failed to write to temporary file [" << m_temporary.generic_string() << "]");
+				discard();
+				return false;
+			}
+#elif defined(PLATFORM_LINUX)
+			const ssize_t chunk = ::write(m_file, bytes + written, size - written);
+			if (chunk < 0 && errno == EINTR)
+				continue;
+
+			if (chunk <= 0) {
+
+				LOG(Error, "Failed to write to temporary file [" << m_temporary.generic_string() << "]: " << std::strerror(errno));
+				discard();
+				return false;
+			}
+#endif
+			written += static_cast<size_t>(chunk);
+		}
+		return true;
+	}
+
+
+	bool atomic_file_writer::commit() {
+
+		VALIDATE(is_open(), discard(); return false, "", "Not replacing [" << m_target.generic_string() << "], writing the temporary file failed");
+
+#if defined(PLATFORM_WINDOWS)
+
+		const bool flushed = FlushFileBuffers(static_cast<HANDLE>(m_handle));
+		CloseHandle(static_cast<HANDLE>(m_handle));
+		m_handle = nullptr;
+		VALIDATE(flushed, discard(); return false, "", "Failed to flush temporary file [" << m_temporary.generic_string() << "]");
+
+		// MOVEFILE_WRITE_THROUGH returns after the rename is on disk, there is no separate directory flush on Windows
+		VALIDATE(MoveFileExW(m_temporary.wstring().c_str(), m_target.wstring().c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH), discard(); return false,
+			"", "Failed to replace [" << m_target.generic_string() << "]");
+
+#elif defined(PLATFORM_LINUX)
+
+		const bool synced = ::fsync(m_file) == 0;
+		const bool closed = ::close(m_file) == 0;
+		m_file = -1;
+		VALIDATE(synced && closed, discard(); return false, "", "Failed to flush temporary file [" << m_temporary.generic_string() << "]: " << std::strerror(errno));
+
+		VALIDATE(::rename(m_temporary.c_str(), m_target.c_str()) == 0, discard(); return false,
+			"", "Failed to replace [" << m_target.generic_string() << "]: " << std::strerror(errno));
+
+		if (m_sync_directory) {
+
+			std::filesystem::path directory = m_target.parent_path();
+			if (directory.empty())
+				directory = ".";
+
+			const int directory_file = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (directory_file >= 0) {
+
+				if (::fsync(directory_file) != 0)
+					LOG(Warn, "Failed to flush directory [" << directory.generic_string() << "]: " << std::strerror(errno));
+				::close(directory_file);
+			}
+		}
+#endif
+
+		m_temporary.clear();							// renamed, nothing left to discard
+		return true;
+	}
+
+
+	void atomic_file_writer::discard() {
+
+		m_failed = true;
+#if defined(PLATFORM_WINDOWS)
+		if (m_handle) {
+
+			CloseHandle(static_cast<HANDLE>(m_handle));
+			m_handle = nullptr;
+		}
+#elif defined(PLATFORM_LINUX)
+		if (m_file >= 0) {
+
+			::close(m_file);
+			m_file = -1;
+		}
+#endif
+
+		if (!m_temporary.empty()) {
+
+			std::error_code error_code;
+			std::filesystem::remove(m_temporary, error_code);
+			m_temporary.clear();
+		}
+	}
+
+}
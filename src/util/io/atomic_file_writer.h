@@ -0,0 +1,53 @@
+#pragma once
+
+
+namespace AT::io {
+
+	// Replaces a file without ever leaving a partially written version of it behind.
+	// The content is written to a temporary file in the same directory, flushed to disk and renamed over the
+	// target, so after a crash the target has either its old or its new content. Nothing is changed if
+	// commit() is not called (the temporary file is removed on destruction).
+	//
+	//   io::atomic_file_writer writer(path);
+	//   writer.write(content);
+	//   if (!writer.commit()) { ... }
+	class atomic_file_writer {
+	public:
+
+		// Creates the temporary file next to [target]. Failure is logged, check is_open() or the result of commit().
+		// @param target The file that is replaced by commit().
+		// @param sync_directory Also flush the directory after the rename, so the rename itself survives a power loss.
+		atomic_file_writer(const std::filesystem::path& target, const bool sync_directory = true);
+		~atomic_file_writer();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(atomic_file_writer);
+
+		// Returns true while the temporary file is open and every write succeeded.
+		bool is_open() const;
+
+		// Appends [size] bytes to the temporary file.
+		// @return false if the write failed, the writer then discards everything and commit() fails.
+		bool write(const void* data, const size_t size);
+		bool write(std::string_view content)						{ return write(content.data(), content.size()); }
+		bool write(std::span<const u8> content)						{ return write(content.data(), content.size()); }
+
+		// Flushes the temporary file to disk and renames it over the target.
+		// @return true if the target now has the written content, false if it was left untouched.
+		bool commit();
+
+	private:
+
+		void discard();
+
+		std::filesystem::path		m_target{};
+		std::filesystem::path		m_temporary{};
+		bool						m_sync_directory = true;
+		bool						m_failed = false;
+#if defined(PLATFORM_WINDOWS)
+		void*						m_handle = nullptr;
+#elif defined(PLATFORM_LINUX)
+		int							m_file = -1;
+#endif
+	};
+
+}
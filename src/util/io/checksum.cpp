@@ -0,0 +1,119 @@
+
+#include "util/pch.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#include <nmmintrin.h>
+	#define AT_CRC32C_SSE42
+	#define AT_TARGET_SSE42
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <cpuid.h>
+	#include <nmmintrin.h>
+	#define AT_CRC32C_SSE42
+	#define AT_TARGET_SSE42				__attribute__((target("sse4.2")))
+#endif
+
+#include "checksum.h"
+
+
+namespace AT::io {
+
+	static constexpr u32 CRC32C_POLYNOMIAL = 0x82F63B78;			// reversed Castagnoli polynomial
+
+	// slicing-by-8 tables, table[0] is the classic byte-wise table
+	static constexpr std::array<std::array<u32, 256>, 8> generate_tables() {
+
+		std::array<std::array<u32, 256>, 8> tables{};
+		for (u32 x = 0; x < 256; x++) {
+
+			u32 crc = x;
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+			tables[0][x] = crc;
+		}
+
+		for (u32 x = 0; x < 256; x++)
+			for (size_t slice = 1; slice < 8; slice++)
+				tables[slice][x] = (tables[slice - 1][x] >> 8) ^ tables[0][tables[slice - 1][x] & 0xFF];
+
+		return tables;
+	}
+
+	static constexpr auto s_tables = generate_tables();
+
+
+	static u32 crc32c_table(const u8* data, size_t size, u32 crc) {
+
+		for (; size >= 8; size -= 8, data += 8) {
+
+			// assembled byte by byte so the result does not depend on the byte order of the host
+			u32 low = static_cast<u32>(data[0]) | (static_cast<u32>(data[1]) << 8) | (static_cast<u32>(data[2]) << 16) | (static_cast<u32>(data[3]) << 24);
+			const u32 high = static_cast<u32>(data[4]) | (static_cast<u32>(data[5]) << 8) | (static_cast<u32>(data[6]) << 16) | (static_cast<u32>(data[7]) << 24);
+
+			low ^= crc;
+			crc = s_tables[7][low & 0xFF] ^ s_tables[6][(low >> 8) & 0xFF] ^ s_tables[5][(low >> 16) & 0xFF] ^ s_tables[4][low >> 24]
+				^ s_tables[3][high & 0xFF] ^ s_tables[2][(high >> 8) & 0xFF] ^ s_tables[1][(high >> 16) & 0xFF] ^ s_tables[0][high >> 24];
+		}
+
+		for (; size > 0; size--, data++)
+			crc = (crc >> 8) ^ s_tables[0][(crc ^ *data) & 0xFF];
+
+		return crc;
+	}
+
+
+#ifdef AT_CRC32C_SSE42
+
+	AT_TARGET_SSE42 static u32 crc32c_sse42(const u8* data, size_t size, u32 crc) {
+
+	#if defined(__x86_64__) || defined(_M_X64)
+		u64 crc64 = crc;
+		for (; size >= 8; size -= 8, data += 8) {
+
+			u64 value;
+			std::memcpy(&value, data, sizeof(value));
+			crc64 = _mm_crc32_u64(crc64, value);
+		}
+		crc = static_cast<u32>(crc64);
+	#endif
+
+		for (; size >= 4; size -= 4, data += 4) {
+
+			u32 value;
+			std::memcpy(&value, data, sizeof(value));
+			crc = _mm_crc32_u32(crc, value);
+		}
+
+		for (; size > 0; size--, data++)
+			crc = _mm_crc32_u8(crc, *data);
+
+		return crc;
+	}
+
+	static bool cpu_supports_sse42() {
+
+	#if defined(_MSC_VER)
+		int registers[4]{};
+		__cpuid(registers, 1);
+		return (registers[2] & (1 << 20)) != 0;
+	#else
+		unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+		return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+	#endif
+	}
+
+#endif
+
+
+	u32 crc32c(std::span<const u8> data, const u32 previous) {
+
+		const u32 crc = ~previous;
+#ifdef AT_CRC32C_SSE42
+		static const bool s_has_sse42 = cpu_supports_sse42();
+		if (s_has_sse42)
+			return ~crc32c_sse42(data.data(), data.size(), crc);
+#endif
+		return ~crc32c_table(data.data(), data.size(), crc);
+	}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+
+namespace AT::io {
+
+	// Computes the CRC32C (Castagnoli) checksum of [data]. Uses the SSE4.2 crc32 instruction when the CPU supports it
+	// and a table based implementation otherwise, both produce the same values.
+	// Checksums can be computed in parts: crc32c(second, crc32c(first)) equals the checksum of both parts in a row.
+	// @param data The bytes to checksum.
+	// @param previous The checksum of the preceding data, 0 for the first part.
+	// @return The CRC32C checksum.
+	u32 crc32c(std::span<const u8> data, const u32 previous = 0);
+
+}
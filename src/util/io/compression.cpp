@@ -0,0 +1,186 @@
+
+#include "util/pch.h"
+
+#include "compression.h"
+
+
+namespace AT::io {
+
+	// format constants of the LZ4 block format
+	static constexpr size_t MIN_MATCH = 4;
+	static constexpr size_t LAST_LITERALS = 5;						// the last bytes of a block are always literals
+	static constexpr size_t MATCH_FIND_LIMIT = 12;					// the last match has to start this many bytes before the end
+	static constexpr size_t MAX_DISTANCE = 65535;
+	static constexpr u32 HASH_BITS = 12;
+
+	static inline u32 read_u32(const u8* data) {
+
+		u32 value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static inline u32 hash_sequence(const u32 sequence)				{ return (sequence * 2654435761u) >> (32 - HASH_BITS); }
+
+	// writes the 15+ continuation bytes of a literal or match length
+	static inline u8* write_length(u8* output, size_t length) {
+
+		for (; length >= 255; length -= 255)
+			*output++ = 255;
+
+		*output++ = static_cast<u8>(length);
+		return output;
+	}
+
+
+	size_t lz4_compress(std::span<const u8> source, std::vector<u8>& destination) {
+
+		const size_t start = destination.size();
+		destination.resize(start + lz4_compress_bound(source.size()));
+
+		const u8* const begin = source.data();
+		const u8* const end = begin + source.size();
+		const u8* input = begin;
+		const u8* anchor = begin;
+		u8* output = destination.data() + start;
+
+		auto write_sequence = [&](const u8* match_start, const size_t match_length, const size_t distance) {
+
+			const size_t literal_length = static_cast<size_t>(match_start - anchor);
+			u8* token = output++;
+			*token = static_cast<u8>(std::min<size_t>(literal_length, 15) << 4);
+			if (literal_length >= 15)
+				output = write_length(output, literal_length - 15);
+
+			if (literal_length > 0)
+				std::memcpy(output, anchor, literal_length);
+			output += literal_length;
+
+			if (match_length == 0)											// last literals, no match
+				return;
+
+			*output++ = static_cast<u8>(distance & 0xFF);
+			*output++ = static_cast<u8>(distance >> 8);
+			*token |= static_cast<u8>(std::min<size_t>(match_length - MIN_MATCH, 15));
+			if (match_length - MIN_MATCH >= 15)
+				output = write_length(output, match_length - MIN_MATCH - 15);
+		};
+
+		if (source.size() > MATCH_FIND_LIMIT) {
+
+			// positions + 1 of the last occurrence of each hashed 4-byte sequence, 0 is empty
+			std::array<u32, 1 << HASH_BITS> table{};
+			const u8* const match_limit = end - MATCH_FIND_LIMIT;
+			const u8* const extend_limit = end - LAST_LITERALS;
+
+			while (input < match_limit) {
+
+				const u32 sequence = read_u32(input);
+				const u32 hash = hash_sequence(sequence);
+				const u32 candidate = table[hash];
+				table[hash] = static_cast<u32>(input - begin) + 1;
+
+				const u8* match = candidate != 0 ? begin + candidate - 1 : nullptr;
+				if (!match || static_cast<size_t>(input - match) > MAX_DISTANCE || read_u32(match) != sequence) {
+
+					// skip faster through data that does not compress
+					input += 1 + (static_cast<size_t>(input - anchor) >> 6);
+					continue;
+				}
+
+				while (input > anchor && match > begin && input[-1] == match[-1]) {
+
+					input--;
+					match--;
+				}
+
+				size_t match_length = MIN_MATCH;
+				while (input + match_length < extend_limit && input[match_length] == match[match_length])
+					match_length++;
+
+				write_sequence(input, match_length, static_cast<size_t>(input - match));
+				input += match_length;
+				anchor = input;
+
+				if (input - 2 > begin && input < match_limit)
+					table[hash_sequence(read_u32(input - 2))] = static_cast<u32>(input - 2 - begin) + 1;
+			}
+		}
+
+		write_sequence(end, 0, 0);
+
+		const size_t written = static_cast<size_t>(output - (destination.data() + start));
+		destination.resize(start + written);
+		return written;
+	}
+
+
+	bool lz4_decompress(std::span<const u8> source, std::span<u8> destination) {
+
+		const u8* input = source.data();
+		const u8* const input_end = input + source.size();
+		u8* output = destination.data();
+		u8* const output_end = output + destination.size();
+
+		auto read_length = [&](size_t& length) {
+
+			u8 byte = 0;
+			do {
+				if (input >= input_end)
+					return false;
+
+				byte = *input++;
+				length += byte;
+			} while (byte == 255);
+			return true;
+		};
+
+		while (input < input_end) {
+
+			const u8 token = *input++;
+
+			size_t literal_length = token >> 4;
+			if (literal_length == 15 && !read_length(literal_length))
+				return false;
+
+			if (literal_length > static_cast<size_t>(input_end - input) || literal_length > static_cast<size_t>(output_end - output))
+				return false;
+
+			if (literal_length > 0)
+				std::memcpy(output, input, literal_length);
+			input += literal_length;
+			output += literal_length;
+
+			if (input == input_end)											// the last sequence only has literals
+				break;
+
+			if (input_end - input < 2)
+				return false;
+
+			const size_t distance = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8);
+			input += 2;
+			if (distance == 0 || distance > static_cast<size_t>(output - destination.data()))
+				return false;
+
+			size_t match_length = token & 15;
+			if (match_length == 15 && !read_length(match_length))
+				return false;
+
+			match_length += MIN_MATCH;
+			if (match_length > static_cast<size_t>(output_end - output))
+				return false;
+
+			const u8* match = output - distance;
+			if (distance >= match_length)
+				std::memcpy(output, match, match_length);
+			else {
+				for (size_t x = 0; x < match_length; x++)					// overlapping copy repeats the last [distance] bytes
+					output[x] = match[x];
+			}
+			output += match_length;
+		}
+
+		return output == output_end;
+	}
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+
+namespace AT::io {
+
+	// Upper bound of the compressed size of [source_size] bytes, used to reserve the destination of lz4_compress().
+	// @param source_size Number of bytes to compress.
+	// @return The largest possible size of the compressed data.
+	constexpr size_t lz4_compress_bound(const size_t source_size)		{ return source_size + source_size / 255 + 16; }
+
+	// Compresses [source] as a single block in the LZ4 block format (no frame header, no checksum).
+	// The block can be decompressed on its own, the uncompressed size has to be stored by the caller.
+	// @param source The bytes to compress.
+	// @param destination The compressed block is appended to this vector.
+	// @return The number of bytes appended to [destination].
+	size_t lz4_compress(std::span<const u8> source, std::vector<u8>& destination);
+
+	// Decompresses a single LZ4 block. Never reads or writes outside of the given spans.
+	// @param source The compressed block.
+	// @param destination Receives the data, must have exactly the uncompressed size of the block.
+	// @return true if the block was valid and filled [destination] completely, false if it is corrupted.
+	bool lz4_decompress(std::span<const u8> source, std::span<u8> destination);
+
+}
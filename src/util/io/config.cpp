@@ -8,155 +8,593 @@
 // #include <string>
 
 #include "util/io/io.h"
+#include "util/io/atomic_file_writer.h"
+#include "util/io/file_watcher.h"
+#include "util/system.h"
 
 #include "config.h"
 
 
-#define REMOVE_WHITE_SPACE(line)                line.erase(std::remove_if(line.begin(), line.end(),                                         \
-                                                [](char c) { return c == '\r' || c == '\n' || c == '\t'; }),                                \
-                                                line.end());
+namespace AT::config {
 
-#define BUILD_CONFIG_PATH(x)	CONFIG_DIR + config::file_type_to_string(x) + CONFIG_FILE_EXTENSION
+    // ----------------------------------------------- in-memory store ----------------------------------------------- 
 
+    namespace {
 
-namespace AT::config {
+        struct string_hash {
 
-    //
-    void init(std::filesystem::path dir) {
+            using is_transparent = void;
+            size_t operator()(std::string_view value) const             { return std::hash<std::string_view>{}(value); }
+        };
 
-        PROFILE_FUNCTION();
+        // a line of a section, [key] is empty for lines that are kept as they are (comments, empty lines)
+        struct ini_line {
+            std::string                 key{};
+            std::string                 value{};
+        };
 
-        io::create_directory(dir / CONFIG_DIR);
-        LOG(Trace, "Checking Engine config files at: " << dir / CONFIG_DIR);
-        for (int i = 0; i <= static_cast<int>(file::input); ++i) {
+        struct ini_section {
+            std::string                 name{};
+            std::vector<ini_line>       lines{};
+        };
 
-            std::filesystem::path file_path = dir / CONFIG_DIR / (config::file_type_to_string(static_cast<file>(i)) + CONFIG_FILE_EXTENSION);
-            std::ofstream config_file(file_path, std::ios::app);
-            if (!config_file.is_open()) {
+        struct ini_file {
+            std::vector<ini_section>                                                        sections{};     // [0] holds the lines before the first section header
+            std::unordered_map<std::string, std::pair<u32, u32>, string_hash, std::equal_to<>>  values{};   // "section\nkey" => section and line index
+            std::unordered_map<std::string, u32, string_hash, std::equal_to<>>              section_indices{};
+            std::string                                                                     last_written{};     // to ignore change notifications of own writes
+            bool                                                                            loaded = false;
+            bool                                                                            dirty = false;
+        };
 
-                LOG(Error, "Failed to open/create config file: [" << file_path << "]");
-                return;
+        using internal::FILE_COUNT;
+
+        std::mutex                              s_mutex{};              // guards everything below
+        std::mutex                              s_write_mutex{};        // serializes writers so an older snapshot never overrides a newer one
+        std::condition_variable                 s_changed{};
+        std::array<ini_file, FILE_COUNT>        s_files{};
+        std::filesystem::path                   s_root{};
+        std::thread                             s_flush_thread{};
+        std::chrono::steady_clock::time_point   s_last_change{};
+        bool                                    s_stop = false;
+
+        std::mutex                              s_watcher_mutex{};
+        std::unique_ptr<io::file_watcher>       s_watcher{};
+
+
+        std::string_view trim(std::string_view value) {
+
+            const auto first = value.find_first_not_of(" \t\r\n");
+            if (first == std::string_view::npos)
+                return {};
+
+            const auto last = value.find_last_not_of(" \t\r\n");
+            return value.substr(first, last - first + 1);
+        }
+
+        // only INI files are kept in the store, the YAML files belong to [serializer::yaml] and the ImGui file to ImGui
+        bool is_store_file(const file type) { return type == file::launcher; }
+
+        std::filesystem::path file_path(const file type) {
+
+            const std::filesystem::path& root = s_root.empty() ? util::get_executable_path() : s_root;
+            return (type == file::launcher) ? get_filepath_from_configtype_ini(root, type) : get_filepath_from_configtype(root, type);
+        }
+
+        // ----------------------------------------------- typed keys ----------------------------------------------- 
+
+        struct slot_info {
+            file                        target;
+            std::string_view            section;
+            std::string_view            key;
+            u64                         hash;
+            u64                         default_bits;
+            bool                        (*parse)(std::string_view value, u64& bits);
+        };
+
+        template<typename T>
+        bool parse_slot(std::string_view value, u64& bits) {
+
+            if constexpr (std::is_same_v<T, bool>) {
+
+                if (value == "true" || value == "1")            bits = 1;
+                else if (value == "false" || value == "0")      bits = 0;
+                else                                            return false;
+                return true;
+
+            } else {
+
+                T parsed{};
+                const auto result = std::from_chars(value.data(), value.data() + value.size(), parsed);
+                if (result.ec != std::errc() || result.ptr != value.data() + value.size())
+                    return false;
+
+                bits = internal::to_bits(parsed);
+                return true;
             }
-            config_file.close();
         }
-    }
 
-    //
-    void create_config_files_for_project(std::filesystem::path project_dir) {
+        constexpr std::array<slot_info, static_cast<size_t>(slot::count)> s_slot_infos = {{
+        #define CONFIG_KEY_INFO(group, name, type, target, section, key, default_value)  { target, section, key, hash_key(section, key), internal::to_bits<type>(default_value), &parse_slot<type> },
+            CONFIG_KEY_LIST(CONFIG_KEY_INFO)
+        #undef CONFIG_KEY_INFO
+        }};
 
-        io::create_directory(project_dir / CONFIG_DIR);
-        LOG(Trace, "Checking project config files at: " << project_dir / CONFIG_DIR);
-        for (int i = 0; i <= static_cast<int>(file::input); ++i) {
+        consteval bool slot_keys_are_unique() {
 
-            std::filesystem::path file_path = project_dir / CONFIG_DIR / (config::file_type_to_string(static_cast<file>(i)) + CONFIG_FILE_EXTENSION);
-            std::ofstream config_file(file_path, std::ios::app);
-            if (!config_file.is_open()) {
+            for (size_t x = 0; x < s_slot_infos.size(); x++)
+                for (size_t y = x + 1; y < s_slot_infos.size(); y++)
+                    if (s_slot_infos[x].target == s_slot_infos[y].target && s_slot_infos[x].hash == s_slot_infos[y].hash)
+                        return false;
+            return true;
+        }
+        static_assert(slot_keys_are_unique(), "CONFIG_KEY_LIST contains a key twice (or two keys with the same hash)");
 
-                LOG(Error, "Failed to open/create config file: [" << file_path << "]");
-                return;
+        consteval bool slot_targets_are_ini_files() {
+
+            for (const auto& info : s_slot_infos)
+                if (info.target != file::launcher)
+                    return false;
+            return true;
+        }
+        static_assert(slot_targets_are_ini_files(), "CONFIG_KEY_LIST keys have to be stored in an INI file of the store (file::launcher)");
+
+        void store_slot(const slot_info& info, const size_t index, std::string_view value) {
+
+            u64 bits = info.default_bits;
+            if (!value.empty() && !info.parse(value, bits)) {
+
+                LOG(Warn, "Invalid value [" << value << "] for config key [" << info.section << "] " << info.key << ", using the default");
+                bits = info.default_bits;
             }
-            config_file.close();
+            internal::slots[index].store(bits, std::memory_order_relaxed);
         }
-    }
 
-    // 
-    bool check_for_configuration(const file target_config_file, const std::string& section, const std::string& key, std::string& value, const bool override) {
+        // expects [s_mutex] to be locked, called after [type] was parsed (or reset)
+        void fill_slots(const file type, const ini_file& data);
 
-        PROFILE_FUNCTION();
+        // expects [s_mutex] to be locked, finds the typed key of a value by its hash
+        void update_slot(const file type, std::string_view section, std::string_view key, std::string_view value) {
+
+            const u64 hash = hash_key(section, key);
+            for (size_t x = 0; x < s_slot_infos.size(); x++) {
 
-        std::filesystem::path file_path = BUILD_CONFIG_PATH(target_config_file);
-        std::ifstream configFile(file_path, std::ios::in | std::ios::binary);
-        VALIDATE(configFile.is_open(), return false, "", "Failed to open file: [" << file_path << "]");
+                const slot_info& info = s_slot_infos[x];
+                if (info.hash == hash && info.target == type && info.section == section && info.key == key) {
 
-        bool found_key = false;
-        bool section_found = false;
-        std::string line;
-        std::ostringstream updatedConfig;
-        while (std::getline(configFile, line)) {
+                    store_slot(info, x, value);
+                    return;
+                }
+            }
+        }
 
-            REMOVE_WHITE_SPACE(line);
+        // lookup key of a value, reuses a thread local buffer so lookups do not allocate
+        std::string_view make_lookup_key(std::string_view section, std::string_view key) {
 
-            // Check if the line contains the desired section
-            if (line.find("[" + section + "]") != std::string::npos) {
+            thread_local std::string buffer{};
+            buffer.assign(section);
+            buffer += '\n';
+            buffer += key;
+            return buffer;
+        }
 
-                section_found = true;
-                updatedConfig << line << '\n';
+        u32 add_section(ini_file& data, std::string_view name) {
 
-                // Read and update the lines inside the section until a line with '[' is encountered
-                while (std::getline(configFile, line) && (line.find('[') == std::string::npos)) {
+            const u32 index = static_cast<u32>(data.sections.size());
+            data.sections.push_back({ std::string(name), {} });
+            data.section_indices.emplace(std::string(name), index);
+            return index;
+        }
+
+        void add_value(ini_file& data, const u32 section_index, std::string_view key, std::string_view value) {
 
-                    REMOVE_WHITE_SPACE(line);
+            auto& lines = data.sections[section_index].lines;
+            data.values.insert_or_assign(std::string(make_lookup_key(data.sections[section_index].name, key)), std::pair<u32, u32>{ section_index, static_cast<u32>(lines.size()) });
+            lines.push_back({ std::string(key), std::string(value) });
+        }
 
-                    std::size_t found = line.find('=');
-                    if (found != std::string::npos) {
+        // parses [content] into an empty [data], does not need [s_mutex]
+        void parse_content(ini_file& data, std::string_view content) {
 
-                        std::string currentKey = line.substr(0, found);
-                        if (currentKey == key) {
+            add_section(data, "");
+            u32 section_index = 0;
+            while (!content.empty()) {
 
-                            found_key = true;
-                            if (override) {
+                const size_t end = content.find('\n');
+                std::string_view line = content.substr(0, end);
+                content = (end == std::string_view::npos) ? std::string_view() : content.substr(end + 1);
+                if (!line.empty() && line.back() == '\r')
+                    line.remove_suffix(1);
 
-                                // Update the value for the specified key
-                                line.clear();
-                                line = key + "=" + value;
-                            } else {
+                const std::string_view trimmed = trim(line);
+                if (trimmed.size() >= 2 && trimmed.front() == '[' && trimmed.back() == ']') {
 
-                                value.clear();
-                                value = line.substr(found +1);
-                            }
-                        }
-                    }
-                    updatedConfig << line << '\n';
+                    const std::string_view name = trimmed.substr(1, trimmed.size() - 2);
+                    const auto existing = data.section_indices.find(name);
+                    section_index = (existing != data.section_indices.end()) ? existing->second : add_section(data, name);
+                    continue;
                 }
 
-                if (!found_key) {
+                const size_t separator = trimmed.find('=');
+                if (separator == std::string_view::npos || trimmed.front() == ';' || trimmed.front() == '#') {
 
-                    updatedConfig << key + "=" + value << '\n';
-                    found_key = true;
+                    data.sections[section_index].lines.push_back({ "", std::string(line) });
+                    continue;
                 }
 
-                if (!line.empty()) {
+                add_value(data, section_index, trim(trimmed.substr(0, separator)), trim(trimmed.substr(separator + 1)));
+            }
+        }
+
+        // expects [s_mutex] to be locked and [type] to be a store file (see is_store_file())
+        ini_file& get_file(const file type) {
+
+            ini_file& data = s_files[static_cast<size_t>(type)];
+            if (data.loaded)
+                return data;
+
+            data = {};
+            data.loaded = true;
+            std::error_code error_code;
+            const std::filesystem::path path = file_path(type);
+            if (std::filesystem::exists(path, error_code))             // a missing file is created on the first flush
+                parse_content(data, io::read_file(path));
+            else
+                add_section(data, "");
+            fill_slots(type, data);
+            return data;
+        }
+
+        // expects [s_mutex] to be locked
+        bool get_value(ini_file& data, std::string_view section, std::string_view key, std::string& value) {
+
+            const auto found = data.values.find(make_lookup_key(section, key));
+            if (found == data.values.end())
+                return false;
+
+            value = data.sections[found->second.first].lines[found->second.second].value;
+            return true;
+        }
+
+        void fill_slots(const file type, const ini_file& data) {
+
+            for (size_t x = 0; x < s_slot_infos.size(); x++) {
+
+                const slot_info& info = s_slot_infos[x];
+                if (info.target != type)
+                    continue;
+
+                const auto found = data.values.find(make_lookup_key(info.section, info.key));
+                store_slot(info, x, (found != data.values.end()) ? std::string_view(data.sections[found->second.first].lines[found->second.second].value) : std::string_view());
+            }
+            internal::slots_loaded[static_cast<size_t>(type)].store(true, std::memory_order_release);
+        }
+
+        // expects [s_mutex] to be locked
+        void set_value(const file type, ini_file& data, std::string_view section, std::string_view key, std::string_view value) {
+
+            const auto found = data.values.find(make_lookup_key(section, key));
+            if (found != data.values.end()) {
+
+                std::string& current = data.sections[found->second.first].lines[found->second.second].value;
+                if (current == value)
+                    return;
+
+                current = value;
+
+            } else {
 
-                    REMOVE_WHITE_SPACE(line);
-                    updatedConfig << line << '\n';
+                const auto existing = data.section_indices.find(section);
+                add_value(data, (existing != data.section_indices.end()) ? existing->second : add_section(data, section), key, value);
+            }
+            data.dirty = true;
+            update_slot(type, section, key, value);
+        }
+
+        std::string to_string(const ini_file& data) {
+
+            std::string content;
+            for (const auto& section : data.sections) {
+
+                if (!section.name.empty())
+                    content += "[" + section.name + "]\n";
+
+                for (const auto& line : section.lines)
+                    content += line.key.empty() ? line.value + "\n" : line.key + "=" + line.value + "\n";
+            }
+            return content;
+        }
+
+        void write_dirty_files() {
+
+            std::lock_guard write_lock(s_write_mutex);
+
+            struct pending_write {
+                file                    type;
+                std::filesystem::path   path;
+                std::string             content;
+            };
+            std::vector<pending_write> pending{};
+            {
+                std::lock_guard lock(s_mutex);
+                for (size_t x = 0; x < s_files.size(); x++) {
+
+                    if (!s_files[x].dirty)
+                        continue;
+
+                    pending.push_back({ static_cast<file>(x), file_path(static_cast<file>(x)), to_string(s_files[x]) });
+                    s_files[x].dirty = false;
                 }
             }
-                
-            else {
 
-                if(!line.empty())
-                    if (line.find("[") == std::string::npos)
-                        updatedConfig << line << '\n';
-                    else
-                        updatedConfig << line << '\n';
+            for (const auto& [type, path, content] : pending) {
+
+                io::create_directory(path.parent_path());
+
+                io::atomic_file_writer writer(path);
+                writer.write(std::string_view(content));
+                if (writer.commit()) {
+
+                    std::lock_guard lock(s_mutex);
+                    s_files[static_cast<size_t>(type)].last_written = content;
+                    continue;
+                }
+
+                // not marked as dirty again, that would retry in a loop; the memory copy is complete and written with the next change
+                LOG(Error, "Failed to write config file [" << path.generic_string() << "], retrying with the next change");
             }
         }
 
+        // writes changed files once no change happened for [FLUSH_DELAY]
+        void flush_loop() {
 
-        // Close the original file
-        configFile.close();
+            std::unique_lock lock(s_mutex);
+            while (!s_stop) {
 
-        if (!section_found || found_key || override) {
+                s_changed.wait(lock, [] { return s_stop || std::any_of(s_files.begin(), s_files.end(), [](const ini_file& data) { return data.dirty; }); });
+                while (!s_stop && std::chrono::steady_clock::now() < s_last_change + FLUSH_DELAY)
+                    s_changed.wait_until(lock, s_last_change + FLUSH_DELAY);
 
-            // Open the file in truncation mode to clear its content
-            std::ofstream outFile(file_path, std::ios::trunc);
-            if (!outFile.is_open()) {
-                LOG(Error, "problems opening file");
-                return false;
+                if (s_stop)
+                    break;
+
+                lock.unlock();
+                write_dirty_files();
+                lock.lock();
             }
+        }
+
+        // expects [s_mutex] to be locked
+        void schedule_flush() {
+
+            s_last_change = std::chrono::steady_clock::now();
+            if (!s_flush_thread.joinable()) {
+
+                s_stop = false;
+                s_flush_thread = std::thread(flush_loop);
+            }
+            s_changed.notify_all();
+        }
+
+    }
+
+
+    bool get(const file target_config_file, std::string_view section, std::string_view key, std::string& value) {
+
+        VALIDATE(is_store_file(target_config_file), return false, "", "Config file [" << file_type_to_string(target_config_file) << "] is not an INI file of the store");
+        std::lock_guard lock(s_mutex);
+        return get_value(get_file(target_config_file), section, key, value);
+    }
+
+
+    void set(const file target_config_file, std::string_view section, std::string_view key, std::string_view value) {
+
+        VALIDATE(is_store_file(target_config_file), return, "", "Config file [" << file_type_to_string(target_config_file) << "] is not an INI file of the store");
+        std::lock_guard lock(s_mutex);
+        ini_file& data = get_file(target_config_file);
+        set_value(target_config_file, data, section, key, value);
+        if (data.dirty)
+            schedule_flush();
+    }
+
+
+    u32 get_many(const file target_config_file, std::vector<entry>& entries) {
+
+        VALIDATE(is_store_file(target_config_file), return 0, "", "Config file [" << file_type_to_string(target_config_file) << "] is not an INI file of the store");
+        std::lock_guard lock(s_mutex);
+        ini_file& data = get_file(target_config_file);
+
+        u32 found_count = 0;
+        for (auto& entry : entries) {
+
+            entry.found = get_value(data, entry.section, entry.key, entry.value);
+            found_count += entry.found;
+        }
+        return found_count;
+    }
+
+
+    void set_many(const file target_config_file, const std::vector<entry>& entries) {
+
+        VALIDATE(is_store_file(target_config_file), return, "", "Config file [" << file_type_to_string(target_config_file) << "] is not an INI file of the store");
+        std::lock_guard lock(s_mutex);
+        ini_file& data = get_file(target_config_file);
+        for (const auto& entry : entries)
+            set_value(target_config_file, data, entry.section, entry.key, entry.value);
+
+        if (data.dirty)
+            schedule_flush();
+    }
+
+
+    void flush() { write_dirty_files(); }
+
+
+    void shutdown() {
+
+        {
+            std::lock_guard watcher_lock(s_watcher_mutex);
+            s_watcher.reset();
+        }
+        {
+            std::lock_guard lock(s_mutex);
+            s_stop = true;
+        }
+        s_changed.notify_all();
+        if (s_flush_thread.joinable())
+            s_flush_thread.join();
+
+        write_dirty_files();
+    }
+
+    u32 subscribe(const file target_config_file, std::function<void(file)>&& on_change) {
+
+        std::lock_guard watcher_lock(s_watcher_mutex);
+        if (!s_watcher)
+            s_watcher = std::make_unique<io::file_watcher>();
+
+        std::filesystem::path path{};
+        {
+            std::lock_guard lock(s_mutex);
+            path = (target_config_file == file::imgui) ? get_filepath_from_configtype_ini(s_root.empty() ? util::get_executable_path() : s_root, file::imgui) : file_path(target_config_file);
+        }
+
+        return s_watcher->watch(path, [target_config_file, on_change = std::move(on_change)](const std::filesystem::path& changed_file) {
+
+            if (!is_store_file(target_config_file)) {
+
+                on_change(target_config_file);                          // not parsed by the store, only reported
+                return;
+            }
+
+            // the file is read and parsed without [s_mutex], it is only locked to compare and swap the memory copy
+            std::string last_written{};
+            {
+                std::lock_guard lock(s_mutex);
+                const ini_file& data = s_files[static_cast<size_t>(target_config_file)];
+                if (data.loaded)
+                    last_written = data.last_written;
+            }
+
+            std::string content = io::read_file(changed_file);
+            if (!last_written.empty() && content == last_written)
+                return;                                                 // written by this store
+
+            ini_file parsed{};
+            parse_content(parsed, content);
+            {
+                std::lock_guard lock(s_mutex);
+                ini_file& data = s_files[static_cast<size_t>(target_config_file)];
+                if (!data.dirty) {                                      // parsed again here, so typed keys never read a stale slot
+
+                    parsed.loaded = true;
+                    parsed.last_written = std::move(data.last_written);
+                    data = std::move(parsed);
+                    fill_slots(target_config_file, data);
+                }
+            }
+            on_change(target_config_file);
+        });
+    }
+
+
+    void unsubscribe(const u32 id) {
 
-            // Write the updated content to the file
-            outFile << updatedConfig.str();
-            if (!section_found) {
+        std::lock_guard watcher_lock(s_watcher_mutex);
+        if (s_watcher)
+            s_watcher->unwatch(id);
+    }
+
+
+    void internal::load_slots(const file target_config_file) {
+
+        VALIDATE(is_store_file(target_config_file), return, "", "Config file [" << file_type_to_string(target_config_file) << "] is not an INI file of the store");
+        std::lock_guard lock(s_mutex);
+        get_file(target_config_file);                                   // fills the slots if the file was not parsed yet
+    }
+
+
+    void internal::set_slot(const slot index, std::string_view value) {
+
+        const slot_info& info = s_slot_infos[static_cast<size_t>(index)];
+        set(info.target, info.section, info.key, value);
+    }
+
+
+    // joins the background writer if shutdown() was not called, a joinable std::thread would terminate the process on exit
+    static struct shutdown_guard {
+        ~shutdown_guard() { shutdown(); }
+    } s_shutdown_guard{};
+
+    // ----------------------------------------------- files ----------------------------------------------- 
+
+    //
+    void init(std::filesystem::path dir) {
+
+        PROFILE_FUNCTION();
+
+        // pending changes belong to the previous location, files are loaded again from [dir] on first use
+        flush();
+        {
+            std::lock_guard lock(s_mutex);
+            s_root = dir;
+            for (auto& data : s_files)
+                data = {};
+            for (auto& loaded : internal::slots_loaded)
+                loaded.store(false, std::memory_order_release);
+        }
+
+        io::create_directory(dir / CONFIG_DIR);
+        LOG(Trace, "Checking Engine config files at: " << dir / CONFIG_DIR);
+        for (int i = 0; i <= static_cast<int>(file::input); ++i) {
+
+            std::filesystem::path file_path = dir / CONFIG_DIR / (config::file_type_to_string(static_cast<file>(i)) + CONFIG_FILE_EXTENSION);
+            std::ofstream config_file(file_path, std::ios::app);
+            if (!config_file.is_open()) {
 
-                outFile << "[" << section << "]" << '\n';
-                outFile << key << "=" << value << '\n';
+                LOG(Error, "Failed to open/create config file: [" << file_path << "]");
+                return;
             }
+            config_file.close();
+        }
+    }
+
+    //
+    void create_config_files_for_project(std::filesystem::path project_dir) {
 
-            outFile.close();
-            // LOG(Trace, "File [" << file_path << "] updated with [" << std::setw(20) << std::left << section << " / " << std::setw(25) << std::left << key << "]: [" << value << "]");
+        io::create_directory(project_dir / CONFIG_DIR);
+        LOG(Trace, "Checking project config files at: " << project_dir / CONFIG_DIR);
+        for (int i = 0; i <= static_cast<int>(file::input); ++i) {
+
+            std::filesystem::path file_path = project_dir / CONFIG_DIR / (config::file_type_to_string(static_cast<file>(i)) + CONFIG_FILE_EXTENSION);
+            std::ofstream config_file(file_path, std::ios::app);
+            if (!config_file.is_open()) {
+
+                LOG(Error, "Failed to open/create config file: [" << file_path << "]");
+                return;
+            }
+            config_file.close();
         }
-        return false; // Key not found
+    }
+
+    // 
+    bool check_for_configuration(const file target_config_file, const std::string& section, const std::string& key, std::string& value, const bool override) {
+
+        PROFILE_FUNCTION();
+
+        VALIDATE(is_store_file(target_config_file), return false, "", "Config file [" << file_type_to_string(target_config_file) << "] is not an INI file of the store");
+        std::lock_guard lock(s_mutex);
+        ini_file& data = get_file(target_config_file);
+        std::string current{};
+        const bool found = get_value(data, section, key, current);
+        if (found && !override)
+            value = current;
+        else
+            set_value(target_config_file, data, section, key, value);
+
+        if (data.dirty)
+            schedule_flush();
+        return found;
     }
 
     // ----------------------------------------------- file path resolution ----------------------------------------------- 
@@ -173,6 +611,7 @@ namespace AT::config {
             {file::imgui, "imgui"},
             {file::input, "input"},
             {file::app_settings, "app_settings"},
+            {file::launcher, "launcher"},
         };
 
         auto it = typeStrings.find(type);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <type_traits>
+#include <bit>
+#include <charconv>
 #include <glm/glm.hpp>
 
 // struct ImVec2;
@@ -15,6 +17,7 @@ namespace AT::config {
 		imgui,			// ImGui specific configuration.
 		input,			// Input bindings / input-related configuration.
 		app_settings,	// Application-wide settings.
+		launcher,		// Launcher state owned by the in-memory store (INI file), e.g. the typed keys below.
 	};
 
 	// Represents operations that can be performed on configuration files (underlying type: u8).
@@ -24,6 +27,7 @@ namespace AT::config {
 	};
 
 	// @brief Initializes the configuration files by creating necessary directories and default files.
+	//        The in-memory store uses the files in [dir] from now on (default: the executable path), pending changes are written first.
 	// @param dir The root directory where configuration files and the CONFIG_DIR will be created.
 	// @return void This function does not have a return value.
 	void init(std::filesystem::path dir);
@@ -50,14 +54,182 @@ namespace AT::config {
 	// @return std::filesystem::path The full path to the configuration INI file (e.g., CONFIG_DIR/<type>.ini).
 	std::filesystem::path get_filepath_from_configtype_ini(std::filesystem::path root, file type);
 
+	// ----------------------------------------------- in-memory store -----------------------------------------------
+	// The INI config files ([file::launcher]) are parsed once on first use and kept in memory as sections ([section] followed by
+	// key=value lines). The YAML files are read and written by [serializer::yaml] only, the functions below reject them.
+	// Reads are hash lookups, writes only change the memory copy and mark the file as changed. A background thread writes
+	// changed files atomically once no change happened for [FLUSH_DELAY], so a burst of changes causes one write.
+	// All functions are thread-safe.
+
+	inline constexpr std::chrono::milliseconds FLUSH_DELAY{ 500 };
+
+	// A single value for get_many()/set_many().
+	struct entry {
+		std::string		section{};
+		std::string		key{};
+		std::string		value{};
+		bool			found = false;		// set by get_many()
+	};
+
+	// @brief Reads a value from the in-memory copy of [target_config_file].
+	// @param value Receives the value if the key exists, is left untouched otherwise.
+	// @return bool true if the key exists.
+	bool get(const file target_config_file, std::string_view section, std::string_view key, std::string& value);
+
+	// @brief Sets a value in the in-memory copy of [target_config_file], the section and key are added if missing.
+	//        The file is written in the background after [FLUSH_DELAY].
+	void set(const file target_config_file, std::string_view section, std::string_view key, std::string_view value);
+
+	// @brief Reads many values with a single lock, e.g. to fill a settings panel.
+	// @param entries For every entry [value] and [found] are set, [value] is left untouched if the key does not exist.
+	// @return u32 The number of entries that were found.
+	u32 get_many(const file target_config_file, std::vector<entry>& entries);
+
+	// @brief Sets many values with a single lock, they are written to disk together.
+	void set_many(const file target_config_file, const std::vector<entry>& entries);
+
+	// @brief Writes all changed config files now and blocks until they are on disk.
+	void flush();
+
+	// @brief Stops the background writer and the change watcher and writes all changed config files. Call before the application exits.
+	void shutdown();
+
+	// @brief Calls [on_change] when [target_config_file] is changed on disk by another program or launcher instance
+	//        (for [file::imgui] the ImGui .ini file is watched). For a file of the store the in-memory copy is reloaded before [on_change] is called,
+	//        unless it has changes that are not written yet. Writes of the in-memory store itself are not reported.
+	//        A single watcher thread serves all subscriptions, see [io::file_watcher].
+	// @param on_change Called on the watcher thread, hand work that needs the main thread (e.g. ImGui) over to it.
+	// @return u32 An id for unsubscribe(), 0 on failure.
+	u32 subscribe(const file target_config_file, std::function<void(file)>&& on_change);
+
+	// @brief Stops a subscription, its callback is not called after this function returned.
+	void unsubscribe(const u32 id);
+
+	// ----------------------------------------------- typed keys -----------------------------------------------
+	// Settings that are read often (e.g. every frame) are declared once in [CONFIG_KEY_LIST] with their type and default value.
+	// Their values are parsed when the file is loaded (and when it changes) into a slot array, so reading one is an array index:
+	//   const f32 width = config::get(config::keys::dashboard::sidebar_width);
+	// Values are stored in the same file as the string API, set() of either API updates both.
+	// Supported types: bool, integers and floating point values.
+
+	// X(group, name, type, file, section, key, default value)
+	#define CONFIG_KEY_LIST(X)																												\
+		X(dashboard,	sidebar_width,			f32,	file::launcher,		"dashboard",	"sidebar_width",			80.f)			\
+		X(dashboard,	project_card_width,		f32,	file::launcher,		"dashboard",	"project_card_width",		200.f)			\
+		X(dashboard,	project_card_height,	f32,	file::launcher,		"dashboard",	"project_card_height",		250.f)
+
+	// @brief FNV-1a hash of [section] and [key], used to find the typed key of a value set through the string API.
+	constexpr u64 hash_key(std::string_view section, std::string_view key) {
+
+		u64 hash = 0xcbf29ce484222325ull;
+		auto add = [&hash](const char character) { hash = (hash ^ static_cast<u8>(character)) * 0x100000001b3ull; };
+		for (const char character : section)
+			add(character);
+		add('\n');
+		for (const char character : key)
+			add(character);
+		return hash;
+	}
+
+	// Index of every typed key in the slot array.
+	enum class slot : u32 {
+	#define CONFIG_KEY_SLOT(group, name, type, target, section, key, default_value)	group##_##name,
+		CONFIG_KEY_LIST(CONFIG_KEY_SLOT)
+	#undef CONFIG_KEY_SLOT
+		count
+	};
+
+	// A setting with its location, type and default value, see [CONFIG_KEY_LIST].
+	template<typename T>
+	struct typed_key {
+		static_assert(std::is_arithmetic_v<T> && sizeof(T) <= sizeof(u64), "typed config keys hold bool, integer or floating point values");
+
+		file				target;
+		std::string_view	section;
+		std::string_view	key;
+		T					default_value;
+		slot				index;
+		u64					hash;
+	};
+
+	namespace keys {
+	#define CONFIG_KEY_DECLARATION(group, name, type, target, section, key, default_value)															\
+		namespace group { inline constexpr typed_key<type> name{ target, section, key, default_value, slot::group##_##name, hash_key(section, key) }; }
+		CONFIG_KEY_LIST(CONFIG_KEY_DECLARATION)
+	#undef CONFIG_KEY_DECLARATION
+	}
+
+	namespace internal {
+
+		inline constexpr size_t FILE_COUNT = static_cast<size_t>(file::launcher) + 1;
+
+		// values are stored as their bit pattern, so every slot can be read without a lock
+		template<typename T>
+		constexpr u64 to_bits(const T value) {
+
+			if constexpr (std::is_same_v<T, bool>)		return value ? 1 : 0;
+			else if constexpr (sizeof(T) == 8)			return std::bit_cast<u64>(value);
+			else if constexpr (sizeof(T) == 4)			return std::bit_cast<u32>(value);
+			else if constexpr (sizeof(T) == 2)			return std::bit_cast<u16>(value);
+			else										return std::bit_cast<u8>(value);
+		}
+
+		template<typename T>
+		constexpr T from_bits(const u64 bits) {
+
+			if constexpr (std::is_same_v<T, bool>)		return bits != 0;
+			else if constexpr (sizeof(T) == 8)			return std::bit_cast<T>(bits);
+			else if constexpr (sizeof(T) == 4)			return std::bit_cast<T>(static_cast<u32>(bits));
+			else if constexpr (sizeof(T) == 2)			return std::bit_cast<T>(static_cast<u16>(bits));
+			else										return std::bit_cast<T>(static_cast<u8>(bits));
+		}
+
+		inline std::array<std::atomic<u64>, static_cast<size_t>(slot::count)>	slots{};
+		inline std::array<std::atomic<bool>, FILE_COUNT>						slots_loaded{};		// the slots of a file are filled on first use
+
+		// parses [target_config_file] if needed, this fills its slots
+		void load_slots(const file target_config_file);
+
+		// stores [value] (already formatted) in the file of [index], this also updates the slot
+		void set_slot(const slot index, std::string_view value);
+
+		template<typename T>
+		std::string format(const T value) {
+
+			if constexpr (std::is_same_v<T, bool>)
+				return value ? "true" : "false";
+			else {
+				char buffer[64];
+				const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+				return std::string(buffer, result.ptr);
+			}
+		}
+	}
+
+	// @brief Reads a typed setting. After its file was loaded this is a single atomic load, no lock, lookup or parse.
+	// @return T The value of the file, or the default value of [key] if the file has no valid value.
+	template<typename T>
+	T get(const typed_key<T>& key) {
+
+		if (!internal::slots_loaded[static_cast<size_t>(key.target)].load(std::memory_order_acquire)) [[unlikely]]
+			internal::load_slots(key.target);
+
+		return internal::from_bits<T>(internal::slots[static_cast<size_t>(key.index)].load(std::memory_order_relaxed));
+	}
+
+	// @brief Sets a typed setting, it is written in the background like set() of the string API.
+	template<typename T>
+	void set(const typed_key<T>& key, const std::type_identity_t<T> value) { internal::set_slot(key.index, internal::format(value)); }
+
 	// @brief Checks for the existence of a configuration entry in the specified configuration file. If found and override==true, the existing value is replaced.
 	//        If found and override==false the current value is loaded into the provided value reference. If not found, the key/value pair is appended.
-	// @param target_config_file The configuration file type to inspect (enum file).
+	//        Uses the in-memory store, see get() and set().
+	// @param target_config_file The configuration file type to inspect, an INI file of the store ([file::launcher]).
 	// @param section The section name in the configuration file where the key/value is expected (e.g., "graphics").
 	// @param key The key to search for inside the section.
 	// @param value Reference to a string that will be updated with the existing value (when override==false) or used to overwrite/append when override==true.
 	// @param override If true, existing value is replaced with the provided value; if false, the provided value is overwritten by the existing value if found.
-	// @return bool true if the key was found (and possibly updated/appended), false if not found or on failure.
+	// @return bool true if the key existed before the call, false if it was appended.
 	bool check_for_configuration(const file target_config_file, const std::string& section, const std::string& key, std::string& value, const bool override);
 
 }
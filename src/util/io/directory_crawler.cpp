@@ -0,0 +1,315 @@
+#include "util/pch.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#elif defined(PLATFORM_LINUX)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <dirent.h>
+	#include <sys/stat.h>
+	#include <sys/syscall.h>
+#else
+	#error undefined platform
+#endif
+
+#include "directory_crawler.h"
+
+
+namespace AT::io {
+
+	directory_crawler::directory_crawler(const u32 thread_count)
+		: m_thread_count(thread_count ? thread_count : std::max(std::thread::hardware_concurrency(), 1u)), m_skipped_directories(default_skipped_directories()) {
+
+		for (u32 x = 0; x < m_thread_count; x++)
+			m_queues.push_back(std::make_unique<directory_queue>());
+	}
+
+
+	directory_crawler::~directory_crawler() {
+
+		cancel();
+		wait();
+	}
+
+
+	const std::vector<std::string>& directory_crawler::default_skipped_directories() {
+
+		static const std::vector<std::string> s_names = { ".git", ".svn", ".hg", "bin", "bin-int", "build", "out", "node_modules", ".vs", ".vscode", ".idea" };
+		return s_names;
+	}
+
+
+	void directory_crawler::set_skipped_directories(std::vector<std::string> names) {
+
+		VALIDATE(!is_running(), return, "", "Can not change the skipped directories while a walk is running");
+		m_skipped_directories = std::move(names);
+	}
+
+
+	bool directory_crawler::start(const std::vector<std::filesystem::path>& roots, filter&& accept, callback&& on_match, finished_callback&& on_finished) {
+
+		VALIDATE(!is_running(), return false, "", "A directory walk is already running");
+		wait();											// join the threads of the previous walk
+
+		m_accept = std::move(accept);
+		m_on_match = std::move(on_match);
+		m_on_finished = std::move(on_finished);
+		m_cancel = false;
+		m_directories = 0;
+		m_files = 0;
+		m_matches = 0;
+		m_errors = 0;
+
+		u32 queue_index = 0;
+		for (const auto& root : roots) {
+
+			std::error_code error_code;
+			if (!std::filesystem::is_directory(root, error_code)) {
+
+				LOG(Warn, "Not searching [" << root.generic_string() << "], it is not a directory");
+				continue;
+			}
+			push(queue_index++ % m_thread_count, root.lexically_normal());
+		}
+
+		// without a directory to read one thread is enough, it only reports the end (never on the thread of the caller)
+		const u32 thread_count = m_pending == 0 ? 1 : m_thread_count;
+		m_active_threads = thread_count;
+		m_exiting_threads = thread_count;
+		for (u32 x = 0; x < thread_count; x++)
+			m_threads.emplace_back(&directory_crawler::run, this, x);
+		return true;
+	}
+
+
+	void directory_crawler::cancel() { m_cancel = true; }
+
+
+	void directory_crawler::wait() {
+
+		for (auto& thread : m_threads)
+			if (thread.joinable())
+				thread.join();
+		m_threads.clear();
+	}
+
+
+	directory_crawler::statistics directory_crawler::get_statistics() const { return { m_directories.load(), m_files.load(), m_matches.load(), m_errors.load() }; }
+
+
+	void directory_crawler::run(const u32 index) {
+
+		statistics counters{};
+		std::filesystem::path directory{};
+		while (!m_cancel.load(std::memory_order_relaxed)) {
+
+			if (!pop(index, directory) && !steal(index, directory)) {
+
+				if (m_pending.load(std::memory_order_acquire) == 0)
+					break;												// nothing queued and nothing being read that could add more
+
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+				continue;
+			}
+
+			read_directory(index, directory, counters);
+			m_pending.fetch_sub(1, std::memory_order_acq_rel);			// after the subdirectories were queued, so [m_pending] never reaches 0 early
+
+			// publish the counters now and then, not for every file
+			if (counters.directories >= 64) {
+
+				m_directories += counters.directories;
+				m_files += counters.files;
+				m_matches += counters.matches;
+				m_errors += counters.errors;
+				counters = {};
+			}
+		}
+
+		m_directories += counters.directories;
+		m_files += counters.files;
+		m_matches += counters.matches;
+		m_errors += counters.errors;
+
+		// a cancelled walk leaves directories behind
+		{
+			std::lock_guard lock(m_queues[index]->mutex);
+			m_pending.fetch_sub(m_queues[index]->directories.size(), std::memory_order_acq_rel);
+			m_queues[index]->directories.clear();
+		}
+
+		// the last thread reports the end before is_running() turns false, so a caller never sees a finished walk without its results
+		const bool last_thread = m_exiting_threads.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		if (last_thread && !m_cancel.load(std::memory_order_acquire) && m_on_finished)
+			m_on_finished();
+		m_active_threads.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+
+	void directory_crawler::push(const u32 index, std::filesystem::path&& directory) {
+
+		m_pending.fetch_add(1, std::memory_order_acq_rel);
+		std::lock_guard lock(m_queues[index]->mutex);
+		m_queues[index]->directories.push_back(std::move(directory));
+	}
+
+
+	// own queue: newest first (depth first)
+	bool directory_crawler::pop(const u32 index, std::filesystem::path& directory) {
+
+		std::lock_guard lock(m_queues[index]->mutex);
+		auto& directories = m_queues[index]->directories;
+		if (directories.empty())
+			return false;
+
+		directory = std::move(directories.back());
+		directories.pop_back();
+		return true;
+	}
+
+
+	// other queues: oldest first, these are closest to the root and hold the largest subtrees
+	bool directory_crawler::steal(const u32 index, std::filesystem::path& directory) {
+
+		for (u32 offset = 1; offset < m_thread_count; offset++) {
+
+			auto& queue = *m_queues[(index + offset) % m_thread_count];
+			std::lock_guard lock(queue.mutex);
+			if (queue.directories.empty())
+				continue;
+
+			directory = std::move(queue.directories.front());
+			queue.directories.pop_front();
+			return true;
+		}
+		return false;
+	}
+
+
+	bool directory_crawler::is_skipped(std::string_view name) const {
+
+		return std::any_of(m_skipped_directories.begin(), m_skipped_directories.end(), [name](const std::string& skipped) { return name == skipped; });
+	}
+
+
+#if defined(PLATFORM_LINUX)
+
+	// layout of the records returned by getdents64
+	struct linux_dirent64 {
+		u64				d_ino;
+		int64			d_off;
+		unsigned short	d_reclen;
+		unsigned char	d_type;
+		char			d_name[];
+	};
+
+
+	void directory_crawler::read_directory(const u32 index, const std::filesystem::path& directory, statistics& counters) {
+
+		const int directory_file = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (directory_file < 0) {
+
+			counters.errors++;
+			LOG(Trace, "Failed to open directory [" << directory.generic_string() << "]: " << std::strerror(errno));
+			return;
+		}
+		counters.directories++;
+
+		// getdents64 returns many entries per call and includes the file type, so most entries need no stat
+		alignas(linux_dirent64) char buffer[32 * 1024];
+		while (!m_cancel.load(std::memory_order_relaxed)) {
+
+			const long length = syscall(SYS_getdents64, directory_file, buffer, sizeof(buffer));
+			if (length <= 0) {
+
+				if (length < 0)
+					counters.errors++;
+				break;
+			}
+
+			for (long offset = 0; offset < length; ) {
+
+				const linux_dirent64* entry = reinterpret_cast<const linux_dirent64*>(buffer + offset);
+				offset += entry->d_reclen;
+
+				const std::string_view name(entry->d_name);
+				if (name == "." || name == "..")
+					continue;
+
+				unsigned char type = entry->d_type;
+				if (type == DT_UNKNOWN) {									// some file systems do not report the type
+
+					struct stat status{};
+					if (fstatat(directory_file, entry->d_name, &status, AT_SYMLINK_NOFOLLOW) != 0)
+						continue;
+					type = S_ISDIR(status.st_mode) ? DT_DIR : (S_ISREG(status.st_mode) ? DT_REG : DT_UNKNOWN);
+				}
+
+				if (type == DT_DIR) {
+
+					if (!is_skipped(name))
+						push(index, directory / name);
+
+				} else if (type == DT_REG) {
+
+					counters.files++;
+					if (!m_accept(name))
+						continue;
+
+					counters.matches++;
+					m_on_match(directory / name);
+				}
+			}
+		}
+
+		::close(directory_file);
+	}
+
+#elif defined(PLATFORM_WINDOWS)
+
+	void directory_crawler::read_directory(const u32 index, const std::filesystem::path& directory, statistics& counters) {
+
+		WIN32_FIND_DATAW data{};
+		HANDLE find = FindFirstFileExW((directory / "*").wstring().c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+		if (find == INVALID_HANDLE_VALUE) {
+
+			counters.errors++;
+			LOG(Trace, "Failed to open directory [" << directory.generic_string() << "]");
+			return;
+		}
+		counters.directories++;
+
+		do {
+
+			const std::wstring_view wide_name(data.cFileName);
+			if (wide_name == L"." || wide_name == L"..")
+				continue;
+
+			const std::filesystem::path child = directory / wide_name;
+			const std::string name = child.filename().string();
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)		// links and junctions are not followed
+				continue;
+
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+
+				if (!is_skipped(name))
+					push(index, std::filesystem::path(child));
+
+			} else {
+
+				counters.files++;
+				if (!m_accept(name))
+					continue;
+
+				counters.matches++;
+				m_on_match(child);
+			}
+
+		} while (!m_cancel.load(std::memory_order_relaxed) && FindNextFileW(find, &data));
+
+		FindClose(find);
+	}
+
+#endif
+
+}
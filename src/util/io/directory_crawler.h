@@ -0,0 +1,96 @@
+#pragma once
+
+
+namespace AT::io {
+
+	// Walks directory trees on several threads and reports matching files while the walk is still running.
+	// Every thread takes directories from its own queue (depth first, which keeps the walk close to the disk cache) and
+	// steals from the other queues once its own is empty, so a single huge subtree is still shared by all threads.
+	// Symbolic links to directories are not followed, directories named in [skipped directories] are not entered.
+	//
+	//   io::directory_crawler crawler;
+	//   crawler.start({ root }, [](std::string_view name) { return name.ends_with(".txt"); }, [](const std::filesystem::path& file) { ... });
+	//   ... (the calling thread is not blocked)
+	//   crawler.wait();
+	class directory_crawler {
+	public:
+
+		// Decides if a file is reported, gets the file name only. Called on the crawler threads.
+		using filter = std::function<bool(std::string_view file_name)>;
+
+		// Called on the crawler threads for every accepted file, possibly from several threads at the same time.
+		using callback = std::function<void(const std::filesystem::path& file)>;
+
+		// Called once on the last crawler thread when a walk completed (not when it was cancelled).
+		using finished_callback = std::function<void()>;
+
+		struct statistics {
+			u64						directories = 0;		// directories that were read
+			u64						files = 0;				// regular files that were seen
+			u64						matches = 0;			// files that were accepted by the filter
+			u64						errors = 0;				// directories that could not be read
+		};
+
+		// @param thread_count Number of threads of a walk, 0 uses std::thread::hardware_concurrency().
+		explicit directory_crawler(const u32 thread_count = 0);
+
+		// Cancels a running walk and waits for its threads.
+		~directory_crawler();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(directory_crawler);
+
+		// Names of directories that are not entered (e.g. ".git", "bin", "build"), compared with the directory name only.
+		static const std::vector<std::string>& default_skipped_directories();
+		void set_skipped_directories(std::vector<std::string> names);
+
+		// Starts a walk over [roots] on background threads and returns immediately.
+		// @param accept Decides which files are reported.
+		// @param on_match Called for every accepted file.
+		// @param on_finished Called on a crawler thread after every directory was read (also when no root exists), on_match() is not called afterwards.
+		// @return false if a walk is still running.
+		bool start(const std::vector<std::filesystem::path>& roots, filter&& accept, callback&& on_match, finished_callback&& on_finished = {});
+
+		// Stops the running walk as soon as possible, files that are found afterwards are not reported. Does not block.
+		void cancel();
+
+		// Blocks until the running walk is finished or cancelled.
+		void wait();
+
+		// Returns true while a walk is running.
+		bool is_running() const											{ return m_active_threads.load(std::memory_order_acquire) > 0; }
+
+		// Returns the counters of the current (or last) walk, they are updated while it is running.
+		statistics get_statistics() const;
+
+	private:
+
+		struct directory_queue {
+			std::mutex								mutex{};
+			std::deque<std::filesystem::path>		directories{};
+		};
+
+		void run(const u32 index);
+		void read_directory(const u32 index, const std::filesystem::path& directory, statistics& counters);
+		void push(const u32 index, std::filesystem::path&& directory);
+		bool pop(const u32 index, std::filesystem::path& directory);
+		bool steal(const u32 index, std::filesystem::path& directory);
+		bool is_skipped(std::string_view name) const;
+
+		u32											m_thread_count = 1;
+		std::vector<std::string>					m_skipped_directories{};
+		std::vector<std::unique_ptr<directory_queue>>	m_queues{};
+		std::vector<std::thread>					m_threads{};
+		filter										m_accept{};
+		callback									m_on_match{};
+		finished_callback							m_on_finished{};
+		std::atomic<u64>							m_pending = 0;				// directories that are queued or being read
+		std::atomic<u32>							m_active_threads = 0;
+		std::atomic<u32>							m_exiting_threads = 0;			// threads that did not finish their loop yet, the last one calls [m_on_finished]
+		std::atomic<bool>							m_cancel = false;
+		std::atomic<u64>							m_directories = 0;
+		std::atomic<u64>							m_files = 0;
+		std::atomic<u64>							m_matches = 0;
+		std::atomic<u64>							m_errors = 0;
+	};
+
+}
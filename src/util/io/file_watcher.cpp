@@ -0,0 +1,589 @@
+#include "util/pch.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#elif defined(PLATFORM_LINUX)
+	#include <poll.h>
+	#include <unistd.h>
+	#include <sys/eventfd.h>
+	#include <sys/inotify.h>
+#else
+	#error undefined platform
+#endif
+
+#include "file_watcher.h"
+
+
+namespace AT::io {
+
+#if defined(PLATFORM_LINUX)
+	static constexpr u32 TREE_EVENTS = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+#endif
+
+	static std::filesystem::path normalize(const std::filesystem::path& path) {
+
+		std::error_code error_code;
+		const std::filesystem::path absolute = std::filesystem::absolute(path, error_code);
+		return (error_code ? path : absolute).lexically_normal();
+	}
+
+
+	file_watcher::file_watcher(const std::chrono::milliseconds debounce)
+		: m_debounce(debounce) {
+
+#if defined(PLATFORM_WINDOWS)
+
+		m_wake_event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+		VALIDATE(m_wake_event != nullptr, return, "", "Failed to create the wake event of the file watcher");
+
+#elif defined(PLATFORM_LINUX)
+
+		m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		VALIDATE(m_inotify >= 0, return, "", "Failed to initialize inotify: " << std::strerror(errno));
+
+		m_tree_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		VALIDATE(m_tree_inotify >= 0, ::close(m_inotify); m_inotify = -1; return, "", "Failed to initialize inotify: " << std::strerror(errno));
+
+		m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		VALIDATE(m_wake >= 0, ::close(m_inotify); ::close(m_tree_inotify); m_inotify = m_tree_inotify = -1; return, "", "Failed to create the wake eventfd of the file watcher: " << std::strerror(errno));
+#endif
+
+		m_running = true;
+		m_thread = std::thread(&file_watcher::run, this);
+	}
+
+
+	file_watcher::~file_watcher() {
+
+		m_running = false;
+		wake();
+		if (m_thread.joinable())
+			m_thread.join();
+
+#if defined(PLATFORM_WINDOWS)
+		if (m_wake_event)
+			CloseHandle(m_wake_event);
+#elif defined(PLATFORM_LINUX)
+		if (m_inotify >= 0)
+			::close(m_inotify);					// also removes all watches
+		if (m_tree_inotify >= 0)
+			::close(m_tree_inotify);
+		if (m_wake >= 0)
+			::close(m_wake);
+#endif
+	}
+
+
+	u32 file_watcher::watch(const std::filesystem::path& file, callback&& on_change) {
+
+		VALIDATE(m_running, return 0, "", "File watcher is not running, can not watch [" << file.generic_string() << "]");
+
+		const std::filesystem::path path = normalize(file);
+		const std::filesystem::path directory_path = path.parent_path();
+
+		std::lock_guard lock(m_mutex);
+		auto directory = std::find_if(m_directories.begin(), m_directories.end(), [&](const watched_directory& entry) { return entry.path == directory_path; });
+		if (directory == m_directories.end()) {
+
+			watched_directory entry{ directory_path };
+#if defined(PLATFORM_LINUX)
+			entry.watch_descriptor = inotify_add_watch(m_inotify, directory_path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+			VALIDATE(entry.watch_descriptor >= 0, return 0, "", "Failed to watch directory [" << directory_path.generic_string() << "]: " << std::strerror(errno));
+#endif
+			m_directories.push_back(std::move(entry));
+			directory = std::prev(m_directories.end());
+		}
+
+		directory->file_count++;
+#if defined(PLATFORM_WINDOWS)
+		std::error_code error_code;
+		directory->last_write_times[path.generic_string()] = std::filesystem::last_write_time(path, error_code);
+#endif
+
+		const u32 id = m_next_id++;
+		m_files.push_back({ id, path, std::move(on_change) });
+		wake();								// the watcher thread of Windows waits on a handle per directory
+		return id;
+	}
+
+
+	u32 file_watcher::watch_directory(const std::filesystem::path& directory, const bool recursive, directory_callback&& on_change, const std::vector<std::string>& skipped) {
+
+		VALIDATE(m_running, return 0, "", "File watcher is not running, can not watch [" << directory.generic_string() << "]");
+
+		const std::filesystem::path path = normalize(directory);
+		std::error_code error_code;
+		VALIDATE(std::filesystem::is_directory(path, error_code), return 0, "", "Can not watch [" << path.generic_string() << "], it is not a directory");
+
+		std::lock_guard lock(m_mutex);
+		watched_tree tree{ m_next_id++, path, recursive, skipped, std::move(on_change) };
+
+#if defined(PLATFORM_LINUX)
+
+		if (!add_tree_directory(tree, path) || (recursive && !add_tree_subdirectories(tree, path))) {
+
+			remove_tree_descriptors(tree);						// all or nothing, the caller polls instead
+			return 0;
+		}
+
+#elif defined(PLATFORM_WINDOWS)
+
+		// every watched directory and tree needs a handle that the watcher thread waits on, the first one is the wake event
+		if (1 + m_directories.size() + m_trees.size() >= MAXIMUM_WAIT_OBJECTS) {
+
+			if (!m_watch_limit_reached.exchange(true))
+				LOG(Warn, "The file watcher can not wait for more than [" << MAXIMUM_WAIT_OBJECTS << "] directories, [" << path.generic_string() << "] is not watched");
+			return 0;
+		}
+#endif
+
+		const u32 id = tree.id;
+		m_trees.push_back(std::move(tree));
+		wake();
+		return id;
+	}
+
+
+	void file_watcher::unwatch(const u32 id) {
+
+		std::lock_guard callback_lock(m_callback_mutex);
+		std::lock_guard lock(m_mutex);
+
+		const auto tree = std::find_if(m_trees.begin(), m_trees.end(), [id](const watched_tree& entry) { return entry.id == id; });
+		if (tree != m_trees.end()) {
+
+#if defined(PLATFORM_LINUX)
+			remove_tree_descriptors(*tree);
+#endif
+			m_trees.erase(tree);
+			std::erase(m_pending_trees, id);
+			wake();
+			return;
+		}
+
+		const auto file = std::find_if(m_files.begin(), m_files.end(), [id](const watched_file& entry) { return entry.id == id; });
+		if (file == m_files.end())
+			return;
+
+		const std::filesystem::path directory_path = file->path.parent_path();
+		m_files.erase(file);
+
+		const auto directory = std::find_if(m_directories.begin(), m_directories.end(), [&](const watched_directory& entry) { return entry.path == directory_path; });
+		if (directory == m_directories.end() || --directory->file_count > 0)
+			return;
+
+#if defined(PLATFORM_LINUX)
+		inotify_rm_watch(m_inotify, directory->watch_descriptor);
+#endif
+		m_directories.erase(directory);
+		wake();
+	}
+
+
+	void file_watcher::add_pending(const std::filesystem::path& file) {
+
+		const bool watched = std::any_of(m_files.begin(), m_files.end(), [&](const watched_file& entry) { return entry.path == file; });
+		if (!watched)
+			return;
+
+		postpone_delivery();
+		if (std::find(m_pending.begin(), m_pending.end(), file) == m_pending.end())
+			m_pending.push_back(file);
+	}
+
+
+	void file_watcher::add_pending_tree(const u32 id) {
+
+		postpone_delivery();
+		if (std::find(m_pending_trees.begin(), m_pending_trees.end(), id) == m_pending_trees.end())
+			m_pending_trees.push_back(id);
+	}
+
+
+	// every event moves the delivery back, but not beyond [MAX_DELAY_FACTOR] times the debounce after the first event
+	void file_watcher::postpone_delivery() {
+
+		const auto now = std::chrono::steady_clock::now();
+		if (m_pending.empty() && m_pending_trees.empty())
+			m_latest_deadline = now + m_debounce * MAX_DELAY_FACTOR;
+
+		m_deadline = std::min(now + m_debounce, m_latest_deadline);
+	}
+
+
+	void file_watcher::deliver_pending() {
+
+		std::lock_guard callback_lock(m_callback_mutex);
+
+		std::vector<std::pair<std::filesystem::path, callback>> calls{};
+		std::vector<std::pair<std::filesystem::path, directory_callback>> tree_calls{};
+		{
+			std::lock_guard lock(m_mutex);
+			if ((m_pending.empty() && m_pending_trees.empty()) || std::chrono::steady_clock::now() < m_deadline)
+				return;
+
+			for (const auto& pending : m_pending)
+				for (const auto& file : m_files)
+					if (file.path == pending)
+						calls.emplace_back(file.path, file.on_change);
+
+			for (const u32 id : m_pending_trees)
+				for (const auto& tree : m_trees)
+					if (tree.id == id)
+						tree_calls.emplace_back(tree.directory, tree.on_change);
+
+			m_pending.clear();
+			m_pending_trees.clear();
+		}
+
+		for (const auto& [path, on_change] : calls) {
+
+			try {
+				on_change(path);
+			} catch (const std::exception& exception) {
+				LOG(Error, "File watcher callback for [" << path.generic_string() << "] threw: " << exception.what());
+			}
+		}
+
+		for (const auto& [directory, on_change] : tree_calls) {
+
+			try {
+				on_change(directory);
+			} catch (const std::exception& exception) {
+				LOG(Error, "File watcher callback for [" << directory.generic_string() << "] threw: " << exception.what());
+			}
+		}
+	}
+
+
+	void file_watcher::wake() {
+
+#if defined(PLATFORM_WINDOWS)
+		if (m_wake_event)
+			SetEvent(m_wake_event);
+#elif defined(PLATFORM_LINUX)
+		if (m_wake >= 0) {
+
+			const u64 value = 1;
+			[[maybe_unused]] const ssize_t result = ::write(m_wake, &value, sizeof(value));
+		}
+#endif
+	}
+
+
+	// time until the collected changes are due, -1 if nothing is pending
+	static int milliseconds_until(const std::chrono::steady_clock::time_point deadline, const bool has_pending) {
+
+		if (!has_pending)
+			return -1;
+
+		const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+		return static_cast<int>(std::clamp<int64>(remaining + 1, 0, std::numeric_limits<int>::max()));
+	}
+
+
+#if defined(PLATFORM_LINUX)
+
+	void file_watcher::run() {
+
+		alignas(inotify_event) char buffer[16 * 1024];
+		while (m_running) {
+
+			int timeout = -1;
+			{
+				std::lock_guard lock(m_mutex);
+				timeout = milliseconds_until(m_deadline, !m_pending.empty() || !m_pending_trees.empty());
+			}
+
+			pollfd descriptors[3] = { { m_inotify, POLLIN, 0 }, { m_wake, POLLIN, 0 }, { m_tree_inotify, POLLIN, 0 } };
+			if (poll(descriptors, 3, timeout) < 0) {
+
+				if (errno == EINTR)
+					continue;
+
+				LOG(Error, "Polling the file watcher failed, stopping: " << std::strerror(errno));
+				break;
+			}
+
+			if (descriptors[1].revents & POLLIN) {
+
+				u64 value = 0;
+				[[maybe_unused]] const ssize_t result = ::read(m_wake, &value, sizeof(value));
+			}
+
+			if (descriptors[0].revents & POLLIN) {
+
+				for (ssize_t length = 0; (length = ::read(m_inotify, buffer, sizeof(buffer))) > 0; ) {
+
+					std::lock_guard lock(m_mutex);
+					for (char* position = buffer; position < buffer + length; ) {
+
+						const inotify_event* event = reinterpret_cast<const inotify_event*>(position);
+						position += sizeof(inotify_event) + event->len;
+
+						if (event->mask & IN_Q_OVERFLOW) {					// events were lost, report every file
+
+							for (const auto& file : m_files)
+								add_pending(file.path);
+							continue;
+						}
+
+						if (event->len == 0)
+							continue;
+
+						const auto directory = std::find_if(m_directories.begin(), m_directories.end(), [&](const watched_directory& entry) { return entry.watch_descriptor == event->wd; });
+						if (directory != m_directories.end())
+							add_pending(directory->path / event->name);
+					}
+				}
+			}
+
+			if (descriptors[2].revents & POLLIN) {
+
+				for (ssize_t length = 0; (length = ::read(m_tree_inotify, buffer, sizeof(buffer))) > 0; ) {
+
+					std::lock_guard lock(m_mutex);
+					for (char* position = buffer; position < buffer + length; ) {
+
+						const inotify_event* event = reinterpret_cast<const inotify_event*>(position);
+						position += sizeof(inotify_event) + event->len;
+						handle_tree_event(*event);
+					}
+				}
+			}
+
+			deliver_pending();
+		}
+	}
+
+
+	bool file_watcher::add_tree_directory(watched_tree& tree, const std::filesystem::path& directory) {
+
+		const int descriptor = inotify_add_watch(m_tree_inotify, directory.c_str(), TREE_EVENTS);
+		if (descriptor < 0) {
+
+			if (errno == ENOSPC || errno == ENOMEM) {
+
+				if (!m_watch_limit_reached.exchange(true))
+					LOG(Warn, "The inotify watch limit is reached (fs.inotify.max_user_watches), [" << directory.generic_string() << "] and further directories are not watched");
+				return false;
+			}
+
+			LOG(Trace, "Not watching directory [" << directory.generic_string() << "]: " << std::strerror(errno));		// e.g. removed in the meantime
+			return true;
+		}
+
+		tree_descriptor& entry = m_tree_descriptors[descriptor];
+		entry.path = directory;
+		if (std::find(entry.owners.begin(), entry.owners.end(), tree.id) == entry.owners.end())
+			entry.owners.push_back(tree.id);
+		if (std::find(tree.descriptors.begin(), tree.descriptors.end(), descriptor) == tree.descriptors.end())
+			tree.descriptors.push_back(descriptor);
+		return true;
+	}
+
+
+	bool file_watcher::add_tree_subdirectories(watched_tree& tree, const std::filesystem::path& directory) {
+
+		std::error_code error_code;
+		auto iterator = std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, error_code);
+		for (const auto end = std::filesystem::recursive_directory_iterator(); !error_code && iterator != end; iterator.increment(error_code)) {
+
+			if (!iterator->is_directory(error_code) || iterator->is_symlink(error_code))
+				continue;
+
+			const std::string name = iterator->path().filename().string();
+			if (std::find(tree.skipped.begin(), tree.skipped.end(), name) != tree.skipped.end()) {
+
+				iterator.disable_recursion_pending();
+				continue;
+			}
+
+			if (!add_tree_directory(tree, iterator->path()))
+				return false;
+		}
+		return true;
+	}
+
+
+	void file_watcher::remove_tree_descriptors(watched_tree& tree) {
+
+		for (const int descriptor : tree.descriptors) {
+
+			const auto found = m_tree_descriptors.find(descriptor);
+			if (found == m_tree_descriptors.end())
+				continue;
+
+			std::erase(found->second.owners, tree.id);
+			if (!found->second.owners.empty())
+				continue;
+
+			inotify_rm_watch(m_tree_inotify, descriptor);
+			m_tree_descriptors.erase(found);
+		}
+		tree.descriptors.clear();
+	}
+
+
+	void file_watcher::handle_tree_event(const inotify_event& event) {
+
+		if (event.mask & IN_Q_OVERFLOW) {									// events were lost, report every tree
+
+			for (const auto& tree : m_trees)
+				add_pending_tree(tree.id);
+			return;
+		}
+
+		const auto found = m_tree_descriptors.find(event.wd);
+		if (found == m_tree_descriptors.end())
+			return;
+
+		// copies, adding directories below can rehash [m_tree_descriptors]
+		const std::vector<u32> owners = found->second.owners;
+		const std::filesystem::path directory = found->second.path;
+
+		if (event.mask & IN_IGNORED) {										// the directory was removed (or unwatched)
+
+			for (auto& tree : m_trees)
+				std::erase(tree.descriptors, event.wd);
+			m_tree_descriptors.erase(found);
+			return;
+		}
+
+		for (const u32 id : owners) {
+
+			const auto tree = std::find_if(m_trees.begin(), m_trees.end(), [id](const watched_tree& entry) { return entry.id == id; });
+			if (tree == m_trees.end())
+				continue;
+
+			add_pending_tree(id);
+
+			// directories that are created or moved into a recursive tree are watched as well
+			const bool new_directory = (event.mask & IN_ISDIR) && (event.mask & (IN_CREATE | IN_MOVED_TO)) && event.len > 0;
+			if (!new_directory || !tree->recursive || std::find(tree->skipped.begin(), tree->skipped.end(), std::string_view(event.name)) != tree->skipped.end())
+				continue;
+
+			const std::filesystem::path child = directory / event.name;
+			if (add_tree_directory(*tree, child))
+				add_tree_subdirectories(*tree, child);
+		}
+	}
+
+#elif defined(PLATFORM_WINDOWS)
+
+	// handles of trees are kept in the same map as the handles of directories, '#' never starts an absolute path
+	static std::string tree_key(const u32 id) { return "#" + std::to_string(id); }
+
+
+	void file_watcher::run() {
+
+		// change notification handles are owned by this thread and follow [m_directories]
+		std::unordered_map<std::string, HANDLE> handles{};
+		while (m_running) {
+
+			std::vector<HANDLE> wait_handles{ m_wake_event };
+			std::vector<std::string> wait_directories{ "" };
+			int timeout = -1;
+			{
+				std::lock_guard lock(m_mutex);
+				for (auto it = handles.begin(); it != handles.end(); ) {
+
+					const bool watched = std::any_of(m_directories.begin(), m_directories.end(), [&](const watched_directory& entry) { return entry.path.generic_string() == it->first; })
+						|| std::any_of(m_trees.begin(), m_trees.end(), [&](const watched_tree& entry) { return tree_key(entry.id) == it->first; });
+					if (watched) {
+
+						++it;
+						continue;
+					}
+
+					FindCloseChangeNotification(it->second);
+					it = handles.erase(it);
+				}
+
+				for (const auto& directory : m_directories) {
+
+					const std::string key = directory.path.generic_string();
+					if (!handles.contains(key)) {
+
+						HANDLE handle = FindFirstChangeNotificationW(directory.path.wstring().c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+						VALIDATE(handle != INVALID_HANDLE_VALUE, continue, "", "Failed to watch directory [" << key << "]");
+						handles.emplace(key, handle);
+					}
+
+					if (wait_handles.size() < MAXIMUM_WAIT_OBJECTS) {
+
+						wait_handles.push_back(handles.at(key));
+						wait_directories.push_back(key);
+					}
+				}
+
+				// a tree is a single recursive notification handle
+				for (const auto& tree : m_trees) {
+
+					const std::string key = tree_key(tree.id);
+					if (!handles.contains(key)) {
+
+						HANDLE handle = FindFirstChangeNotificationW(tree.directory.wstring().c_str(), tree.recursive ? TRUE : FALSE,
+							FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE);
+						VALIDATE(handle != INVALID_HANDLE_VALUE, continue, "", "Failed to watch directory [" << tree.directory.generic_string() << "]");
+						handles.emplace(key, handle);
+					}
+
+					if (wait_handles.size() < MAXIMUM_WAIT_OBJECTS) {
+
+						wait_handles.push_back(handles.at(key));
+						wait_directories.push_back(key);
+					}
+				}
+				timeout = milliseconds_until(m_deadline, !m_pending.empty() || !m_pending_trees.empty());
+			}
+
+			const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(wait_handles.size()), wait_handles.data(), FALSE, timeout < 0 ? INFINITE : static_cast<DWORD>(timeout));
+			if (result > WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + wait_handles.size()) {
+
+				const size_t index = result - WAIT_OBJECT_0;
+				FindNextChangeNotification(wait_handles[index]);
+
+				std::lock_guard lock(m_mutex);
+				const auto tree = std::find_if(m_trees.begin(), m_trees.end(), [&](const watched_tree& entry) { return tree_key(entry.id) == wait_directories[index]; });
+				if (tree != m_trees.end())
+					add_pending_tree(tree->id);
+
+				// the notification does not name the file, compare the write times of the watched files of this directory
+				for (auto& directory : m_directories) {
+
+					if (directory.path.generic_string() != wait_directories[index])
+						continue;
+
+					for (const auto& file : m_files) {
+
+						if (file.path.parent_path() != directory.path)
+							continue;
+
+						std::error_code error_code;
+						const auto write_time = std::filesystem::last_write_time(file.path, error_code);
+						auto& last_write_time = directory.last_write_times[file.path.generic_string()];
+						if (!error_code && write_time != last_write_time) {
+
+							last_write_time = write_time;
+							add_pending(file.path);
+						}
+					}
+				}
+
+			} else if (result == WAIT_FAILED) {
+
+				LOG(Error, "Waiting for file changes failed, stopping the file watcher");
+				break;
+			}
+
+			deliver_pending();
+		}
+
+		for (const auto& [directory, handle] : handles)
+			FindCloseChangeNotification(handle);
+	}
+
+#endif
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+
+namespace AT::io {
+
+	// Notifies about changes of individual files, without polling.
+	// One thread waits for change events of the OS (inotify on Linux, change notifications on Windows) for all watched files.
+	// Events are collected and delivered once no further event arrived for [debounce] (at the latest [MAX_DELAY_FACTOR] times
+	// [debounce] after the first one), so an editor that writes a file in several steps, a burst of saves or a git checkout
+	// causes a single notification per file or directory.
+	// The parent directory is watched, so files that are replaced by a rename (see [atomic_file_writer]) or created later
+	// are detected as well. Whole directory trees can be watched with watch_directory().
+	class file_watcher {
+	public:
+
+		// Called on the watcher thread with the path that was passed to watch().
+		using callback = std::function<void(const std::filesystem::path& file)>;
+
+		// Called on the watcher thread with the directory that was passed to watch_directory().
+		using directory_callback = std::function<void(const std::filesystem::path& directory)>;
+
+		static constexpr u32 MAX_DELAY_FACTOR = 10;				// steady events delay a notification by at most [debounce] * this
+
+		// Starts the watcher thread. Failure is logged, watch() then returns 0.
+		// @param debounce Time without new events before the collected changes are delivered.
+		explicit file_watcher(const std::chrono::milliseconds debounce = std::chrono::milliseconds(100));
+		~file_watcher();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(file_watcher);
+
+		// Calls [on_change] whenever [file] is written, replaced or created. The directory of [file] has to exist.
+		// @param file The file to watch.
+		// @param on_change Called on the watcher thread, must not call watch() or unwatch() of this watcher.
+		// @return An id for unwatch(), 0 if the file could not be watched.
+		u32 watch(const std::filesystem::path& file, callback&& on_change);
+
+		// Calls [on_change] when a file or directory inside [directory] is created, written, deleted or renamed.
+		// With [recursive] the subdirectories are watched as well (except the ones named in [skipped]), directories that are
+		// created later are added. On Linux every directory needs its own inotify watch, and the number of watches per user is
+		// limited (fs.inotify.max_user_watches); on Windows the number of watched directories is limited to MAXIMUM_WAIT_OBJECTS.
+		// If the limit is reached nothing is watched and 0 is returned, the caller has to poll the directory instead.
+		// @param directory The directory to watch, has to exist.
+		// @param on_change Called on the watcher thread, must not call watch() or unwatch() of this watcher.
+		// @param skipped Names of subdirectories that are not watched (ignored on Windows, where a tree is one watch).
+		// @return An id for unwatch(), 0 if the directory could not be watched.
+		u32 watch_directory(const std::filesystem::path& directory, const bool recursive, directory_callback&& on_change, const std::vector<std::string>& skipped = {});
+
+		// Stops watching, [on_change] of this id is not called after this function returned.
+		// @param id The id returned by watch() or watch_directory().
+		void unwatch(const u32 id);
+
+		// Returns true once a watch failed because the system limit of watches was reached.
+		bool is_watch_limit_reached() const									{ return m_watch_limit_reached; }
+
+	private:
+
+		struct watched_file {
+			u32						id = 0;
+			std::filesystem::path	path{};
+			callback				on_change{};
+		};
+
+		struct watched_directory {
+			std::filesystem::path	path{};
+			u32						file_count = 0;
+#if defined(PLATFORM_WINDOWS)
+			std::unordered_map<std::string, std::filesystem::file_time_type>	last_write_times{};		// to find the changed files of a notification
+#elif defined(PLATFORM_LINUX)
+			int						watch_descriptor = -1;
+#endif
+		};
+
+		struct watched_tree {
+			u32						id = 0;
+			std::filesystem::path	directory{};
+			bool					recursive = false;
+			std::vector<std::string>	skipped{};
+			directory_callback		on_change{};
+#if defined(PLATFORM_LINUX)
+			std::vector<int>		descriptors{};		// one per watched directory of the tree
+#endif
+		};
+
+#if defined(PLATFORM_LINUX)
+		// a directory can be part of several trees (e.g. a project that is also a discovery root)
+		struct tree_descriptor {
+			std::filesystem::path	path{};
+			std::vector<u32>		owners{};
+		};
+
+		// expects [m_mutex] to be locked
+		bool add_tree_directory(watched_tree& tree, const std::filesystem::path& directory);
+		bool add_tree_subdirectories(watched_tree& tree, const std::filesystem::path& directory);
+		void remove_tree_descriptors(watched_tree& tree);
+		void handle_tree_event(const struct inotify_event& event);
+#endif
+
+		void run();
+		void add_pending(const std::filesystem::path& file);
+		void add_pending_tree(const u32 id);
+		void postpone_delivery();
+		void deliver_pending();
+		void wake();
+
+		std::chrono::milliseconds				m_debounce;
+		std::mutex								m_mutex{};						// guards the containers, callbacks run under [m_callback_mutex]
+		std::mutex								m_callback_mutex{};				// held while callbacks run, so unwatch() can wait for them
+		std::vector<watched_file>				m_files{};
+		std::vector<watched_directory>			m_directories{};
+		std::vector<watched_tree>				m_trees{};
+		std::vector<std::filesystem::path>		m_pending{};
+		std::vector<u32>						m_pending_trees{};
+		std::chrono::steady_clock::time_point	m_deadline{};
+		std::chrono::steady_clock::time_point	m_latest_deadline{};			// set by the first pending event, limits how long steady events delay delivery
+		std::atomic<bool>						m_running = false;
+		std::atomic<bool>						m_watch_limit_reached = false;
+		u32										m_next_id = 1;
+		std::thread								m_thread{};
+#if defined(PLATFORM_WINDOWS)
+		void*									m_wake_event = nullptr;
+#elif defined(PLATFORM_LINUX)
+		int										m_inotify = -1;
+		int										m_tree_inotify = -1;			// separate instance, so file and tree watches of a directory do not share a descriptor
+		int										m_wake = -1;
+		std::unordered_map<int, tree_descriptor>	m_tree_descriptors{};
+#endif
+	};
+
+}
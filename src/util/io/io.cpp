@@ -7,13 +7,18 @@
 	#include <TlHelp32.h>
 #elif defined(PLATFORM_LINUX)
 	#include <dirent.h>
+	#include <fcntl.h>
 	#include <unistd.h>
+	#include <sys/ioctl.h>
 	#include <sys/types.h>
 	#include <sys/stat.h>
+	#include <linux/fs.h>
 #else
 	#error undefined platform
 #endif
 
+#include "atomic_file_writer.h"
+
 #include "io.h"
 
 
@@ -35,11 +40,9 @@ namespace AT::io {
 	//
 	bool write_file(const std::filesystem::path& file_path, const std::vector<char>& content_buffer) {
 
-		std::ofstream file{ file_path, std::ios::binary };
-		VALIDATE(file.is_open(), return false, "", "Failed to open file for writing at: " << file_path.generic_string());
-
+		atomic_file_writer file(file_path);
 		file.write(content_buffer.data(), content_buffer.size());
-		file.close();
+		VALIDATE(file.commit(), return false, "", "Failed to write file at: " << file_path.generic_string());
 
 		LOG(Trace, "Wrote content to file at [" << file_path.generic_string() << "] with length [" << content_buffer.size() << "]");
 		return true;
@@ -85,6 +88,115 @@ namespace AT::io {
 		}
 	}
 
+#if defined(PLATFORM_LINUX)
+
+	static constexpr size_t COPY_CHUNK_SIZE = 16 * 1024 * 1024;		// in kernel, large chunks only bound the time until [on_progress] is called
+	static constexpr size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+	// reflink first (btrfs, XFS, ...: no data is copied), then copy_file_range (in kernel, server side on NFS/SMB), then read/write
+	// e.g. across file systems on older kernels
+	static bool copy_file_descriptor(const int source_fd, const int target_fd, const u64 size, const copy_progress_callback& on_progress) {
+
+		if (::ioctl(target_fd, FICLONE, source_fd) == 0)
+			return !on_progress || on_progress(size);
+
+		bool in_kernel = true;
+		std::vector<char> buffer{};
+		u64 copied = 0;
+		while (true) {
+
+			ssize_t result = 0;
+			if (in_kernel) {
+
+				result = ::copy_file_range(source_fd, nullptr, target_fd, nullptr, COPY_CHUNK_SIZE, 0);
+				if (result < 0 && copied == 0 && (errno == EXDEV || errno == ENOSYS || errno == EOPNOTSUPP || errno == EINVAL || errno == EPERM)) {
+
+					in_kernel = false;
+					continue;
+				}
+
+			} else {
+
+				if (buffer.empty())
+					buffer.resize(COPY_BUFFER_SIZE);
+
+				result = ::read(source_fd, buffer.data(), buffer.size());
+				for (ssize_t written = 0; result > 0 && written < result; ) {
+
+					const ssize_t count = ::write(target_fd, buffer.data() + written, result - written);
+					if (count < 0 && errno == EINTR)
+						continue;
+
+					VALIDATE(count >= 0, return false, "", "Failed to write: " << std::strerror(errno));
+					written += count;
+				}
+			}
+
+			if (result < 0 && errno == EINTR)
+				continue;
+
+			VALIDATE(result >= 0, return false, "", "Failed to copy: " << std::strerror(errno));
+			if (result == 0)
+				return true;
+
+			copied += static_cast<u64>(result);
+			if (on_progress && !on_progress(copied))
+				return false;
+		}
+	}
+
+#endif
+
+	//
+	bool copy_file_contents(const std::filesystem::path& source, const std::filesystem::path& target, const copy_progress_callback& on_progress) {
+
+#if defined(PLATFORM_WINDOWS)
+
+		// CopyFileEx clones blocks on ReFS by itself and calls the routine after every chunk
+		auto routine = [](LARGE_INTEGER, LARGE_INTEGER transferred, LARGE_INTEGER, LARGE_INTEGER, DWORD, DWORD, HANDLE, HANDLE, LPVOID data) -> DWORD {
+
+			const auto* callback = static_cast<const copy_progress_callback*>(data);
+			return (!*callback || (*callback)(static_cast<u64>(transferred.QuadPart))) ? PROGRESS_CONTINUE : PROGRESS_CANCEL;
+		};
+
+		VALIDATE(CopyFileExW(source.c_str(), target.c_str(), routine, const_cast<copy_progress_callback*>(&on_progress), nullptr, 0), return false, "",
+			"Failed to copy [" << source.generic_string() << "] to [" << target.generic_string() << "] error: " << GetLastError());
+		return true;
+
+#elif defined(PLATFORM_LINUX)
+
+		const int source_fd = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+		VALIDATE(source_fd >= 0, return false, "", "Failed to open [" << source.generic_string() << "]: " << std::strerror(errno));
+
+		struct stat info{};
+		if (::fstat(source_fd, &info) != 0) {
+
+			LOG(Error, "Failed to read [" << source.generic_string() << "]: " << std::strerror(errno));
+			::close(source_fd);
+			return false;
+		}
+
+		const int target_fd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, info.st_mode & 07777);
+		if (target_fd < 0) {
+
+			LOG(Error, "Failed to create [" << target.generic_string() << "]: " << std::strerror(errno));
+			::close(source_fd);
+			return false;
+		}
+
+		const bool copied = copy_file_descriptor(source_fd, target_fd, static_cast<u64>(info.st_size), on_progress);
+		::close(source_fd);
+		const bool closed = ::close(target_fd) == 0;
+		if (copied && closed)
+			return true;
+
+		std::error_code error_code;
+		std::filesystem::remove(target, error_code);
+		return false;
+
+#endif
+	}
+
 	// 
 	bool create_directory(const std::filesystem::path& path) {
 
@@ -8,7 +8,8 @@ namespace AT::io {
 	// @return The file content as a string. Returns an empty string on failure.
 	std::string read_file(const std::filesystem::path& filepath);
 
-	// Writes [content_buffer] to a file, overriding the previous content.
+	// Writes [content_buffer] to a file, overriding the previous content. The file is replaced atomically,
+	// it keeps its previous content if writing fails (see [atomic_file_writer]).
 	// @param file_path The path to the file to be written.
 	// @param content_buffer The vector of characters to be written to the file.
 	// @return true if the file is successfully written, false otherwise.
@@ -20,6 +21,16 @@ namespace AT::io {
 	// @return true if the file is successfully copied (overwriting existing file), false otherwise.
 	bool copy_file(const std::filesystem::path& full_path_to_file, const std::filesystem::path& target_directory);
 
+	// Called while a file is copied with the number of bytes copied so far, copying stops if it returns false.
+	using copy_progress_callback = std::function<bool(u64 copied_bytes)>;
+
+	// Copies the content of [source] to [target] (overwriting it) without blocking for the whole file, so large files can be
+	// reported and cancelled. The file is cloned where the file system supports it (reflink on Linux, block cloning on Windows),
+	// otherwise copied in chunks by the kernel (copy_file_range), with a read/write loop as the last fallback.
+	// @param on_progress Called after every chunk, may be empty.
+	// @return true if the whole file was copied, false on errors or if [on_progress] cancelled (the partial [target] is removed).
+	bool copy_file_contents(const std::filesystem::path& source, const std::filesystem::path& target, const copy_progress_callback& on_progress = {});
+
 	// Creates a directory at the specified path if it doesn't already exist.
 	// @param path The path to the directory to be created.
 	// @return True if the directory is successfully created or already exists; false otherwise.
@@ -0,0 +1,94 @@
+#include "util/pch.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#elif defined(PLATFORM_LINUX)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#else
+	#error undefined platform
+#endif
+
+#include "mapped_file.h"
+
+
+namespace AT::io {
+
+	mapped_file::mapped_file(const std::filesystem::path& filename) {
+
+#if defined(PLATFORM_WINDOWS)
+
+		HANDLE file = CreateFileW(filename.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		VALIDATE(file != INVALID_HANDLE_VALUE, return, "", "Failed to open file for mapping [" << filename.generic_string() << "]");
+		m_file_handle = file;
+
+		LARGE_INTEGER file_size{};
+		VALIDATE(GetFileSizeEx(file, &file_size), return, "", "Failed to get size of [" << filename.generic_string() << "]");
+
+		m_size = static_cast<size_t>(file_size.QuadPart);
+		if (m_size == 0) {								// empty files can not be mapped
+
+			m_valid = true;
+			return;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		VALIDATE(mapping != nullptr, m_size = 0; return, "", "Failed to create file mapping for [" << filename.generic_string() << "]");
+		m_mapping_handle = mapping;
+
+		m_data = static_cast<const u8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		VALIDATE(m_data != nullptr, m_size = 0; return, "", "Failed to map view of [" << filename.generic_string() << "]");
+
+#elif defined(PLATFORM_LINUX)
+
+		const int file = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+		VALIDATE(file >= 0, return, "", "Failed to open file for mapping [" << filename.generic_string() << "]: " << std::strerror(errno));
+
+		struct stat file_status{};
+		if (fstat(file, &file_status) != 0) {
+
+			LOG(Error, "Failed to get size of [" << filename.generic_string() << "]: " << std::strerror(errno));
+			::close(file);
+			return;
+		}
+
+		m_size = static_cast<size_t>(file_status.st_size);
+		if (m_size == 0) {								// empty files can not be mapped
+
+			::close(file);
+			m_valid = true;
+			return;
+		}
+
+		void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+		::close(file);									// the mapping keeps its own reference to the file
+		VALIDATE(data != MAP_FAILED, m_size = 0; return, "", "Failed to map [" << filename.generic_string() << "]: " << std::strerror(errno));
+
+		m_data = static_cast<const u8*>(data);
+#endif
+
+		m_valid = true;
+	}
+
+
+	mapped_file::~mapped_file() {
+
+#if defined(PLATFORM_WINDOWS)
+
+		if (m_data)
+			UnmapViewOfFile(m_data);
+		if (m_mapping_handle)
+			CloseHandle(m_mapping_handle);
+		if (m_file_handle)
+			CloseHandle(m_file_handle);
+
+#elif defined(PLATFORM_LINUX)
+
+		if (m_data)
+			munmap(const_cast<u8*>(m_data), m_size);
+#endif
+	}
+
+}
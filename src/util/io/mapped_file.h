@@ -0,0 +1,36 @@
+#pragma once
+
+
+namespace AT::io {
+
+	// Read-only memory mapping of a whole file. Pages are loaded by the OS on first access, so mapping
+	// a large file costs page faults instead of a full copy. Usually held as [ref<mapped_file>] so views
+	// into the mapping (e.g. spans returned by [serializer::binary]) can outlive the object that created them.
+	class mapped_file {
+	public:
+
+		// Maps [filename] for reading. Failure is logged, check is_valid() before using the data.
+		// @param filename The file to map.
+		mapped_file(const std::filesystem::path& filename);
+		~mapped_file();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(mapped_file);
+
+		// Returns true if the file was mapped (an empty file is valid but has no data).
+		bool is_valid() const									{ return m_valid; }
+
+		// Returns a view of the whole mapped file, empty if the mapping failed.
+		std::span<const u8> get_data() const					{ return std::span<const u8>(m_data, m_size); }
+
+	private:
+
+		const u8*				m_data = nullptr;
+		size_t					m_size = 0;
+		bool					m_valid = false;
+#if defined(PLATFORM_WINDOWS)
+		void*					m_file_handle = nullptr;
+		void*					m_mapping_handle = nullptr;
+#endif
+	};
+
+}
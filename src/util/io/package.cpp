@@ -0,0 +1,477 @@
+
+#include "util/pch.h"
+
+#include <bit>
+
+#include "util/data_structures/thread_pool.h"
+#include "atomic_file_writer.h"
+#include "checksum.h"
+#include "compression.h"
+#include "mapped_file.h"
+
+#include "package.h"
+
+
+namespace AT::io {
+
+	template<typename T>
+	static void append_value(std::vector<u8>& buffer, const T value) {
+
+		auto bytes = std::bit_cast<std::array<u8, sizeof(T)>>(value);
+		if constexpr (std::endian::native != std::endian::little)
+			std::reverse(bytes.begin(), bytes.end());
+		buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+	}
+
+	// reads a little-endian value at [position] and moves it past the value, false if [data] is too short
+	template<typename T>
+	static bool read_value(std::span<const u8> data, size_t& position, T& value) {
+
+		if (sizeof(T) > data.size() - std::min(position, data.size()))
+			return false;
+
+		std::array<u8, sizeof(T)> bytes{};
+		std::memcpy(bytes.data(), data.data() + position, sizeof(T));
+		if constexpr (std::endian::native != std::endian::little)
+			std::reverse(bytes.begin(), bytes.end());
+		value = std::bit_cast<T>(bytes);
+		position += sizeof(T);
+		return true;
+	}
+
+	// relative, no ".." and no empty parts, so an extracted file never ends up outside of the target folder
+	static bool is_safe_name(std::string_view name) {
+
+		if (name.empty() || name.front() == '/' || name.find('\\') != std::string_view::npos || name.find(':') != std::string_view::npos)
+			return false;
+
+		for (size_t start = 0; start <= name.size(); ) {
+
+			size_t end = name.find('/', start);
+			if (end == std::string_view::npos)
+				end = name.size();
+
+			const std::string_view part = name.substr(start, end - start);
+			if (part.empty() || part == "." || part == "..")
+				return false;
+			start = end + 1;
+		}
+		return true;
+	}
+
+	// ------------------------------- writer -------------------------------
+
+	package_writer::package_writer(const std::filesystem::path& target, const u32 thread_count)
+		: m_file(std::make_unique<atomic_file_writer>(target)) {
+
+		m_pool = std::make_unique<util::thread_pool>(thread_count);
+		m_max_pending = static_cast<size_t>(m_pool->get_thread_count()) * 2;		// the next chunks are read while the pool is busy
+
+		std::vector<u8> header{};
+		append_value<u32>(header, MAGIC);
+		append_value<u16>(header, FORMAT_VERSION);
+		append_value<u16>(header, 0);
+		append_value<u32>(header, CHUNK_SIZE);
+		append_value<u32>(header, 0);
+		m_failed = !m_file->write(std::span<const u8>(header));
+	}
+
+
+	package_writer::~package_writer() {
+
+		if (m_pool)
+			m_pool->wait();
+	}
+
+
+	bool package_writer::is_open() const { return !m_failed && !m_finished && m_file->is_open(); }
+
+
+	bool package_writer::add_file(const std::filesystem::path& source, const std::string& name, const copy_progress_callback& on_progress) {
+
+		VALIDATE(is_open(), return false, "", "Can not add [" << name << "], the package is not open");
+
+		std::ifstream stream(source, std::ios::binary);
+		VALIDATE(stream.is_open(), m_failed = true; return false, "", "Failed to open [" << source.generic_string() << "]");
+
+		const u32 index = begin_entry(name);
+		if (m_failed)
+			return false;
+
+		u64 read_bytes = 0;
+		while (true) {
+
+			std::unique_ptr<chunk> next = get_free_chunk();
+			next->source.resize(CHUNK_SIZE);
+			stream.read(reinterpret_cast<char*>(next->source.data()), CHUNK_SIZE);
+			const size_t count = static_cast<size_t>(stream.gcount());
+			VALIDATE(!stream.bad(), m_failed = true; return false, "", "Failed to read [" << source.generic_string() << "]");
+			if (count == 0) {
+
+				m_free_chunks.push_back(std::move(next));
+				break;
+			}
+
+			next->source.resize(count);
+			next->entry = index;
+			if (!submit(std::move(next)))
+				return false;
+
+			read_bytes += count;
+			if (on_progress && !on_progress(read_bytes)) {
+
+				m_failed = true;
+				return false;
+			}
+
+			if (count < CHUNK_SIZE)
+				break;
+		}
+		return true;
+	}
+
+
+	bool package_writer::add_data(std::span<const u8> content, const std::string& name) {
+
+		VALIDATE(is_open(), return false, "", "Can not add [" << name << "], the package is not open");
+
+		const u32 index = begin_entry(name);
+		for (size_t offset = 0; !m_failed && offset < content.size(); offset += CHUNK_SIZE) {
+
+			std::unique_ptr<chunk> next = get_free_chunk();
+			const std::span<const u8> part = content.subspan(offset, std::min<size_t>(CHUNK_SIZE, content.size() - offset));
+			next->source.assign(part.begin(), part.end());
+			next->entry = index;
+			submit(std::move(next));
+		}
+		return !m_failed;
+	}
+
+
+	bool package_writer::finish() {
+
+		VALIDATE(is_open(), return false, "", "The package is not open");
+
+		while (!m_pending.empty())
+			if (!write_front())
+				return false;
+
+		std::vector<u8> index{};
+		append_value<u32>(index, static_cast<u32>(m_entries.size()));
+		for (const auto& entry : m_entries) {
+
+			append_value<u32>(index, static_cast<u32>(entry.name.size()));
+			index.insert(index.end(), entry.name.begin(), entry.name.end());
+			append_value<u64>(index, entry.size);
+			append_value<u32>(index, entry.checksum);
+			append_value<u64>(index, entry.offset);
+			append_value<u32>(index, entry.chunk_count);
+			for (u32 x = 0; x < entry.chunk_count; x++)
+				append_value<u32>(index, m_chunk_sizes[entry.first_chunk + x]);
+		}
+
+		std::vector<u8> trailer{};
+		append_value<u64>(trailer, m_offset);
+		append_value<u64>(trailer, static_cast<u64>(index.size()));
+		append_value<u32>(trailer, crc32c(index));
+		append_value<u32>(trailer, TRAILER_MAGIC);
+
+		m_finished = true;
+		return m_file->write(std::span<const u8>(index)) && m_file->write(std::span<const u8>(trailer)) && m_file->commit();
+	}
+
+
+	u32 package_writer::begin_entry(const std::string& name) {
+
+		VALIDATE(is_safe_name(name), m_failed = true; return 0, "", "[" << name << "] can not be stored in a package, it has to be a relative path");
+
+		entry& added = m_entries.emplace_back();
+		added.name = name;
+		added.first_chunk = m_submitted_chunks;
+		added.offset = m_offset;										// of an empty file, set by write_front() otherwise
+		return static_cast<u32>(m_entries.size() - 1);
+	}
+
+
+	std::unique_ptr<package_writer::chunk> package_writer::get_free_chunk() {
+
+		if (m_free_chunks.empty())
+			return std::make_unique<chunk>();
+
+		std::unique_ptr<chunk> result = std::move(m_free_chunks.back());
+		m_free_chunks.pop_back();
+		result->raw = false;
+		result->done = false;
+		return result;
+	}
+
+
+	bool package_writer::submit(std::unique_ptr<chunk>&& next) {
+
+		// the checksum is computed here, the chunks of a file are read in order
+		entry& file = m_entries[next->entry];
+		file.size += next->source.size();
+		file.checksum = crc32c(next->source, file.checksum);
+		file.chunk_count++;
+		m_submitted_chunks++;
+
+		while (m_pending.size() >= m_max_pending)
+			if (!write_front())
+				return false;
+
+		chunk* pending = next.get();
+		m_pending.push_back(std::move(next));
+		m_pool->push_task([this, pending]() { compress(*pending); });
+		return true;
+	}
+
+
+	// waits for the oldest chunk, chunks are written in the order they were submitted
+	bool package_writer::write_front() {
+
+		std::unique_ptr<chunk> front = std::move(m_pending.front());
+		m_pending.pop_front();
+		{
+			std::unique_lock lock(m_chunk_mutex);
+			m_chunk_done.wait(lock, [&front]() { return front->done; });
+		}
+
+		const std::vector<u8>& data = front->raw ? front->source : front->stored;
+		entry& file = m_entries[front->entry];
+		if (m_chunk_sizes.size() == file.first_chunk)
+			file.offset = m_offset;
+
+		m_chunk_sizes.push_back(static_cast<u32>(data.size()) | (front->raw ? STORED_UNCOMPRESSED : 0));
+		m_offset += data.size();
+		m_failed |= !m_file->write(std::span<const u8>(data));
+		m_free_chunks.push_back(std::move(front));
+		return !m_failed;
+	}
+
+
+	void package_writer::compress(chunk& next) {
+
+		next.stored.clear();
+		next.raw = lz4_compress(next.source, next.stored) >= next.source.size();		// incompressible, stored as is
+		{
+			std::lock_guard lock(m_chunk_mutex);
+			next.done = true;
+		}
+		m_chunk_done.notify_all();
+	}
+
+	// ------------------------------- reader -------------------------------
+
+	package_reader::package_reader(const std::filesystem::path& package)
+		: m_mapping(std::make_unique<mapped_file>(package)), m_filename(package) {
+
+		VALIDATE(m_mapping->is_valid(), return, "", "Failed to open package [" << package.generic_string() << "]");
+		m_valid = parse_index();
+	}
+
+
+	package_reader::~package_reader() {}
+
+
+	std::optional<u32> package_reader::find(std::string_view name) const {
+
+		const auto found = m_lookup.find(std::string(name));
+		if (found == m_lookup.end())
+			return std::nullopt;
+		return found->second;
+	}
+
+
+	bool package_reader::read(const u32 index, std::vector<u8>& content) const {
+
+		VALIDATE(m_valid && index < m_entries.size(), return false, "", "File [" << index << "] is not in package [" << m_filename.generic_string() << "]");
+
+		const entry& file = m_entries[index];
+		content.resize(static_cast<size_t>(file.size));
+		u64 offset = file.offset;
+		for (u32 x = 0; x < file.chunk_count; x++) {
+
+			const size_t position = static_cast<size_t>(x) * m_chunk_size;
+			const std::span<u8> destination = std::span<u8>(content).subspan(position, std::min<size_t>(m_chunk_size, content.size() - position));
+			if (!read_chunk(file.first_chunk + x, offset, destination))
+				return false;
+			offset += m_chunk_sizes[file.first_chunk + x] & ~package_writer::STORED_UNCOMPRESSED;
+		}
+
+		VALIDATE(crc32c(content) == file.checksum, return false, "", "Checksum mismatch of [" << file.name << "] in package [" << m_filename.generic_string() << "], the package is corrupted");
+		return true;
+	}
+
+
+	bool package_reader::extract(const u32 index, const std::filesystem::path& target, const copy_progress_callback& on_progress) const {
+
+		VALIDATE(m_valid && index < m_entries.size(), return false, "", "File [" << index << "] is not in package [" << m_filename.generic_string() << "]");
+
+		const entry& file = m_entries[index];
+		std::ofstream stream(target, std::ios::binary | std::ios::trunc);
+		VALIDATE(stream.is_open(), return false, "", "Failed to create [" << target.generic_string() << "]");
+
+		std::vector<u8> buffer(static_cast<size_t>(std::min<u64>(m_chunk_size, file.size)));
+		u64 offset = file.offset;
+		u64 written = 0;
+		u32 checksum = 0;
+		bool valid = true;
+		for (u32 x = 0; valid && x < file.chunk_count; x++) {
+
+			const std::span<u8> destination = std::span<u8>(buffer).first(static_cast<size_t>(std::min<u64>(m_chunk_size, file.size - written)));
+			valid = read_chunk(file.first_chunk + x, offset, destination);
+			if (!valid)
+				break;
+
+			checksum = crc32c(destination, checksum);
+			stream.write(reinterpret_cast<const char*>(destination.data()), static_cast<std::streamsize>(destination.size()));
+			offset += m_chunk_sizes[file.first_chunk + x] & ~package_writer::STORED_UNCOMPRESSED;
+			written += destination.size();
+			valid = stream.good() && (!on_progress || on_progress(written));
+		}
+
+		stream.close();
+		if (valid && checksum != file.checksum) {
+
+			LOG(Error, "Checksum mismatch of [" << file.name << "] in package [" << m_filename.generic_string() << "], the package is corrupted");
+			valid = false;
+		}
+
+		if (!valid) {
+
+			std::error_code error_code;
+			std::filesystem::remove(target, error_code);
+		}
+		return valid;
+	}
+
+
+	bool package_reader::extract(std::span<const u32> indices, const std::filesystem::path& directory, const u32 thread_count, const copy_progress_callback& on_progress) const {
+
+		VALIDATE(m_valid, return false, "", "Package [" << m_filename.generic_string() << "] is not valid");
+
+		// folders first, so the threads never race on creating the same parent
+		std::error_code error_code;
+		std::unordered_set<std::string> folders{};
+		for (const u32 index : indices) {
+
+			VALIDATE(index < m_entries.size(), return false, "", "File [" << index << "] is not in package [" << m_filename.generic_string() << "]");
+			const size_t separator = m_entries[index].name.rfind('/');
+			if (separator != std::string::npos && folders.insert(m_entries[index].name.substr(0, separator)).second)
+				std::filesystem::create_directories(directory / m_entries[index].name.substr(0, separator), error_code);
+		}
+		std::filesystem::create_directories(directory, error_code);
+
+		std::atomic<u64> written_bytes = 0;
+		std::atomic<bool> valid = true;
+		{
+			util::thread_pool pool(static_cast<u32>(std::min<size_t>(std::max<size_t>(indices.size(), 1), thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency()))));
+			for (const u32 index : indices) {
+
+				pool.push_task([&, index]() {
+
+					if (!valid.load(std::memory_order_relaxed))
+						return;
+
+					u64 reported = 0;
+					const bool extracted = extract(index, directory / m_entries[index].name, [&](const u64 file_bytes) {
+
+						const u64 total = written_bytes.fetch_add(file_bytes - reported, std::memory_order_relaxed) + file_bytes - reported;
+						reported = file_bytes;
+						return !on_progress || on_progress(total);
+					});
+
+					if (!extracted)
+						valid.store(false, std::memory_order_relaxed);
+				});
+			}
+			pool.wait();
+		}
+		return valid.load();
+	}
+
+
+	bool package_reader::parse_index() {
+
+		const std::span<const u8> file = m_mapping->get_data();
+		VALIDATE(file.size() >= package_writer::HEADER_SIZE + package_writer::TRAILER_SIZE, return false, "", "[" << m_filename.generic_string() << "] is not a package");
+
+		size_t position = 0;
+		u32 magic = 0, chunk_size = 0;
+		u16 version = 0;
+		read_value(file, position, magic);
+		read_value(file, position, version);
+		position += sizeof(u16);
+		read_value(file, position, chunk_size);
+		VALIDATE(magic == package_writer::MAGIC, return false, "", "[" << m_filename.generic_string() << "] is not a package");
+		VALIDATE(version <= package_writer::FORMAT_VERSION, return false, "", "Package [" << m_filename.generic_string() << "] has the unknown version [" << version << "]");
+		VALIDATE(chunk_size > 0 && chunk_size < package_writer::STORED_UNCOMPRESSED, return false, "", "Corrupted chunk size in package [" << m_filename.generic_string() << "]");
+		m_chunk_size = chunk_size;
+
+		u64 index_offset = 0, index_size = 0;
+		u32 index_checksum = 0, trailer_magic = 0;
+		position = file.size() - package_writer::TRAILER_SIZE;
+		read_value(file, position, index_offset);
+		read_value(file, position, index_size);
+		read_value(file, position, index_checksum);
+		read_value(file, position, trailer_magic);
+		VALIDATE(trailer_magic == package_writer::TRAILER_MAGIC && index_offset >= package_writer::HEADER_SIZE && index_offset <= file.size() - package_writer::TRAILER_SIZE
+			&& index_size == file.size() - package_writer::TRAILER_SIZE - index_offset, return false, "", "Package [" << m_filename.generic_string() << "] is incomplete or corrupted");
+
+		const std::span<const u8> index = file.subspan(static_cast<size_t>(index_offset), static_cast<size_t>(index_size));
+		VALIDATE(crc32c(index) == index_checksum, return false, "", "Checksum mismatch in the index of package [" << m_filename.generic_string() << "], the package is corrupted");
+
+		// every value is checked against the index, a corrupted index can not cause reads outside of the file
+		position = 0;
+		u32 file_count = 0;
+		VALIDATE(read_value(index, position, file_count) && file_count <= index.size() / 28, return false, "", "Corrupted file count in package [" << m_filename.generic_string() << "]");
+		m_entries.resize(file_count);
+		for (u32 x = 0; x < file_count; x++) {
+
+			entry& current = m_entries[x];
+			u32 name_length = 0;
+			VALIDATE(read_value(index, position, name_length) && name_length <= index.size() - position, return false, "", "Corrupted index in package [" << m_filename.generic_string() << "]");
+			current.name.assign(reinterpret_cast<const char*>(index.data() + position), name_length);
+			position += name_length;
+
+			// the index is not trusted (the checksum does not protect against a crafted package), every sum is checked for overflow
+			VALIDATE(read_value(index, position, current.size) && read_value(index, position, current.checksum) && read_value(index, position, current.offset) && read_value(index, position, current.chunk_count)
+				&& current.chunk_count <= (index.size() - position) / sizeof(u32) && current.size <= static_cast<u64>(current.chunk_count) * m_chunk_size
+				&& current.chunk_count == (current.size + m_chunk_size - 1) / m_chunk_size, return false, "", "Corrupted index in package [" << m_filename.generic_string() << "]");
+			VALIDATE(current.offset >= package_writer::HEADER_SIZE && current.offset <= index_offset, return false, "", "[" << current.name << "] is outside of the chunks of package [" << m_filename.generic_string() << "]");
+			VALIDATE(is_safe_name(current.name), return false, "", "Package [" << m_filename.generic_string() << "] contains the unsafe name [" << current.name << "]");
+
+			current.first_chunk = static_cast<u32>(m_chunk_sizes.size());
+			u64 end = current.offset;
+			for (u32 y = 0; y < current.chunk_count; y++) {
+
+				u32 stored_size = 0;
+				read_value(index, position, stored_size);
+				const u32 stored = stored_size & ~package_writer::STORED_UNCOMPRESSED;
+				VALIDATE(stored <= index_offset - end, return false, "", "[" << current.name << "] is outside of the chunks of package [" << m_filename.generic_string() << "]");
+				m_chunk_sizes.push_back(stored_size);
+				end += stored;
+			}
+
+			m_lookup.emplace(current.name, x);
+		}
+		return true;
+	}
+
+
+	bool package_reader::read_chunk(const u32 chunk, const u64 offset, std::span<u8> destination) const {
+
+		const u32 stored_size = m_chunk_sizes[chunk];
+		const std::span<const u8> stored = m_mapping->get_data().subspan(static_cast<size_t>(offset), stored_size & ~package_writer::STORED_UNCOMPRESSED);
+		if (stored_size & package_writer::STORED_UNCOMPRESSED) {
+
+			VALIDATE(stored.size() == destination.size(), return false, "", "Corrupted chunk [" << chunk << "] in package [" << m_filename.generic_string() << "]");
+			std::memcpy(destination.data(), stored.data(), stored.size());
+			return true;
+		}
+
+		VALIDATE(lz4_decompress(stored, destination), return false, "", "Corrupted chunk [" << chunk << "] in package [" << m_filename.generic_string() << "]");
+		return true;
+	}
+
+}
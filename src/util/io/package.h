@@ -0,0 +1,166 @@
+#pragma once
+
+#include "io.h"
+
+namespace AT::util { class thread_pool; }
+
+namespace AT::io {
+
+	class atomic_file_writer;
+	class mapped_file;
+
+	// Files of a folder tree in a single package file, written as a stream and read with random access.
+	// The content of every file is split into chunks of [CHUNK_SIZE] bytes that are compressed independently (LZ4 block
+	// format, see [io::lz4_compress]) on a thread pool, while the next chunks are read. The index of all files is written
+	// last, so a package of any size is written with a few chunks in memory, and a reader only touches the chunks of the
+	// files it extracts.
+	//
+	// File layout (all values little-endian):
+	//   header     u32 magic "ATPK", u16 format version, u16 flags (unused), u32 chunk size, u32 reserved
+	//   chunks     the chunks of every file, in the order of the index
+	//   index      u32 file count, per file: u32 name length, name, u64 size, u32 CRC32C of the content, u64 offset of the
+	//              first chunk, u32 chunk count, per chunk: u32 stored size
+	//   trailer    u64 offset of the index, u64 size of the index, u32 CRC32C of the index, u32 magic "ATPE"
+	// The highest bit of a stored size marks a chunk that did not compress and is stored as is. Names are relative paths
+	// with '/' separators.
+
+	// Writes a package, it replaces the target once finish() succeeded (see [io::atomic_file_writer]).
+	//
+	//   io::package_writer writer(package_file);
+	//   writer.add_file(source, "folder/file.txt");
+	//   if (!writer.finish()) { ... }
+	class package_writer {
+	public:
+
+		static constexpr u32 MAGIC = 0x4B505441;						// "ATPK" as stored in the file
+		static constexpr u32 TRAILER_MAGIC = 0x45505441;				// "ATPE"
+		static constexpr u16 FORMAT_VERSION = 1;
+		static constexpr size_t HEADER_SIZE = 16;
+		static constexpr size_t TRAILER_SIZE = 24;
+		static constexpr u32 CHUNK_SIZE = 256 * 1024;
+		static constexpr u32 STORED_UNCOMPRESSED = 1u << 31;			// chunk size flag
+
+		// @param target The package file that is replaced by finish().
+		// @param thread_count Threads that compress chunks, 0 uses std::thread::hardware_concurrency().
+		package_writer(const std::filesystem::path& target, const u32 thread_count = 0);
+
+		// Waits for the running compressions, the package is discarded if finish() was not called.
+		~package_writer();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(package_writer);
+
+		// Returns true while every write succeeded and finish() was not called yet.
+		bool is_open() const;
+
+		// Streams [source] into the package as [name]. Chunks of small files are compressed in parallel with the chunks
+		// of the files added after them, so a tree of many small files uses all threads as well.
+		// @param on_progress Called after every chunk with the bytes of [source] read so far, may be empty.
+		// @return false if [source] could not be read or [on_progress] cancelled, the package can not be finished then.
+		bool add_file(const std::filesystem::path& source, const std::string& name, const copy_progress_callback& on_progress = {});
+
+		// Adds [content] as [name], like add_file().
+		bool add_data(std::span<const u8> content, const std::string& name);
+
+		// Writes the remaining chunks, the index and the trailer and replaces the target.
+		// @return true if the target is the complete package.
+		bool finish();
+
+		u32 get_file_count() const										{ return static_cast<u32>(m_entries.size()); }
+
+	private:
+
+		struct chunk {
+			std::vector<u8>			source{};
+			std::vector<u8>			stored{};					// compressed [source], unused if [raw]
+			u32						entry = 0;
+			bool					raw = false;
+			bool					done = false;				// guarded by [m_chunk_mutex]
+		};
+
+		struct entry {
+			std::string				name{};
+			u64						size = 0;
+			u32						checksum = 0;
+			u64						offset = 0;
+			u32						first_chunk = 0;			// into [m_chunk_sizes]
+			u32						chunk_count = 0;
+		};
+
+		u32 begin_entry(const std::string& name);
+		std::unique_ptr<chunk> get_free_chunk();
+		bool submit(std::unique_ptr<chunk>&& next);
+		bool write_front();
+		void compress(chunk& next);
+
+		std::unique_ptr<atomic_file_writer>			m_file{};
+		std::vector<entry>							m_entries{};
+		std::vector<u32>							m_chunk_sizes{};				// stored size of every written chunk, in file order
+		u32											m_submitted_chunks = 0;
+		u64											m_offset = HEADER_SIZE;		// end of the written chunks
+		std::deque<std::unique_ptr<chunk>>			m_pending{};					// submitted, in file order
+		std::vector<std::unique_ptr<chunk>>			m_free_chunks{};				// written, their buffers are reused
+		size_t										m_max_pending = 0;
+		std::mutex									m_chunk_mutex{};
+		std::condition_variable						m_chunk_done{};
+		std::unique_ptr<util::thread_pool>			m_pool{};						// declared after the chunks, its tasks finish before they are destroyed
+		bool										m_failed = false;
+		bool										m_finished = false;
+	};
+
+
+	// Reads a package written by [package_writer]. The file is memory mapped and only the index is parsed on construction,
+	// the chunks of a file are read when it is extracted.
+	class package_reader {
+	public:
+
+		struct entry {
+			std::string				name{};
+			u64						size = 0;
+			u32						checksum = 0;				// CRC32C of the content
+			u64						offset = 0;					// of the first chunk
+			u32						first_chunk = 0;			// into the chunk table
+			u32						chunk_count = 0;
+		};
+
+		// Maps [package] and reads its index. Failure is logged, check is_valid().
+		explicit package_reader(const std::filesystem::path& package);
+		~package_reader();
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(package_reader);
+
+		bool is_valid() const											{ return m_valid; }
+
+		const std::vector<entry>& get_entries() const					{ return m_entries; }
+
+		// @return The index of the file [name] in get_entries(), or std::nullopt if it is not in the package.
+		std::optional<u32> find(std::string_view name) const;
+
+		// Decompresses the file at [index] into [content] and verifies its checksum.
+		// @return false if the package is corrupted.
+		bool read(const u32 index, std::vector<u8>& content) const;
+
+		// Writes the file at [index] to [target] (overwriting it), chunk by chunk.
+		// @param on_progress Called after every chunk with the bytes written so far, may be empty.
+		// @return false on errors, a corrupted file or if [on_progress] cancelled (the partial [target] is removed).
+		bool extract(const u32 index, const std::filesystem::path& target, const copy_progress_callback& on_progress = {}) const;
+
+		// Extracts the files at [indices] to [directory] / their name on several threads, creating folders as needed.
+		// @param on_progress Called on the extracting threads with the bytes of all files written so far, may be empty.
+		// @return true if every file was extracted.
+		bool extract(std::span<const u32> indices, const std::filesystem::path& directory, const u32 thread_count = 0, const copy_progress_callback& on_progress = {}) const;
+
+	private:
+
+		bool parse_index();
+		bool read_chunk(const u32 chunk, const u64 offset, std::span<u8> destination) const;
+
+		std::unique_ptr<mapped_file>				m_mapping{};
+		std::filesystem::path						m_filename{};
+		std::vector<entry>							m_entries{};
+		std::vector<u32>							m_chunk_sizes{};
+		std::unordered_map<std::string, u32>		m_lookup{};						// [entry::name] => index
+		u32											m_chunk_size = 0;
+		bool										m_valid = false;
+	};
+
+}
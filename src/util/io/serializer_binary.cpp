@@ -1,38 +1,540 @@
 
 #include "util/pch.h"
 
+#include "util/data_structures/thread_pool.h"
+#include "atomic_file_writer.h"
+#include "checksum.h"
+#include "compression.h"
+
 #include "serializer_binary.h"
 
 namespace AT::serializer {
 
-	binary::binary(const std::filesystem::path filename, const std::string& section_name, option option) 
-	: m_filename(filename), m_name(section_name), m_option(option) {
+	binary::binary(const std::filesystem::path filename, const std::string& section_name, option option, load_mode mode)
+	: m_filename(filename), m_name(section_name), m_option(option), m_load_mode(mode) {
+
+		if (m_option == option::save_to_file)
+			m_buffer.reserve(64 * 1024);
+		else
+			m_valid = (m_load_mode == load_mode::memory_mapped) ? map_section() : load_section();
+	}
+
+	binary::binary(const binary& parent, std::span<const u8> block)
+	: m_filename(parent.m_filename), m_name(parent.m_name), m_option(option::load_from_file), m_load_mode(parent.m_load_mode), m_mapping(parent.m_mapping), m_section(block) {}
+
+	binary::~binary() {
+
+		if (m_option == option::save_to_file)
+			save_section();
+	}
+
+
+	void binary::write_bytes(const void* data, const size_t size) {
+
+		if (size == 0)
+			return;
+
+		const size_t offset = m_buffer.size();
+		m_buffer.resize(offset + size);
+		std::memcpy(m_buffer.data() + offset, data, size);
+	}
+
+	bool binary::read_bytes(void* data, const size_t size) {
+
+		if (!m_valid)
+			return false;
+
+		VALIDATE(size <= remaining_bytes(), fail(); return false, "", "Tried to read [" << size << "] bytes with only [" << remaining_bytes() << "] left in section [" << m_name << "] of [" << m_filename.generic_string() << "]");
+
+		if (size > 0)
+			std::memcpy(data, m_section.data() + m_read_position, size);
+		m_read_position += size;
+		return true;
+	}
+
+	void binary::fail() {
+
+		m_valid = false;
+		m_read_position = m_section.size();
+	}
+
+
+	binary& binary::skip_vector() {
+
+		VALIDATE(m_option == option::load_from_file, return *this, "", "skip_vector() can only be used when loading");
+
+		vector_blocks layout{};
+		read_vector_blocks(layout);
+		return *this;
+	}
+
+
+	void binary::save_vector_blocks(const u64 element_count, const std::function<void(binary&, const u64)>& element_function) {
+
+		write_value<u64>(element_count);
+		write_value<u32>(VECTOR_BLOCK_SIZE);
+		for (u64 first = 0; first < element_count; first += VECTOR_BLOCK_SIZE) {
+
+			// reserve the length prefix and fill it in once the block is written
+			const size_t length_position = m_buffer.size();
+			write_value<u64>(0);
+
+			const u64 last = std::min<u64>(first + VECTOR_BLOCK_SIZE, element_count);
+			for (u64 x = first; x < last; x++)
+				element_function(*this, x);
+
+			const u64 block_length = to_little_endian(static_cast<u64>(m_buffer.size() - length_position - sizeof(u64)));
+			std::memcpy(m_buffer.data() + length_position, &block_length, sizeof(block_length));
+		}
+	}
+
+
+	bool binary::read_vector_blocks(vector_blocks& layout) {
+
+		if (!read_value<u64>(layout.element_count) || !read_value<u32>(layout.block_size))
+			return false;
+
+		VALIDATE(layout.block_size > 0 && layout.block_size <= MAX_VECTOR_BLOCK_SIZE, fail(); return false, "", "Corrupted vector block size [" << layout.block_size << "] in section [" << m_name << "]");
+
+		// every block needs at least its length prefix
+		const u64 block_count = layout.element_count / layout.block_size + (layout.element_count % layout.block_size != 0);
+		VALIDATE(block_count <= remaining_bytes() / sizeof(u64), fail(); return false, "", "Corrupted vector size [" << layout.element_count << "] in section [" << m_name << "]");
+
+		layout.blocks.clear();
+		layout.blocks.reserve(static_cast<size_t>(block_count));
+		for (u64 x = 0; x < block_count; x++) {
 
-		// ASSERT(std::filesystem::is_regular_file(filename), "", "Provided filepath is not a file [" << filename.generic_string() << "]");
-		if (m_option == option::save_to_file) {
+			u64 block_length = 0;
+			if (!read_value<u64>(block_length))
+				return false;
 
-			m_ostream = std::ofstream(m_filename, std::ios::out | std::ios::binary | std::ios::trunc);
-			VALIDATE(m_ostream, return, "", "Failed to save to file: [" << m_filename << "]");
+			VALIDATE(block_length <= remaining_bytes(), fail(); return false, "", "Corrupted vector block length [" << block_length << "] in section [" << m_name << "]");
+
+			layout.blocks.push_back(m_section.subspan(m_read_position, static_cast<size_t>(block_length)));
+			m_read_position += static_cast<size_t>(block_length);
+		}
+		return true;
+	}
+
+
+	void binary::load_vector_blocks(const vector_blocks& layout, const std::function<void(binary&, const u64)>& element_function, const u32 max_threads) {
+
+		std::atomic<bool> valid = true;
+		auto load_block = [&](const size_t block_index) {
+
+			binary block_reader(*this, layout.blocks[block_index]);
+			const u64 first = static_cast<u64>(block_index) * layout.block_size;
+			const u64 last = std::min<u64>(first + layout.block_size, layout.element_count);
+			for (u64 x = first; x < last && block_reader.is_valid(); x++)
+				element_function(block_reader, x);
+
+			if (!block_reader.is_valid())
+				valid = false;
+			else if (block_reader.remaining_bytes() != 0)
+				LOG(Warn, "Element callbacks left [" << block_reader.remaining_bytes() << "] bytes of block [" << block_index << "] unread in section [" << m_name << "]");
+		};
+
+		if (max_threads <= 1 || layout.blocks.size() <= 1) {
+
+			for (size_t x = 0; x < layout.blocks.size(); x++)
+				load_block(x);
 
 		} else {
 
-			m_istream = std::ifstream(m_filename, std::ios::in | std::ios::binary);
-			VALIDATE(m_istream, return, "", "Failed to load file: [" << m_filename << "]");
+			util::thread_pool pool(static_cast<u32>(std::min<size_t>(layout.blocks.size(), max_threads)));
+			for (size_t x = 0; x < layout.blocks.size(); x++)
+				pool.push_task([&load_block, x]() { load_block(x); });
 
+			pool.wait();
 		}
 
+		if (!valid)
+			m_valid = false;
 	}
 
-	binary::~binary() {
 
-		if (m_option == option::save_to_file) {
+	bool binary::read_section_table(std::istream& stream, std::vector<section_entry>& sections) {
+
+		std::vector<u8> file(HEADER_SIZE);
+		if (!stream.read(reinterpret_cast<char*>(file.data()), HEADER_SIZE))
+			return false;
+
+		u64 table_size = 0;
+		std::memcpy(&table_size, file.data() + 8, sizeof(table_size));
+		table_size = to_little_endian(table_size);
+		VALIDATE(table_size <= 16 * 1024 * 1024, return false, "", "Corrupted section table size [" << table_size << "]");
+
+		file.resize(HEADER_SIZE + static_cast<size_t>(table_size));
+		if (!stream.read(reinterpret_cast<char*>(file.data() + HEADER_SIZE), static_cast<std::streamsize>(table_size)))
+			return false;
+
+		return parse_section_table(file, sections);
+	}
+
+
+	bool binary::parse_section_table(std::span<const u8> file, std::vector<section_entry>& sections) {
+
+		if (file.size() < HEADER_SIZE)
+			return false;
+
+		u32 magic = 0;
+		u16 version = 0, section_count = 0;
+		u64 table_size = 0;
+		std::memcpy(&magic, file.data(), sizeof(magic));
+		std::memcpy(&version, file.data() + 4, sizeof(version));
+		std::memcpy(&section_count, file.data() + 6, sizeof(section_count));
+		std::memcpy(&table_size, file.data() + 8, sizeof(table_size));
+		VALIDATE(to_little_endian(magic) == MAGIC, return false, "", "File is not a binary serializer file (wrong magic number)");
+		version = to_little_endian(version);
+		VALIDATE(version >= 1 && version <= FORMAT_VERSION, return false, "", "Unsupported binary format version [" << version << "], expected [" << FORMAT_VERSION << "] or older");
+
+		table_size = to_little_endian(table_size);
+		VALIDATE(table_size <= file.size() - HEADER_SIZE, return false, "", "Corrupted section table size [" << table_size << "]");
+		const std::span<const u8> table = file.subspan(HEADER_SIZE, static_cast<size_t>(table_size));
+
+		size_t position = 0;
+		auto read = [&](void* destination, const size_t size) {
+
+			if (position > table.size() || size > table.size() - position)
+				return false;
+
+			std::memcpy(destination, table.data() + position, size);
+			position += size;
+			return true;
+		};
+
+		sections.clear();
+		for (u16 x = 0; x < to_little_endian(section_count); x++) {
+
+			section_entry section{};
+			u32 name_length = 0;
+			if (!read(&section.offset, sizeof(u64)) || !read(&section.size, sizeof(u64)))
+				return false;
+
+			if (version >= 2 && !read(&section.flags, sizeof(u32)))
+				return false;
+
+			if (version >= 3 && !read(&section.checksum, sizeof(u32)))
+				return false;
+
+			if (!read(&name_length, sizeof(u32)))
+				return false;
+
+			section.offset = to_little_endian(section.offset);
+			section.size = to_little_endian(section.size);
+			section.flags = to_little_endian(section.flags);
+			section.checksum = to_little_endian(section.checksum);
+			name_length = to_little_endian(name_length);
+			VALIDATE(name_length <= table.size(), return false, "", "Corrupted section name length [" << name_length << "]");
+			section.name.resize(name_length);
+			if (!read(section.name.data(), name_length))
+				return false;
+
+			position = align_up(position, 8);
+			sections.push_back(std::move(section));
+		}
+		return true;
+	}
+
+
+	bool binary::load_section() {
+
+		std::ifstream stream(m_filename, std::ios::in | std::ios::binary);
+		VALIDATE(stream.is_open(), return false, "", "Failed to load file: [" << m_filename << "]");
+
+		std::vector<section_entry> sections{};
+		VALIDATE(read_section_table(stream, sections), return false, "", "Failed to read section table of [" << m_filename.generic_string() << "]");
+
+		const auto section = std::find_if(sections.begin(), sections.end(), [this](const section_entry& entry) { return entry.name == m_name; });
+		VALIDATE(section != sections.end(), return false, "", "Section [" << m_name << "] not found in [" << m_filename.generic_string() << "]");
+
+		std::error_code error_code;
+		const u64 file_size = static_cast<u64>(std::filesystem::file_size(m_filename, error_code));
+		VALIDATE(!error_code && section->offset <= file_size && section->size <= file_size - section->offset, return false,
+			"", "Section [" << m_name << "] of [" << m_filename.generic_string() << "] is outside of the file");
+
+		m_buffer.resize(static_cast<size_t>(section->size));
+		stream.seekg(static_cast<std::streamoff>(section->offset));
+		VALIDATE(stream.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size())), m_buffer.clear(); return false,
+			"", "Section [" << m_name << "] of [" << m_filename.generic_string() << "] is truncated");
 
-			m_ostream.close();
+		VALIDATE(!(section->flags & SECTION_CHECKSUM) || io::crc32c(m_buffer) == section->checksum, m_buffer.clear(); return false,
+			"", "Checksum mismatch in section [" << m_name << "] of [" << m_filename.generic_string() << "], the file is corrupted");
+
+		if (section->flags & SECTION_COMPRESSED) {
+
+			const std::vector<u8> payload = std::move(m_buffer);
+			m_buffer = {};
+			return decompress_section(payload);
+		}
+
+		m_section = m_buffer;
+		return true;
+	}
+
+
+	bool binary::map_section() {
+
+		m_mapping = create_ref<io::mapped_file>(m_filename);
+		VALIDATE(m_mapping->is_valid(), m_mapping.reset(); return false, "", "Failed to load file: [" << m_filename << "]");
+
+		const std::span<const u8> file = m_mapping->get_data();
+		std::vector<section_entry> sections{};
+		VALIDATE(parse_section_table(file, sections), return false, "", "Failed to read section table of [" << m_filename.generic_string() << "]");
+
+		const auto section = std::find_if(sections.begin(), sections.end(), [this](const section_entry& entry) { return entry.name == m_name; });
+		VALIDATE(section != sections.end(), return false, "", "Section [" << m_name << "] not found in [" << m_filename.generic_string() << "]");
+		VALIDATE(section->offset <= file.size() && section->size <= file.size() - section->offset, return false,
+			"", "Section [" << m_name << "] of [" << m_filename.generic_string() << "] is outside of the file");
+
+		const std::span<const u8> payload = file.subspan(static_cast<size_t>(section->offset), static_cast<size_t>(section->size));
+		VALIDATE(!(section->flags & SECTION_CHECKSUM) || io::crc32c(payload) == section->checksum, return false,
+			"", "Checksum mismatch in section [" << m_name << "] of [" << m_filename.generic_string() << "], the file is corrupted");
+
+		if (section->flags & SECTION_COMPRESSED)
+			return decompress_section(payload);
+
+		m_section = payload;
+		return true;
+	}
+
+
+	std::vector<u8> binary::compress_section(std::span<const u8> payload) {
+
+		const size_t block_count = (payload.size() + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		std::vector<std::vector<u8>> blocks(block_count);
+		std::vector<u8> stored_raw(block_count, 0);
+		auto compress_block = [&](const size_t index) {
+
+			const auto source = payload.subspan(index * COMPRESSION_BLOCK_SIZE, std::min<size_t>(COMPRESSION_BLOCK_SIZE, payload.size() - index * COMPRESSION_BLOCK_SIZE));
+			if (io::lz4_compress(source, blocks[index]) >= source.size()) {
+
+				blocks[index].assign(source.begin(), source.end());			// incompressible, stored as is
+				stored_raw[index] = 1;
+			}
+		};
+
+		if (block_count < 4) {
+
+			for (size_t x = 0; x < block_count; x++)
+				compress_block(x);
 
 		} else {
 
-			m_istream.close();
+			util::thread_pool pool(static_cast<u32>(std::min<size_t>(block_count, std::max(1u, std::thread::hardware_concurrency()))));
+			for (size_t x = 0; x < block_count; x++)
+				pool.push_task([&compress_block, x]() { compress_block(x); });
+
+			pool.wait();
+		}
+
+		std::vector<u8> result{};
+		auto append = [&result](const auto value) {
+
+			const auto stored = to_little_endian(value);
+			const auto* bytes = reinterpret_cast<const u8*>(&stored);
+			result.insert(result.end(), bytes, bytes + sizeof(stored));
+		};
+
+		append(static_cast<u64>(payload.size()));
+		append(COMPRESSION_BLOCK_SIZE);
+		append(static_cast<u32>(block_count));
+		for (size_t x = 0; x < block_count; x++)
+			append(static_cast<u32>(blocks[x].size()) | (stored_raw[x] ? STORED_UNCOMPRESSED : 0u));
+
+		for (const auto& block : blocks)
+			result.insert(result.end(), block.begin(), block.end());
+
+		return result;
+	}
+
+
+	bool binary::decompress_section(std::span<const u8> payload) {
+
+		u64 uncompressed_size = 0;
+		u32 block_size = 0, block_count = 0;
+		VALIDATE(payload.size() >= sizeof(u64) + 2 * sizeof(u32), return false, "", "Compressed section [" << m_name << "] of [" << m_filename.generic_string() << "] is truncated");
+		std::memcpy(&uncompressed_size, payload.data(), sizeof(u64));
+		std::memcpy(&block_size, payload.data() + 8, sizeof(u32));
+		std::memcpy(&block_count, payload.data() + 12, sizeof(u32));
+		uncompressed_size = to_little_endian(uncompressed_size);
+		block_size = to_little_endian(block_size);
+		block_count = to_little_endian(block_count);
+		payload = payload.subspan(16);
+
+		// an LZ4 block expands at most ~255 times, larger sizes can only come from a corrupted file
+		VALIDATE(block_size > 0 && block_size <= 64 * 1024 * 1024 && block_count <= payload.size() / sizeof(u32)
+			&& static_cast<u64>(block_count) * block_size >= uncompressed_size && uncompressed_size + block_size > static_cast<u64>(block_count) * block_size
+			&& uncompressed_size / 255 <= payload.size(), return false,
+			"", "Corrupted compression header in section [" << m_name << "] of [" << m_filename.generic_string() << "]");
+
+		// block offsets are known up front, so every block can be decompressed on its own
+		std::vector<std::span<const u8>> blocks(block_count);
+		size_t offset = block_count * sizeof(u32);
+		std::vector<u8> stored_raw(block_count, 0);
+		for (u32 x = 0; x < block_count; x++) {
+
+			u32 stored_size = 0;
+			std::memcpy(&stored_size, payload.data() + x * sizeof(u32), sizeof(u32));
+			stored_size = to_little_endian(stored_size);
+			stored_raw[x] = (stored_size & STORED_UNCOMPRESSED) != 0 ? 1 : 0;
+			stored_size &= ~STORED_UNCOMPRESSED;
+
+			VALIDATE(stored_size <= payload.size() - offset, return false, "", "Compressed block [" << x << "] of section [" << m_name << "] is outside of the section");
+			blocks[x] = payload.subspan(offset, stored_size);
+			offset += stored_size;
 		}
+
+		m_buffer.resize(static_cast<size_t>(uncompressed_size));
+		std::atomic<bool> valid = true;
+		auto decompress_block = [&](const size_t index) {
+
+			const std::span<u8> destination = std::span<u8>(m_buffer).subspan(index * block_size, std::min<size_t>(block_size, m_buffer.size() - index * block_size));
+			if (stored_raw[index]) {
+
+				if (blocks[index].size() == destination.size())
+					std::memcpy(destination.data(), blocks[index].data(), destination.size());
+				else
+					valid = false;
+
+			} else if (!io::lz4_decompress(blocks[index], destination))
+				valid = false;
+		};
+
+		if (block_count < 4) {
+
+			for (size_t x = 0; x < block_count; x++)
+				decompress_block(x);
+
+		} else {
+
+			util::thread_pool pool(static_cast<u32>(std::min<size_t>(block_count, std::max(1u, std::thread::hardware_concurrency()))));
+			for (size_t x = 0; x < block_count; x++)
+				pool.push_task([&decompress_block, x]() { decompress_block(x); });
+
+			pool.wait();
+		}
+
+		VALIDATE(valid, m_buffer.clear(); return false, "", "Corrupted compressed data in section [" << m_name << "] of [" << m_filename.generic_string() << "]");
+
+		m_section = m_buffer;
+		return true;
+	}
+
+
+	void binary::save_section() {
+
+		// collect the sections of an existing file that are kept
+		std::vector<section_entry> sections{};
+		std::vector<std::vector<u8>> payloads{};
+		if (std::ifstream existing(m_filename, std::ios::in | std::ios::binary); existing.is_open() && read_section_table(existing, sections)) {
+
+			std::error_code error_code;
+			const u64 file_size = static_cast<u64>(std::filesystem::file_size(m_filename, error_code));
+			for (auto it = sections.begin(); it != sections.end(); ) {
+
+				if (it->name == m_name || error_code || it->offset > file_size || it->size > file_size - it->offset) {
+
+					it = sections.erase(it);
+					continue;
+				}
+
+				std::vector<u8> payload(static_cast<size_t>(it->size));
+				existing.seekg(static_cast<std::streamoff>(it->offset));
+				if (!existing.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+
+					existing.clear();
+					it = sections.erase(it);
+					continue;
+				}
+
+				// sections from older versions get a checksum, corrupted ones are not carried over
+				if (!(it->flags & SECTION_CHECKSUM)) {
+
+					it->checksum = io::crc32c(payload);
+					it->flags |= SECTION_CHECKSUM;
+
+				} else if (io::crc32c(payload) != it->checksum) {
+
+					LOG(Warn, "Dropping corrupted section [" << it->name << "] of [" << m_filename.generic_string() << "]");
+					it = sections.erase(it);
+					continue;
+				}
+				payloads.push_back(std::move(payload));
+				++it;
+			}
+		} else
+			sections.clear();
+
+		// the payload of this section, compressed if requested
+		std::vector<u8> compressed{};
+		u32 flags = SECTION_CHECKSUM;
+		if (m_compression == compression_mode::lz4) {
+
+			compressed = compress_section(m_buffer);
+			flags |= SECTION_COMPRESSED;
+		}
+		const std::span<const u8> payload = (flags & SECTION_COMPRESSED) ? std::span<const u8>(compressed) : std::span<const u8>(m_buffer);
+
+		sections.push_back({ m_name, 0, payload.size(), flags, io::crc32c(payload) });
+		VALIDATE(sections.size() <= std::numeric_limits<u16>::max(), return, "", "Too many sections in [" << m_filename.generic_string() << "]");
+
+		// layout: header, section table, aligned payloads
+		size_t table_size = 0;
+		for (const auto& section : sections)
+			table_size = align_up(table_size + 2 * sizeof(u64) + 3 * sizeof(u32) + section.name.size(), 8);
+
+		size_t offset = align_up(HEADER_SIZE + table_size, SECTION_ALIGNMENT);
+		for (auto& section : sections) {
+
+			section.offset = offset;
+			offset = align_up(offset + static_cast<size_t>(section.size), SECTION_ALIGNMENT);
+		}
+
+		std::vector<u8> file(offset, 0);
+		size_t position = 0;
+		auto write = [&](const void* data, const size_t size) {
+
+			std::memcpy(file.data() + position, data, size);
+			position += size;
+		};
+
+		const u32 magic = to_little_endian(MAGIC);
+		const u16 version = to_little_endian(FORMAT_VERSION);
+		const u16 section_count = to_little_endian(static_cast<u16>(sections.size()));
+		const u64 stored_table_size = to_little_endian(static_cast<u64>(table_size));
+		write(&magic, sizeof(magic));
+		write(&version, sizeof(version));
+		write(&section_count, sizeof(section_count));
+		write(&stored_table_size, sizeof(stored_table_size));
+
+		for (const auto& section : sections) {
+
+			const u64 section_offset = to_little_endian(section.offset);
+			const u64 section_size = to_little_endian(section.size);
+			const u32 section_flags = to_little_endian(section.flags);
+			const u32 section_checksum = to_little_endian(section.checksum);
+			const u32 name_length = to_little_endian(static_cast<u32>(section.name.size()));
+			write(&section_offset, sizeof(section_offset));
+			write(&section_size, sizeof(section_size));
+			write(&section_flags, sizeof(section_flags));
+			write(&section_checksum, sizeof(section_checksum));
+			write(&name_length, sizeof(name_length));
+			write(section.name.data(), section.name.size());
+			position = align_up(position, 8);
+		}
+
+		for (size_t x = 0; x < payloads.size(); x++)
+			if (!payloads[x].empty())
+				std::memcpy(file.data() + sections[x].offset, payloads[x].data(), payloads[x].size());
+
+		if (!payload.empty())
+			std::memcpy(file.data() + sections.back().offset, payload.data(), payload.size());
+
+		// the old file stays intact until the new one is completely on disk
+		io::atomic_file_writer writer(m_filename);
+		writer.write(file);
+		VALIDATE(writer.commit(), return, "", "Failed to save [" << file.size() << "] bytes to [" << m_filename.generic_string() << "]");
 	}
 
 }
@@ -1,12 +1,57 @@
 #pragma once
 
+#include <bit>
+
 #include "serializer_data.h"
+#include "mapped_file.h"
 
 namespace AT::serializer {
 
+	// Binary (de)serializer that stores named sections in one file.
+	//
+	// All entries of a section are collected in a memory buffer and the file is written with a single call
+	// when the serializer is destroyed; loading reads the whole section with a single call. Integers, floats,
+	// enums and lengths are stored as fixed-width little-endian values, so files are portable between machines.
+	//
+	// File layout (all values little-endian):
+	//   header         u32 magic "ATBS", u16 format version, u16 section count, u64 size of the section table
+	//   section table  per section: u64 offset, u64 size, u32 flags, u32 CRC32C of the stored payload, u32 name length,
+	//                  name, zero padding to 8 bytes (older versions without flags or checksum are still read)
+	//   sections       payloads, each starting at a multiple of [SECTION_ALIGNMENT]
+	// Saving a section keeps all other sections of an existing file and replaces the file atomically
+	// (see [io::atomic_file_writer]). Loading verifies the checksum of the section it reads, a mismatch
+	// is handled like a missing section.
+	//
+	// A section can be saved compressed (see set_compression()). Its payload is then split into blocks of
+	// [COMPRESSION_BLOCK_SIZE] bytes that are compressed independently, so loading decompresses them in parallel:
+	//   u64 uncompressed size, u32 block size, u32 block count, per block: u32 stored size, then the blocks
+	// The highest bit of a stored size marks a block that did not compress and is stored as is.
+	//
+	// With [load_mode::memory_mapped] the file is mapped instead of read, and span() returns views directly into
+	// the mapping. Loading a large cache then costs page faults for the parts that are touched, not a full copy.
 	class binary {
 	public:
 
+		enum class load_mode {
+
+			buffered,						// read the section into a buffer owned by the serializer
+			memory_mapped,					// map the file and read the section in place
+		};
+
+		enum class compression_mode {
+
+			none,
+			lz4,							// LZ4 block format, see [io::lz4_compress]
+		};
+
+		static constexpr u32 MAGIC = 0x53425441;						// "ATBS" as stored in the file
+		static constexpr u16 FORMAT_VERSION = 3;
+		static constexpr size_t SECTION_ALIGNMENT = 16;
+		static constexpr size_t HEADER_SIZE = 16;
+		static constexpr u32 COMPRESSION_BLOCK_SIZE = 64 * 1024;
+		static constexpr u32 VECTOR_BLOCK_SIZE = 256;					// elements per length-prefixed block written by vector()
+		static constexpr u32 MAX_VECTOR_BLOCK_SIZE = 64 * 1024;			// larger block sizes can only come from a corrupted file
+
 		DELETE_COPY_MOVE_CONSTRUCTOR(binary);
 
 		// Declares a default getter for the serialization option member.
@@ -16,30 +61,46 @@ namespace AT::serializer {
 
 
 		// Constructs a binary serializer/deserializer for the given file and section.
-		// When [option] is save_to_file the object opens the file for binary output;
-		// otherwise it opens the file for binary input.
+		// When [option] is save_to_file entries are collected in memory and written on destruction;
+		// otherwise the section is read from the file. A missing file, an unknown format or a missing
+		// section is logged and every following read leaves its value untouched.
 		// @param filename The path to the file to read from or write to.
-		// @param section_name A human-readable name for the section being (de)serialized.
+		// @param section_name The name of the section inside the file.
 		// @param option Controls whether the instance is used to save to or load from file.
+		// @param mode How the section is loaded, ignored when saving.
 		// @return Constructs a binary object ready to perform (de)serialization.
-		binary(const std::filesystem::path filename, const std::string& section_name, option option);
+		binary(const std::filesystem::path filename, const std::string& section_name, option option, load_mode mode = load_mode::buffered);
 
 
-		// Destroys the binary (de)serializer and closes any open file streams.
-		// If the object opened an output stream it will be closed; likewise for input streams.
+		// Destroys the binary (de)serializer. When saving, the collected section is written to the file
+		// together with all other sections that already exist in it.
 		// @return None.
 		~binary();
 
 
+		// Returns false if loading and the section could not be read (missing file, wrong format, missing section)
+		// or if a read ran past the end of the section.
+		bool is_valid() const											{ return m_valid; }
+
+
+		// Returns the mapping of the file when loading with [load_mode::memory_mapped], nullptr otherwise.
+		// Keep the returned handle to use spans from span() after the serializer is destroyed.
+		ref<io::mapped_file> get_mapping() const						{ return m_mapping; }
+
+
+		// Selects the compression of the section when saving, loading detects it from the file.
+		// A compressed section is decompressed into a buffer, also with [load_mode::memory_mapped].
+		// @param mode The compression used when the section is written.
+		// @return A reference to *this to allow chaining.
+		binary& set_compression(const compression_mode mode)			{ m_compression = mode; return *this; }
+
+
 		// Serializes or deserializes a single value depending on the configured option.
-		// If saving:
-		//   - For std::filesystem::path: converts to a string and serializes that string.
-		//   - For std::string: writes a length (size_t) followed by the raw characters.
-		//   - For other types: writes raw bytes of sizeof(T).
-		// If loading:
-		//   - For std::filesystem::path: reads a string and constructs the path from it.
-		//   - For std::string: reads a length then fills the string buffer from the stream.
-		//   - For other types: reads raw bytes into the provided value.
+		//   - For std::filesystem::path: converts to a generic string and serializes that string.
+		//   - For std::string: a u64 length followed by the raw characters.
+		//   - For integers, floats and enums: fixed-width little-endian bytes.
+		//   - For classes that convert to and from u64 (e.g. UUID): the u64 value.
+		//   - For other trivially copyable types: raw bytes of sizeof(T) (members in host layout).
 		// @tparam T The type of the value to (de)serialize.
 		// @param value Reference to the value to serialize (when saving) or to receive the value (when loading).
 		// @return A reference to *this to allow chaining of entry(...) calls.
@@ -55,12 +116,20 @@ namespace AT::serializer {
 
 				} else if constexpr (std::is_same_v<T, std::string>) {
 
-					size_t length = value.size();
-					m_ostream.write(reinterpret_cast<const char*>(&length), sizeof(length));
-					m_ostream.write(reinterpret_cast<const char*>(value.data()), length);
+					write_value<u64>(value.size());
+					write_bytes(value.data(), value.size());
 
-				} else
-					m_ostream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+				} else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+					write_value<T>(value);
+
+				else if constexpr (is_u64_wrapper<T>)
+					write_value<u64>(static_cast<u64>(value));
+
+				else {
+
+					static_assert(std::is_trivially_copyable_v<T>, "binary::entry() needs a trivially copyable type, use fields() or vector() for others");
+					write_bytes(&value, sizeof(T));
+				}
 
 			} else {
 
@@ -72,51 +141,83 @@ namespace AT::serializer {
 
 				} else if constexpr (std::is_same_v<T, std::string>) {
 
-					size_t length = 0;
-					m_istream.read(reinterpret_cast<char*>(&length), sizeof(length));
-					
-					ASSERT(length < 65565, "", "Corrupted path length")
+					u64 length = 0;
+					if (!read_value<u64>(length))
+						return *this;
+
+					VALIDATE(length <= remaining_bytes(), fail(); return *this, "", "Corrupted string length [" << length << "] in section [" << m_name << "]");
+
+					value.assign(reinterpret_cast<const char*>(m_section.data() + m_read_position), static_cast<size_t>(length));
+					m_read_position += static_cast<size_t>(length);
+
+				} else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+					read_value<T>(value);
 
-					value.resize(length);
-					m_istream.read(value.data(), length);
+				else if constexpr (is_u64_wrapper<T>) {
 
-				} else
-					m_istream.read(reinterpret_cast<char*>(&value), sizeof(T));
+					u64 buffer = 0;
+					if (read_value<u64>(buffer))
+						value = T(buffer);
+
+				} else {
+
+					static_assert(std::is_trivially_copyable_v<T>, "binary::entry() needs a trivially copyable type, use fields() or vector() for others");
+					read_bytes(&value, sizeof(T));
+				}
 			}
 
 			return *this;
 		}
 
 
-		// Serializes or deserializes a contiguous std::vector<T>.
-		// If saving: writes the vector's size (size_t) followed by the raw element bytes (sizeof(T) * size).
-		// If loading: reads the size, resizes the vector, then reads raw element bytes into vector.data().
-		// NOTE: This assumes T is trivially copyable / safely writable as raw bytes.
+		// Serializes or deserializes every member of [object] that was declared with [SERIALIZABLE], in declaration order.
+		// Uses the same field list as [serializer::yaml::fields] so both formats always contain the same members.
+		// @tparam T A type that declares its members with [SERIALIZABLE].
+		// @param object The object whose declared fields should be written (when saving) or filled (when loading).
+		// @return A reference to *this to allow chaining.
+		template<serializable T>
+		binary& fields(T& object) {
+
+			for_each_field<T>([&](const auto& field) { entry(object.*(field.member)); });
+			return *this;
+		}
+
+
+		// Serializes or deserializes a std::vector<T>.
+		// Writes the element count as u64 followed by the elements. Trivially copyable elements are copied
+		// as one block (integers and floats are byte-swapped on big-endian hosts), others use entry() per element.
 		// @tparam T The vector element type.
 		// @param vector The vector to write (when saving) or to fill (when loading).
 		// @return A reference to *this to allow chaining.
 		template<typename T>
 		binary& entry(std::vector<T>& vector) {
+
 			if (m_option == option::save_to_file) {
-				size_t size = vector.size();
-				m_ostream.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
-				
-				if constexpr (std::is_trivially_copyable_v<T>) 			// For trivially copyable types, write raw bytes
-					m_ostream.write(reinterpret_cast<const char*>(vector.data()), sizeof(T) * size);
 
-				else {													// For non-trivially copyable types, serialize each element individually
+				write_value<u64>(vector.size());
+				if constexpr (std::is_trivially_copyable_v<T>)
+					write_array(vector.data(), vector.size());
+
+				else {
 					for (auto& element : vector)
 						entry(element);
 				}
+
 			} else {
-				size_t vector_size = 0;
-				m_istream.read(reinterpret_cast<char*>(&vector_size), sizeof(size_t));
-				vector.resize(vector_size);
-				
-				if constexpr (std::is_trivially_copyable_v<T>) 			// For trivially copyable types, read raw bytes
-					m_istream.read(reinterpret_cast<char*>(vector.data()), sizeof(T) * vector_size);
-				
-				else {													// For non-trivially copyable types, deserialize each element individually
+
+				u64 vector_size = 0;
+				if (!read_value<u64>(vector_size))
+					return *this;
+
+				// every element needs at least one byte, larger counts can only come from a corrupted file
+				const u64 minimum_element_size = std::is_trivially_copyable_v<T> ? sizeof(T) : 1;
+				VALIDATE(vector_size <= remaining_bytes() / minimum_element_size, fail(); return *this, "", "Corrupted vector size [" << vector_size << "] in section [" << m_name << "]");
+
+				vector.resize(static_cast<size_t>(vector_size));
+				if constexpr (std::is_trivially_copyable_v<T>)
+					read_array(vector.data(), vector.size());
+
+				else {
 					for (auto& element : vector)
 						entry(element);
 				}
@@ -126,7 +227,7 @@ namespace AT::serializer {
 
 
 		// Serializes or deserializes a raw array region of known size.
-		// If saving: writes the array data (sizeof(T) * array_size) from array_start to the output stream.
+		// If saving: writes the array data (sizeof(T) * array_size) from array_start.
 		// If loading: allocates a buffer with malloc(sizeof(T) * array_size), reads bytes into it,
 		//             and assigns the pointer to array_start. Caller becomes the owner and is responsible for freeing it.
 		// WARNING: On load ownership transfers to the caller; memory is allocated with malloc.
@@ -137,44 +238,221 @@ namespace AT::serializer {
 		template<typename T>
 		binary& array(T*& array_start, size_t array_size) {
 
+			static_assert(std::is_trivially_copyable_v<T>, "binary::array() needs a trivially copyable type");
 			const size_t total_bytes = sizeof(T) * array_size;
 			if (m_option == option::save_to_file) {
-				m_ostream.write(reinterpret_cast<const char*>(array_start), total_bytes);
+
+				write_array(array_start, array_size);
+
 			} else {
 
 				array_start = (T*)malloc(total_bytes);
 				LOG(Trace, "Deserializing [" << total_bytes << "] bytes into [" << (void*)array_start << "]")
-				m_istream.read(reinterpret_cast<char*>(array_start), total_bytes);
+				read_array(array_start, array_size);
 			}
 
 			return *this;
 		}
 
 
-		// Placeholder for serializing/deserializing a vector with a custom per-element callback.
-		// Currently unimplemented — logs an error and returns immediately.
-		// Intended behavior (when implemented): iterate elements and call vector_function for each element,
-		// allowing custom (de)serialization logic for complex element types.
+		// Serializes a contiguous range, or on load returns a view of it without copying.
+		// Writes the element count as u64, zero padding up to alignof(T) and the elements as one block, so the
+		// elements are correctly aligned inside the file. On load [view] points into the section data: into the
+		// mapping with [load_mode::memory_mapped] (valid while the serializer or a handle from get_mapping() lives),
+		// otherwise or for compressed sections into the buffer of the serializer (valid while the serializer lives).
+		// Multi-byte integers and floats are stored little-endian and can not be viewed in place on big-endian
+		// hosts, there the error is logged and [view] is empty; use entry(std::vector<T>&) instead.
+		// @tparam T A trivially copyable element type.
+		// @param view The elements to write (when saving) or the view to set (when loading).
+		// @return A reference to *this to allow chaining.
+		template<typename T>
+		binary& span(std::span<const T>& view) {
+
+			static_assert(std::is_trivially_copyable_v<T>, "binary::span() needs a trivially copyable type");
+			static_assert(alignof(T) <= SECTION_ALIGNMENT, "binary::span() can not align elements beyond the section alignment");
+			constexpr bool needs_byte_swap = (std::is_arithmetic_v<T> || std::is_enum_v<T>) && std::endian::native != std::endian::little && sizeof(T) > 1;
+
+			if (m_option == option::save_to_file) {
+
+				write_value<u64>(view.size());
+				m_buffer.resize(align_up(m_buffer.size(), alignof(T)), 0);
+				write_array(view.data(), view.size());
+
+			} else {
+
+				view = {};
+				u64 count = 0;
+				if (!read_value<u64>(count))
+					return *this;
+
+				const size_t padding = align_up(m_read_position, alignof(T)) - m_read_position;
+				VALIDATE(padding <= remaining_bytes() && count <= (remaining_bytes() - padding) / sizeof(T), fail(); return *this, "", "Corrupted span size [" << count << "] in section [" << m_name << "]");
+				m_read_position += padding;
+
+				const u8* data = m_section.data() + m_read_position;
+				m_read_position += static_cast<size_t>(count) * sizeof(T);
+				if constexpr (needs_byte_swap) {
+
+					LOG(Error, "binary::span() can not view little-endian values in place on a big-endian host, section [" << m_name << "]");
+					return *this;
+
+				} else {
+
+					VALIDATE(reinterpret_cast<uintptr_t>(data) % alignof(T) == 0, return *this, "", "Misaligned span data in section [" << m_name << "]");
+					view = std::span<const T>(reinterpret_cast<const T*>(data), static_cast<size_t>(count));
+				}
+			}
+
+			return *this;
+		}
+
+
+		// Serializes or deserializes a vector with a custom per-element callback, same shape as [serializer::yaml::vector].
+		// Elements are stored in blocks of [VECTOR_BLOCK_SIZE] elements:
+		//   u64 element count, u32 elements per block, per block: u64 byte length, the entries of its elements
+		// Every block is read by its own serializer that is limited to the block, so a reader can skip a vector
+		// (see skip_vector()) or decode the blocks in parallel without parsing every element.
 		// @tparam T The vector element type.
-		// @param vector The vector to operate on.
-		// @param vector_function A callback that performs (de)serialization per element.
+		// @param vector The vector to write (when saving) or to resize and fill (when loading).
+		// @param vector_function Called once per element with the serializer to use and the element index.
 		//                        Signature: void(AT::serializer::binary&, const u64 iteration)
-		// @return A reference to *this (currently the function returns immediately after logging).
+		//                        Only use the serializer passed to the callback, it is not *this when loading.
+		// @param max_threads Loading only: number of threads used to decode blocks. Callbacks then run concurrently
+		//                    for different elements and must not share state without synchronization.
+		// @return A reference to *this to allow chaining.
 		template<typename T>
-		binary& vector(std::vector<T>& vector, std::function<void(AT::serializer::binary&, const u64 iteration)> vector_function) {
+		binary& vector(std::vector<T>& vector, std::function<void(AT::serializer::binary&, const u64 iteration)> vector_function, const u32 max_threads = 1) {
+
+			if (m_option == option::save_to_file)
+				save_vector_blocks(vector.size(), vector_function);
 
-			LOG(Error, "NOT IMPLEMENTED YET");
+			else {
+
+				vector_blocks layout{};
+				if (!read_vector_blocks(layout))
+					return *this;
+
+				vector.resize(static_cast<size_t>(layout.element_count));
+				load_vector_blocks(layout, vector_function, max_threads);
+			}
 			return *this;
 		}
 
 
+		// Skips a vector written by vector() using only the block lengths, no element is parsed.
+		// Only valid when loading.
+		// @return A reference to *this to allow chaining.
+		binary& skip_vector();
+
+
 	private:
 
+		static constexpr u32 SECTION_COMPRESSED = 1 << 0;				// section flags
+		static constexpr u32 SECTION_CHECKSUM = 1 << 1;
+		static constexpr u32 STORED_UNCOMPRESSED = 1u << 31;			// block size flag
+
+		struct section_entry {
+			std::string			name{};
+			u64					offset = 0;
+			u64					size = 0;
+			u32					flags = 0;
+			u32					checksum = 0;
+		};
+
+		struct vector_blocks {
+			u64									element_count = 0;
+			u32									block_size = 0;
+			std::vector<std::span<const u8>>	blocks{};
+		};
+
+		// Creates a loading serializer that reads a single block of [parent]
+		binary(const binary& parent, std::span<const u8> block);
+
+		static constexpr size_t align_up(const size_t value, const size_t alignment)		{ return (value + alignment - 1) / alignment * alignment; }
+
+		template<typename T>
+		static constexpr bool is_u64_wrapper = std::is_class_v<T> && std::is_convertible_v<const T&, u64> && std::is_constructible_v<T, u64>;
+
+		// Returns [value] with its bytes in little-endian order (a no-op on little-endian hosts).
+		template<typename T>
+		static T to_little_endian(const T value) {
+
+			if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1)
+				return value;
+			else {
+
+				auto bytes = std::bit_cast<std::array<u8, sizeof(T)>>(value);
+				std::reverse(bytes.begin(), bytes.end());
+				return std::bit_cast<T>(bytes);
+			}
+		}
+
+		template<typename T>
+		void write_value(const T value) {
+
+			const T stored = to_little_endian(value);
+			write_bytes(&stored, sizeof(T));
+		}
+
+		template<typename T>
+		bool read_value(T& value) {
+
+			T stored{};
+			if (!read_bytes(&stored, sizeof(T)))
+				return false;
+
+			value = to_little_endian(stored);
+			return true;
+		}
+
+		template<typename T>
+		void write_array(const T* data, const size_t count) {
+
+			if constexpr ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && std::endian::native != std::endian::little && sizeof(T) > 1) {
+				for (size_t x = 0; x < count; x++)
+					write_value<T>(data[x]);
+			} else
+				write_bytes(data, sizeof(T) * count);
+		}
+
+		template<typename T>
+		void read_array(T* data, const size_t count) {
+
+			if constexpr ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && std::endian::native != std::endian::little && sizeof(T) > 1) {
+				for (size_t x = 0; x < count; x++)
+					read_value<T>(data[x]);
+			} else
+				read_bytes(data, sizeof(T) * count);
+		}
+
+		size_t remaining_bytes() const									{ return m_section.size() - m_read_position; }
+
+		void write_bytes(const void* data, const size_t size);
+		bool read_bytes(void* data, const size_t size);
+		void fail();
+
+		void save_vector_blocks(const u64 element_count, const std::function<void(binary&, const u64)>& element_function);
+		bool read_vector_blocks(vector_blocks& layout);
+		void load_vector_blocks(const vector_blocks& layout, const std::function<void(binary&, const u64)>& element_function, const u32 max_threads);
+
+		bool load_section();
+		bool map_section();
+		bool decompress_section(std::span<const u8> payload);
+		static std::vector<u8> compress_section(std::span<const u8> payload);
+		void save_section();
+		static bool read_section_table(std::istream& stream, std::vector<section_entry>& sections);
+		static bool parse_section_table(std::span<const u8> file, std::vector<section_entry>& sections);
+
 		std::filesystem::path 		m_filename{};
 		std::string 				m_name{};
 		option 						m_option;
-		std::ofstream 				m_ostream{};
-		std::ifstream 				m_istream{};
+		load_mode					m_load_mode;
+		compression_mode			m_compression = compression_mode::none;
+		std::vector<u8>				m_buffer{};						// payload of this section (saving and buffered loading)
+		ref<io::mapped_file>		m_mapping{};					// mapped file (memory mapped loading)
+		std::span<const u8>			m_section{};					// the loaded section, points into [m_buffer] or [m_mapping]
+		size_t						m_read_position = 0;
+		bool						m_valid = true;
 
 	};
 
@@ -1,12 +1,25 @@
 #pragma once
 
+#include <tuple>
+
 #include "util/data_structures/string_manipulation.h"
 
 #define TEST_NAME_CONVERSION(variable)		AT::util::extract_variable_name(#variable)
 #define SERIALIZE_KEY_VALUE(variable)		serialize_key_value(AT::util::extract_variable_name(#variable), variable);
 
 // @brief used with [serializer] to shorten the serializer::yaml::entry call
-#define KEY_VALUE(var)						AT::util::extract_variable_name(#var), var
+#define KEY_VALUE(var)						std::string(AT::util::variable_name(#var)), var
+
+// @brief Declares the members of [type] that are (de)serialized by [serializer::yaml::fields] and [serializer::binary::fields].
+//          Generates a static constexpr function returning a tuple of [serializer::field] descriptors, so key names
+//          and their hashes are known at compile time and both formats always use the same list of members.
+//          Place inside the struct body after the members, e.g.: SERIALIZABLE(project_data, ID, name, description);
+#define SERIALIZABLE(type, ...)				static constexpr auto serializable_fields() {													\
+												using serializable_type = type;															\
+												return std::make_tuple(MACRO_FOR_EACH(SERIALIZER_FIELD, __VA_ARGS__));					\
+											}
+
+#define SERIALIZER_FIELD(member)			AT::serializer::field{ #member, &serializable_type::member }
 
 namespace AT::serializer {
 
@@ -15,5 +28,36 @@ namespace AT::serializer {
 		save_to_file,
 		load_from_file,
 	};
-	
+
+
+	// @brief Compile-time descriptor of a single serializable member, generated by [SERIALIZABLE].
+	// @tparam class_type The type that owns the member.
+	// @tparam member_type The type of the member.
+	template<typename class_type, typename member_type>
+	struct field {
+
+		using type = member_type;
+
+		constexpr field(std::string_view name, member_type class_type::* member)
+			: name(name), hash(util::hash_string(name)), member(member) {}
+
+		std::string_view			name;			// key name as written in the YAML file
+		u64							hash;			// precomputed [util::hash_string] of [name]
+		member_type class_type::*	member;			// pointer to the described member
+	};
+
+
+	// @brief Satisfied by every type that declares its members with [SERIALIZABLE].
+	template<typename T>
+	concept serializable = requires { T::serializable_fields(); };
+
+
+	// @brief Calls [function] once for every field descriptor of [T], in declaration order.
+	// @param [function] A callable accepting a [serializer::field] (e.g. a generic lambda: [](const auto& field) {...}).
+	template<serializable T, typename function_type>
+	constexpr void for_each_field(function_type&& function) {
+
+		std::apply([&](const auto&... fields) { (function(fields), ...); }, T::serializable_fields());
+	}
+
 }
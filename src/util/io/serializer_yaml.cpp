@@ -2,6 +2,8 @@
 #include "util/pch.h"
 
 #include "util/io/io.h"
+#include "util/io/atomic_file_writer.h"
+#include "util/data_structures/thread_pool.h"
 
 #include "serializer_yaml.h"
 
@@ -82,159 +84,290 @@ namespace AT::serializer {
 
 		istream.close();
 
-		auto ostream = std::ofstream(m_filename);
-		ASSERT(ostream.is_open(), "", "output-file-stream is not open");
-
-		ostream << updated_file.str();
-		ostream.close();
+		// replace the file in one step, a crash while saving leaves the previous version
+		io::atomic_file_writer writer(m_filename);
+		writer.write(updated_file.view());
+		VALIDATE(writer.commit(), return, "", "Failed to save section [" << m_name << "] to [" << m_filename.generic_string() << "]");
 	}
 
 	yaml& yaml::deserialize() {
 
 		ASSERT(!m_name.empty(), "", "name of section to find is empty");
 
-		m_istream = std::ifstream(m_filename);
-		VALIDATE(m_istream.is_open(), return *this, "", "file-stream is not open");
+		m_scopes.resize(1);
+		m_scope_depth = 0;
 
-		const u32 SECTION_INDENTATION = 0;
-		bool found_section = false;
-		std::string line;
-		while (std::getline(m_istream, line)) {
+		// read the whole file with one allocation, all keys and values are views into this buffer
+		std::ifstream stream(m_filename, std::ios::in | std::ios::binary | std::ios::ate);
+		VALIDATE(stream.is_open(), return *this, "", "file-stream is not open");
 
-			// skip empty lines or comments
-			if (line.empty() || line.front() == '#')
-				continue;
+		m_source.resize(static_cast<size_t>(stream.tellg()));
+		stream.seekg(0);
+		stream.read(m_source.data(), static_cast<std::streamsize>(m_source.size()));
+		m_source.resize(static_cast<size_t>(stream.gcount()));
+		stream.close();
 
-			// if line contains desired section enter inner-loop
-			if (line.find(m_name + ":") != std::string::npos && util::measure_indentation(line, NUM_OF_INDENTING_SPACES) == 0) {
+		// the whole file is the outermost scope, the section is found like any other block in it
+		m_scopes[0].content = m_source;
+		std::string_view section{};
+		u32 header_column = 0;
+		if (!find_block(m_name, section, header_column)) {
 
-				found_section = true;
+			m_scopes[0].content = {};
+			return *this;
+		}
 
-				//     not end of file                   line has more leading spaces
-				while (std::getline(m_istream, line) && (util::measure_indentation(line, NUM_OF_INDENTING_SPACES) > SECTION_INDENTATION)) {
+		push_scope(section, header_column + NUM_OF_INDENTING_SPACES, -1);
+		std::swap(m_scopes[0], m_scopes[1]);					// keep the section as the base scope
+		m_scope_depth = 0;
+		return *this;
+	}
 
-					line = line.substr(NUM_OF_INDENTING_SPACES);
+	void yaml::push_scope(const std::string_view content, const u32 indentation, const int64 item_column) {
 
-					//  more indented                                         is sub-section        is array-element
-					if ((util::measure_indentation(line, NUM_OF_INDENTING_SPACES) > SECTION_INDENTATION) || line.back() == ':' || line.front() == '-') {
+		m_scope_depth++;
+		if (m_scopes.size() <= m_scope_depth)
+			m_scopes.emplace_back();
 
-						m_file_content << line << '\n';
-						continue;
-					}
+		scope& current = m_scopes[m_scope_depth];
+		current.content = content;
+		current.indentation = indentation;
+		current.item_column = item_column;
+		current.keys.clear();
 
-					std::string key, value;
-					extract_key_value(key, value, line);
-					m_key_value_pares[key] = value;
-				}
+		std::string_view remaining = content;
+		std::string_view line{};
+		while (next_line(remaining, line)) {
+
+			u32 column = 0;
+			while (column < line.size() && line[column] == ' ')
+				column++;
+
+			// the first line of a vector element starts with the "- " marker, its content counts as indented
+			if (static_cast<int64>(column) == item_column && line.substr(column).starts_with("- ")) {
+
+				column += 2;
+				while (column < line.size() && line[column] == ' ')
+					column++;
 			}
 
-			// exit outer loop if inner-loop already done
-			if (found_section)
-				break;
+			std::string_view text = line.substr(column);
+			if (column != indentation || text.empty() || text.front() == '#' || text.starts_with("- ") || text.back() == ':')
+				continue;														// not a direct key/value pair of this scope
 
+			std::string_view key{}, value{};
+			if (split_key_value(text, key, value))
+				current.keys.insert_or_assign(key, value);
 		}
-		return *this;
 	}
 
-	void yaml::extract_key_value(std::string& key, std::string& value, std::string& line) {
+	void yaml::pop_scope() {
 
-		std::istringstream iss(line);
-		std::getline(iss, key, ':');
-		std::getline(iss, value);
+		ASSERT(m_scope_depth > 0, "", "Tried to leave the outermost scope");
+		m_scope_depth--;
+	}
 
-		if (const u32 indentation = util::measure_indentation(key, 1); indentation > 0)
-			key = key.substr(indentation);
+	bool yaml::find_block(const std::string_view name, std::string_view& block, u32& header_column) const {
 
-		if (!value.empty() && value.front() == ' ')
-			value.erase(0, 1);
-	}
+		const scope& current = m_scopes[m_scope_depth];
+		std::string_view remaining = current.content;
+		std::string_view line{};
+		while (next_line(remaining, line)) {
 
-	yaml& yaml::sub_section(const std::string& section_name, std::function<void(serializer::yaml&)> sub_section_function) {
+			u32 column = 0;
+			while (column < line.size() && line[column] == ' ')
+				column++;
 
-		m_level_of_indention++;
+			if (static_cast<int64>(column) == current.item_column && line.substr(column).starts_with("- "))
+				column += 2;
 
-		if (m_option == serializer::option::save_to_file) {
+			if (column != current.indentation)
+				continue;
 
-			m_file_content << util::add_spaces(m_level_of_indention + static_cast<u32>(vector_func_index -1), NUM_OF_INDENTING_SPACES) << section_name << ":\n";
-			sub_section_function(*this);
+			std::string_view text = line.substr(column);
+			while (!text.empty() && text.back() == ' ')
+				text.remove_suffix(1);
 
-		} else {	// load from file
+			if (text.size() != name.size() + 1 || text.back() != ':' || !text.starts_with(name))
+				continue;
 
-			// buffer [m_key_value_pares] for duration of function
-			std::unordered_map<std::string, std::string> key_value_pares_buffer = m_key_value_pares;
-			m_key_value_pares = {};
+			// the block ends at the first line that is less indented, or equally indented but not a "- " element
+			const char* block_start = remaining.data();
+			std::string_view block_line{};
+			std::string_view rest = remaining;
+			while (true) {
 
-			// buffer [m_file_content] for duration of function
-			std::stringstream file_content_buffer;
-			file_content_buffer << m_file_content.str();
-			m_file_content = {};
+				const std::string_view line_start = rest;
+				if (!next_line(rest, block_line))
+					break;
 
-			// deserialize content of subsections				
-			// const u32 section_indentation = 0;
-			bool found_section = false;
-			std::string line;
-			//m_level_of_indention++;
-			while (std::getline(file_content_buffer, line)) {
+				u32 block_column = 0;
+				while (block_column < block_line.size() && block_line[block_column] == ' ')
+					block_column++;
 
-				// skip empty lines or comments
-				if (line.empty() || line.front() == '#')
+				const std::string_view block_text = block_line.substr(block_column);
+				if (block_text.empty() || block_text.front() == '#')
 					continue;
 
-				// if line contains desired section enter inner-loop
-				//   has incorrect indentaion											ends NOT with double-point
-				if ((util::measure_indentation(line, NUM_OF_INDENTING_SPACES) != 0) || (line.back() != ':'))
-					continue;
+				if (block_column < column || (block_column == column && !block_text.starts_with("- "))) {
 
-				// remove leading and trailing whitespace
-				auto trimmed = line;
-				trimmed.erase(trimmed.begin(), std::find_if(trimmed.begin(), trimmed.end(), [](unsigned char ch) {
-					return !std::isspace(ch);
-				}));
-				trimmed.erase(std::find_if(trimmed.rbegin(), trimmed.rend(), [](unsigned char ch) {
-					return !std::isspace(ch);
-				}).base(), trimmed.end());
+					rest = line_start;
+					break;
+				}
+			}
 
-				// Remove the trailing colon
-				if (!trimmed.empty() && trimmed.back() == ':')
-					trimmed.pop_back();
+			block = std::string_view(block_start, static_cast<size_t>(rest.data() - block_start));
+			header_column = column;
+			return true;
+		}
+		return false;
+	}
 
-				if (trimmed != section_name)		// has incorrect section_name
-					continue;
+	bool yaml::next_line(std::string_view& text, std::string_view& line) {
 
-				found_section = true;
+		if (text.empty())
+			return false;
 
-				while (std::getline(file_content_buffer, line)) {
+		const size_t line_end = text.find('\n');
+		line = text.substr(0, line_end);
+		text.remove_prefix(line_end == std::string_view::npos ? text.size() : line_end + 1);
 
-					if (util::measure_indentation(line, NUM_OF_INDENTING_SPACES) < m_level_of_indention)	// exit inner loop after section is finished
-						break;		
+		while (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
 
-					line = line.substr(NUM_OF_INDENTING_SPACES);
+		return true;
+	}
 
-					//  more indented																		beginning of new sub-section
-					if (util::measure_indentation(line, NUM_OF_INDENTING_SPACES) > m_level_of_indention -1 || line.back() == ':' || line.front() == '-') {
+	bool yaml::next_item(std::string_view& block, std::string_view& item, int64& item_column) {
 
-						m_file_content << line << "\n";
-						continue;
-					}
+		std::string_view line{};
+		while (true) {													// skip to the first "- " marker
 
-					std::string key, value;
-					extract_key_value(key, value, line);
-					m_key_value_pares[key] = value;
-				}
+			const std::string_view line_start = block;
+			if (!next_line(block, line))
+				return false;
 
-				if (found_section)
-					break;
+			u32 column = 0;
+			while (column < line.size() && line[column] == ' ')
+				column++;
+
+			const std::string_view text = line.substr(column);
+			if (!text.starts_with("- ") && text != "-")
+				continue;
+
+			if (item_column < 0)
+				item_column = column;
+
+			if (static_cast<int64>(column) != item_column)
+				continue;
+
+			block = line_start;
+			break;
+		}
+
+		// the element reaches up to the next marker in the same column
+		const char* item_start = block.data();
+		next_line(block, line);
+		while (true) {
+
+			const std::string_view line_start = block;
+			if (!next_line(block, line))
+				break;
+
+			u32 column = 0;
+			while (column < line.size() && line[column] == ' ')
+				column++;
+
+			const std::string_view text = line.substr(column);
+			if (static_cast<int64>(column) <= item_column && !text.empty() && text.front() != '#') {
+
+				block = line_start;
+				break;
 			}
+		}
 
-			if (found_section)
-				sub_section_function(*this);
+		item = std::string_view(item_start, static_cast<size_t>(block.data() - item_start));
+		return true;
+	}
+
+	std::string_view yaml::first_item_line(std::string_view item) {
+
+		std::string_view line{};
+		next_line(item, line);
+
+		const size_t marker = line.find('-');
+		if (marker == std::string_view::npos)
+			return {};
+
+		line.remove_prefix(std::min(marker + 2, line.size()));
+		return line;
+	}
+
+	bool yaml::split_key_value(std::string_view line, std::string_view& key, std::string_view& value) {
+
+		const size_t separator = line.find(':');
+		if (separator == std::string_view::npos)
+			return false;
+
+		key = line.substr(0, separator);
+		while (!key.empty() && key.front() == ' ')
+			key.remove_prefix(1);
+
+		value = line.substr(separator + 1);
+		if (!value.empty() && value.front() == ' ')
+			value.remove_prefix(1);
+
+		return true;
+	}
+
+	yaml& yaml::sub_section(const std::string& section_name, std::function<void(serializer::yaml&)> sub_section_function) {
+
+		m_level_of_indention++;
+
+		if (m_option == serializer::option::save_to_file) {
+
+			m_file_content << util::add_spaces(m_level_of_indention + static_cast<u32>(vector_func_index -1), NUM_OF_INDENTING_SPACES) << section_name << ":\n";
+			sub_section_function(*this);
 
-			m_key_value_pares = key_value_pares_buffer;
-			m_file_content << file_content_buffer.str();
+		} else {	// load from file
+
+			std::string_view block{};
+			u32 header_column = 0;
+			if (find_block(section_name, block, header_column)) {
+
+				push_scope(block, header_column + NUM_OF_INDENTING_SPACES, -1);
+				sub_section_function(*this);
+				pop_scope();
+			}
 		}
 
 		m_level_of_indention--;
 		return *this;
 	}
 
+
+	// ================================================== load_many ==================================================
+
+	void load_many(const std::vector<load_job>& jobs, const u32 max_threads) {
+
+		auto load = [](const load_job& job) {
+
+			yaml loader(job.filename, job.section_name, option::load_from_file);
+			job.load_function(loader);
+		};
+
+		if (jobs.size() <= 1 || max_threads <= 1) {
+
+			for (const auto& job : jobs)
+				load(job);
+			return;
+		}
+
+		util::thread_pool pool(static_cast<u32>(std::min<size_t>(jobs.size(), max_threads)));
+		for (const auto& job : jobs)
+			pool.push_task([&load, &job]() { load(job); });
+
+		pool.wait();
+	}
+
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/data_structures/flat_string_map.h"
+
 #include "serializer_data.h"
 
 namespace AT::serializer {
@@ -36,7 +38,17 @@ namespace AT::serializer {
 		// @param [value] Reference to the variable to be serialized or deserialized.
 		// @return A reference to the YAML object for chaining function calls.
 		template<typename T>
-		yaml& entry(const std::string& key_name, T& value) {
+		yaml& entry(const std::string& key_name, T& value)			{ return entry(std::string_view(key_name), util::hash_string(key_name), value); }
+
+
+		// @brief Same as [entry(key_name, value)] but with the [util::hash_string] of [key_name] already computed,
+		//          used by [fields] to look up keys with the hashes from the compile-time field descriptors.
+		// @param [key_name] The key name associated with the variable in the YAML file.
+		// @param [key_hash] The precomputed [util::hash_string] of [key_name].
+		// @param [value] Reference to the variable to be serialized or deserialized.
+		// @return A reference to the YAML object for chaining function calls.
+		template<typename T>
+		yaml& entry(const std::string_view key_name, const u64 key_hash, T& value) {
 
 			if (m_option == serializer::option::save_to_file) {
 
@@ -60,46 +72,30 @@ namespace AT::serializer {
 
 				if constexpr (is_vector<T>::value) {					// value is a vector
 
-					// deserialize content of subsections
-					typename T::value_type buffer{};
-					bool found_section = false;
-					std::string line;
-					while (std::getline(m_file_content, line)) {
-
-						if (line.empty() || line.front() == '#')		// skip empty lines or comments
-							continue;
-
-						// if line contains desired section enter inner-loop
-						//   has correct indentation                                 has correct section_name                      ends with double-point
-						if ((util::measure_indentation(line) == 0) && (line.find(key_name) != std::string::npos) && (line.back() == ':')) {
-
-							found_section = true;
-							value.clear();								// clear previous data when section found
-
-							//     not end of content                     has correct indentation	         		doesn't end in double-points
-							while (std::getline(m_file_content, line) && (util::measure_indentation(line) == 1) && (line.back() != ':')) {
-
-								// 				   remove indentation		 remove "- " (array element marker)
-								line = line.substr(NUM_OF_INDENTING_SPACES + 2);
-								util::convert_from_string(line, buffer);
-								value.emplace_back(buffer);
-							}
+					std::string_view block{};
+					u32 header_column = 0;
+					if (!find_block(key_name, block, header_column))
+						return *this;
 
-						}
+					value.clear();										// clear previous data when section found
+					typename T::value_type buffer{};
+					std::string_view item{};
+					int64 item_column = -1;
+					while (next_item(block, item, item_column)) {
 
-						if (found_section)								// skip rest of content if section found
-							break;
+						m_value_buffer.assign(first_item_line(item));
+						util::convert_from_string(m_value_buffer, buffer);
+						value.emplace_back(buffer);
 					}
 
 				} else {
 
-					std::string buffer{};
-					auto iterator = m_key_value_pares.find(key_name);
-					if (iterator == m_key_value_pares.end())			// key is not in map
+					const std::string_view* found_value = m_scopes[m_scope_depth].keys.find(key_name, key_hash);
+					if (!found_value)									// key is not in this section
 						return *this;
 
-					buffer = iterator->second;
-					util::convert_from_string(buffer, value);
+					m_value_buffer.assign(*found_value);
+					util::convert_from_string(m_value_buffer, value);
 				}
 			}
 
@@ -108,6 +104,19 @@ namespace AT::serializer {
 		}
 
 
+		// @brief Serializes or deserializes every member of [object] that was declared with [SERIALIZABLE].
+		//          The key names come from the compile-time field descriptors, so no variable name has to be
+		//          parsed at runtime and the list of members is shared with [serializer::binary::fields].
+		// @param [object] The object whose declared fields should be serialized or deserialized.
+		// @return A reference to the YAML object for chaining function calls.
+		template<serializable T>
+		yaml& fields(T& object) {
+
+			for_each_field<T>([&](const auto& field) { entry(field.name, field.hash, object.*(field.member)); });
+			return *this;
+		}
+
+
 		// @brief This function is responsible for serializing or deserializing a vector variable to or from
 		//          the YAML file based on the specified serialization option. If the option is set to save to file,
 		//          it serializes each element of the vector individually and writes them to the YAML file. If the option
@@ -145,78 +154,27 @@ namespace AT::serializer {
 
 			} else {		// load from file
 
-				// buffer [m_key_value_pares] for duration of function
-				std::unordered_map<std::string, std::string> key_value_pares_buffer = m_key_value_pares;
-				std::vector<std::unordered_map<std::string, std::string>> vector_of_key_value_pares{};
-				m_key_value_pares = {};
-
-				// buffer [m_file_content] for duration of function
-				std::stringstream file_content_buffer;
-				std::vector<std::stringstream> vector_of_file_content{};		// for array element in file
-				file_content_buffer << m_file_content.str();
-				m_file_content = {};
-
-				// deserialize content of subsections				
-				int64 index = -1;
-				std::string line;
-				while (std::getline(file_content_buffer, line)) {
-
-					// skip empty lines or comments
-					if (line.empty() || line.front() == '#')
-						continue;
-
-					// if line contains desired section enter inner-loop
-					//   has correct indentaion              has correct vector_name                          ends with double-point
-					if ((util::measure_indentation(line, NUM_OF_INDENTING_SPACES) == 0) && (line.find(vector_name) != std::string::npos) && (line.back() == ':')) {
-
-						//     not end of content
-						while (std::getline(file_content_buffer, line)) {
-
-							if (line.front() == '-') {
-
-								vector_of_key_value_pares.push_back({});
-								vector_of_file_content.push_back({});
-								index++;
-							}
-
-							// remove array-prefix "- " or "  "
-							line = line.substr(NUM_OF_INDENTING_SPACES);
+				std::string_view block{};
+				u32 header_column = 0;
+				if (find_block(vector_name, block, header_column)) {
 
-							//  more indented                                        beginning of new sub-section
-							if (util::measure_indentation(line, NUM_OF_INDENTING_SPACES) != 0 || line.back() == ':' || line.front() == '-') {
+					// count elements first so [vector] is resized once
+					u64 count = 0;
+					std::string_view item{};
+					int64 item_column = -1;
+					for (std::string_view remaining = block; next_item(remaining, item, item_column); )
+						count++;
 
-								//m_file_content << line << "\n";
-								vector_of_file_content[index] << line << "\n";
-								continue;
-							}
+					vector.resize(count);
+					item_column = -1;
+					for (u64 x = 0; next_item(block, item, item_column); x++) {
 
-							std::string key, value;
-							extract_key_value(key, value, line);
-							vector_of_key_value_pares[index][key] = value;
-						}
-					}
-				}
-
-				ASSERT(vector_of_key_value_pares.size() == vector_of_file_content.size(), "", "two buffers are of diffrent size");
-
-				if (vector_of_key_value_pares.size() > 0) {
-
-					vector.resize(vector_of_key_value_pares.size());
-					for (u64 x = 0; x < vector.size(); x++) {
-
-						m_key_value_pares = vector_of_key_value_pares[x];
-						m_file_content = {};
-						auto temp_buffer = vector_of_file_content[x].str();
-						m_file_content << temp_buffer;
+						// every element is its own scope, its keys start 2 columns after the "- " marker
+						push_scope(item, static_cast<u32>(item_column) + NUM_OF_INDENTING_SPACES, item_column);
 						vector_function(*this, x);
+						pop_scope();
 					}
 				}
-
-				// restore
-				m_key_value_pares = key_value_pares_buffer;
-				auto temp_buffer = file_content_buffer.str();
-				m_file_content << temp_buffer;
-
 			}
 
 			if (vector_func_index != 1)
@@ -251,34 +209,25 @@ namespace AT::serializer {
 				
 			} else {																					// Deserialize the map
 				
-				// Deserialize map from YAML
-				std::unordered_map<std::string, std::string> temp_map;
-				std::string line;
-				
-				// Read until we find the map section
-				while (std::getline(m_file_content, line)) {
-					if (line.find(map_name + ":") != std::string::npos && 
-						util::measure_indentation(line) == m_level_of_indention) {
-						break;
-					}
-				}
+				std::string_view block{};
+				u32 header_column = 0;
+				if (!find_block(map_name, block, header_column))
+					return *this;
 
-				while (std::getline(m_file_content, line)) {							// Read key-value pairs
-					if (util::measure_indentation(line) <= m_level_of_indention)		// End of map section
-						break;
-					
-					std::string key, value;
-					extract_key_value(key, value, line);
-					temp_map.emplace(std::move(key), std::move(value));
-				}
+				std::string_view line{};
+				while (next_line(block, line)) {										// Read key-value pairs
 
-				// Convert strings to actual types
-				for (const auto& [key_str, value_str] : temp_map) {
-					T key;
-					K value;
-					util::convert_from_string(key_str, key);
-					util::convert_from_string(value_str, value);
-					map.emplace(std::move(key), std::move(value));
+					std::string_view key{}, value{};
+					if (!split_key_value(line, key, value))
+						continue;
+
+					T key_buffer{};
+					K value_buffer{};
+					m_value_buffer.assign(key);
+					util::convert_from_string(m_value_buffer, key_buffer);
+					m_value_buffer.assign(value);
+					util::convert_from_string(m_value_buffer, value_buffer);
+					map.emplace(std::move(key_buffer), std::move(value_buffer));
 				}
 			}
 			return *this;
@@ -309,27 +258,20 @@ namespace AT::serializer {
 				}
 			} else {																	// Deserialize the set from YAML
 
-				std::unordered_set<T> temp_set;
-				std::string line;
-				while (std::getline(m_file_content, line)) {							// Read until we find the set section
-					if (line.find(set_name + ":") != std::string::npos && 
-						util::measure_indentation(line) == m_level_of_indention) {
-						break;
-					}
-				}
+				std::string_view block{};
+				u32 header_column = 0;
+				if (!find_block(set_name, block, header_column))
+					return *this;
 
-				while (std::getline(m_file_content, line)) {							// Read sequence elements
-					if (util::measure_indentation(line) <= m_level_of_indention) 		// End of set section
-						break;
-					
-					if (line.find("- ") != std::string::npos) {							// Extract element value
-
-						size_t dash_pos = line.find("- ");
-						std::string element_str = line.substr(dash_pos + 2);
-						T element;
-						util::convert_from_string(element_str, element);
-						temp_set.insert(element);
-					}
+				std::unordered_set<T> temp_set;
+				std::string_view item{};
+				int64 item_column = -1;
+				while (next_item(block, item, item_column)) {							// Read sequence elements
+
+					T element{};
+					m_value_buffer.assign(first_item_line(item));
+					util::convert_from_string(m_value_buffer, element);
+					temp_set.insert(element);
 				}
 				set = std::move(temp_set);
 			}
@@ -339,9 +281,37 @@ namespace AT::serializer {
 		
 	private:
 
+		// A block of the loaded file that is currently being read (the section, a sub_section or a vector element).
+		// Its direct key/value pairs are indexed in [keys]; the keys and values are views into [m_source].
+		struct scope {
+			std::string_view							content{};				// lines of the block, view into [m_source]
+			u32											indentation = 0;		// column of the direct children
+			int64										item_column = -1;		// column of the "- " marker for vector elements, -1 otherwise
+			util::flat_string_map<std::string_view>		keys{};
+		};
+
 		void serialize();
 		yaml& deserialize();
-		void extract_key_value(std::string& key, std::string& value, std::string& line);
+
+		// Enters a nested block and indexes its direct key/value pairs. Tables of previously left
+		// scopes are reused, so walking many vector elements does not allocate.
+		void push_scope(const std::string_view content, const u32 indentation, const int64 item_column);
+		void pop_scope();
+
+		// Searches the current scope for the header line "[name]:" and returns the lines that belong to it.
+		bool find_block(const std::string_view name, std::string_view& block, u32& header_column) const;
+
+		// Removes the first line (without new-line and trailing '\r' characters) from [text].
+		static bool next_line(std::string_view& text, std::string_view& line);
+
+		// Removes the next sequence element from [block]. The first call detects the column of the "- " markers.
+		static bool next_item(std::string_view& block, std::string_view& item, int64& item_column);
+
+		// Returns the text of the first line of [item] after its "- " marker.
+		static std::string_view first_item_line(std::string_view item);
+
+		// Splits "key: value" at the first ':', removing indentation and one space after the separator.
+		static bool split_key_value(std::string_view line, std::string_view& key, std::string_view& value);
 
 		static const u32 NUM_OF_INDENTING_SPACES = 2;		// should not change
 
@@ -353,15 +323,32 @@ namespace AT::serializer {
 		// file data
 		std::filesystem::path m_filename{};
 		std::ofstream m_ostream{};
-		std::ifstream m_istream{};
 		
 		// content data
 		bool m_is_correct_struct = false;
 		std::string m_name{};
 		option m_option;
-		std::stringstream m_file_content{};
-		std::unordered_map<std::string, std::string> m_key_value_pares{};
+		std::stringstream m_file_content{};				// new content of the section (save_to_file)
+		std::string m_source{};							// the whole file (load_from_file)
+		std::vector<scope> m_scopes{};					// [0] is the section, deeper entries are reused
+		u32 m_scope_depth = 0;
+		std::string m_value_buffer{};					// reused for string conversion of loaded values
 
 	};
 
+
+	// @brief One section to load with [load_many]: the file, the section name and the function that reads its entries.
+	struct load_job {
+		std::filesystem::path						filename{};
+		std::string									section_name{};
+		std::function<void(serializer::yaml&)>		load_function{};
+	};
+
+	// @brief Loads independent sections in parallel on a small thread pool and returns when all jobs are finished.
+	//          Every job opens its own [yaml] loader, so jobs must only write to data that no other job touches.
+	//          A single job is loaded on the calling thread.
+	// @param [jobs] The sections to load.
+	// @param [max_threads] Upper limit for the number of worker threads.
+	void load_many(const std::vector<load_job>& jobs, const u32 max_threads = 4);
+
 }
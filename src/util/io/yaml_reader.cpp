@@ -0,0 +1,200 @@
+
+#include "util/pch.h"
+
+#include "yaml_reader.h"
+
+namespace AT::serializer {
+
+	yaml_reader::yaml_reader(const std::filesystem::path& filename, const size_t buffer_size)
+		: m_buffer_size(buffer_size) {
+
+		m_stream = std::ifstream(filename, std::ios::in | std::ios::binary);
+		VALIDATE(m_stream.is_open(), m_failed = true; return, "", "Failed to open file: [" << filename << "]");
+
+		m_buffer = std::make_unique<char[]>(m_buffer_size);
+		m_blocks.reserve(16);
+		m_pending.reserve(16);
+	}
+
+
+	yaml_reader::event yaml_reader::next() {
+
+		while (m_pending_index >= m_pending.size()) {
+
+			if (m_failed)
+				return event::error;
+
+			m_pending.clear();
+			m_pending_index = 0;
+
+			std::string_view line;
+			if (read_line(line)) {
+
+				process_line(line);
+				continue;
+			}
+
+			if (m_failed)
+				return event::error;
+
+			if (m_blocks.empty()) {					// end of file and every block closed
+
+				m_text = {};
+				return event::document_end;
+			}
+
+			while (!m_blocks.empty()) {				// close remaining blocks at end of file
+
+				push_event(event::end);
+				m_blocks.pop_back();
+			}
+		}
+
+		const pending_event& current = m_pending[m_pending_index++];
+		m_text = current.text;
+		return current.type;
+	}
+
+
+	bool yaml_reader::read_line(std::string_view& line) {
+
+		size_t search_start = m_begin;
+		while (true) {
+
+			if (const char* new_line = static_cast<const char*>(std::memchr(m_buffer.get() + search_start, '\n', m_end - search_start))) {
+
+				const size_t line_end = static_cast<size_t>(new_line - m_buffer.get());
+				line = std::string_view(m_buffer.get() + m_begin, line_end - m_begin);
+				m_begin = line_end + 1;
+				m_line_number++;
+				return true;
+			}
+
+			if (m_eof) {							// last line without trailing new-line
+
+				if (m_begin == m_end)
+					return false;
+
+				line = std::string_view(m_buffer.get() + m_begin, m_end - m_begin);
+				m_begin = m_end;
+				m_line_number++;
+				return true;
+			}
+
+			// move the unfinished line to the front and refill the rest of the buffer
+			if (m_begin > 0) {
+
+				std::memmove(m_buffer.get(), m_buffer.get() + m_begin, m_end - m_begin);
+				m_end -= m_begin;
+				m_begin = 0;
+			}
+			search_start = m_end;
+
+			VALIDATE(m_end < m_buffer_size, m_failed = true; return false, "", "Line [" << m_line_number + 1 << "] is longer than the read buffer [" << m_buffer_size << " bytes]");
+
+			m_stream.read(m_buffer.get() + m_end, static_cast<std::streamsize>(m_buffer_size - m_end));
+			const size_t bytes_read = static_cast<size_t>(m_stream.gcount());
+			m_end += bytes_read;
+			if (bytes_read == 0 || m_stream.eof())
+				m_eof = true;
+		}
+	}
+
+
+	void yaml_reader::process_line(std::string_view line) {
+
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		u32 column = 0;
+		while (column < line.size() && line[column] == ' ')
+			column++;
+
+		line.remove_prefix(column);
+		if (line.empty() || line.front() == '#')								// skip empty lines or comments
+			return;
+
+		auto is_item = [](const std::string_view text) { return text == "-" || text.starts_with("- "); };
+		close_blocks(column, is_item(line));
+
+		while (is_item(line)) {													// "- " opens a sequence item, its content starts 2 columns further in
+
+			push_event(event::sequence_item);
+			line.remove_prefix(std::min<size_t>(2, line.size()));
+			u32 extra_spaces = 0;
+			while (extra_spaces < line.size() && line[extra_spaces] == ' ')
+				extra_spaces++;
+
+			line.remove_prefix(extra_spaces);
+			m_blocks.push_back({ column, line.empty() ? -1 : static_cast<int64>(column + 2 + extra_spaces), true });
+			column += 2 + extra_spaces;
+
+			if (line.empty())													// item content starts on the next line
+				return;
+		}
+
+		// find the key separator: a ':' followed by a space or at the end of the line
+		size_t separator = line.find(':');
+		while (separator != std::string_view::npos && separator + 1 < line.size() && line[separator + 1] != ' ')
+			separator = line.find(':', separator + 1);
+
+		if (separator == std::string_view::npos) {
+
+			push_event(event::scalar, line);
+			return;
+		}
+
+		std::string_view key = line.substr(0, separator);
+		while (!key.empty() && key.back() == ' ')
+			key.remove_suffix(1);
+
+		std::string_view value = line.substr(separator + 1);
+		while (!value.empty() && value.front() == ' ')
+			value.remove_prefix(1);
+
+		// "key:" or "key:  # comment" opens a block, "key: " is an empty value
+		const bool opens_block = (separator + 1 == line.size()) || (!value.empty() && value.front() == '#');
+		push_event(event::key, key);
+		if (opens_block) {
+
+			push_event(event::mapping_start);
+			m_blocks.push_back({ column, -1, false });
+
+		} else
+			push_event(event::scalar, value);
+	}
+
+
+	void yaml_reader::close_blocks(const u32 column, const bool is_item) {
+
+		while (!m_blocks.empty()) {
+
+			block& top = m_blocks.back();
+			if (top.child_column < 0) {											// first line after the opener decides the child column
+
+				//  more indented                  OR  sequence written at the same column as its key
+				if (column > top.opener_column || (column == top.opener_column && is_item && !top.is_item)) {
+
+					top.child_column = column;
+					return;
+				}
+
+			} else {
+
+				const bool same_column_sequence = (top.child_column == static_cast<int64>(top.opener_column));
+				if (column > top.child_column)
+					return;
+
+				if (column == top.child_column && (!same_column_sequence || is_item))
+					return;
+			}
+
+			push_event(event::end);
+			m_blocks.pop_back();
+		}
+	}
+
+
+	void yaml_reader::push_event(const event type, const std::string_view text) { m_pending.push_back({ type, text }); }
+
+}
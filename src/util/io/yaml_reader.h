@@ -0,0 +1,95 @@
+#pragma once
+
+#include "serializer_data.h"
+
+namespace AT::serializer {
+
+	// SAX-style pull parser for the YAML subset written by [serializer::yaml].
+	// The document is read through a fixed-size buffer and never fully loaded, so memory stays constant
+	// regardless of document size. Each call to next() returns one event; the text of [key] and [scalar]
+	// events is a view into the internal buffer that stays valid until the next call to next().
+	//
+	// For the document:
+	//   section:
+	//     key: value
+	//     list:
+	//     - a
+	// the events are: key(section) mapping_start key(key) scalar(value) key(list) mapping_start
+	//                 sequence_item scalar(a) end end end document_end
+	class yaml_reader {
+	public:
+
+		enum class event : u8 {
+			mapping_start,		// the previous [key] opens a nested block (mapping or sequence)
+			key,				// a key, text is the key name
+			scalar,				// a value, text is the raw value (belongs to the previous [key] or [sequence_item])
+			sequence_item,		// a "- " element starts, its content follows until the matching [end]
+			end,				// closes the innermost [mapping_start] or [sequence_item]
+			document_end,		// no more events, returned for every following call
+			error,				// a line did not fit into the read buffer or the file could not be read
+		};
+
+		static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+		// Opens [filename] for reading. Nothing is parsed until the first call to next().
+		// @param filename The YAML file to read.
+		// @param buffer_size Size of the read buffer in bytes, also the maximum supported line length.
+		yaml_reader(const std::filesystem::path& filename, const size_t buffer_size = DEFAULT_BUFFER_SIZE);
+		~yaml_reader() = default;
+
+		DELETE_COPY_MOVE_CONSTRUCTOR(yaml_reader);
+
+		// Returns whether the file could be opened.
+		bool is_open() const									{ return m_stream.is_open(); }
+
+		// Advances to the next event.
+		// @return The next event, [document_end] once the whole file has been consumed.
+		event next();
+
+		// Returns the text of the last [key] or [scalar] event. Valid until the next call to next().
+		std::string_view get_text() const						{ return m_text; }
+
+		// Returns the nesting depth of the last event (number of currently open blocks).
+		u32 get_depth() const									{ return static_cast<u32>(m_blocks.size()); }
+
+		// Returns the 1-based line number of the last line that was read.
+		u64 get_line() const									{ return m_line_number; }
+
+		// Converts the last [scalar] text into [value] using the same rules as [serializer::yaml::entry].
+		template<typename T>
+		void get_value(T& value) const							{ util::convert_from_string(std::string(m_text), value); }
+
+	private:
+
+		struct block {
+			u32					opener_column;			// column of the key or "- " marker that opened this block
+			int64				child_column;			// column of the direct children, -1 while unknown
+			bool				is_item;				// opened by a sequence item instead of a key
+		};
+
+		struct pending_event {
+			event				type;
+			std::string_view	text;
+		};
+
+		bool read_line(std::string_view& line);
+		void process_line(std::string_view line);
+		void close_blocks(const u32 column, const bool is_item);
+		void push_event(const event type, const std::string_view text = {});
+
+		std::ifstream					m_stream{};
+		std::unique_ptr<char[]>			m_buffer{};
+		size_t							m_buffer_size = 0;
+		size_t							m_begin = 0;				// start of unconsumed data in [m_buffer]
+		size_t							m_end = 0;					// end of valid data in [m_buffer]
+		bool							m_eof = false;
+		bool							m_failed = false;
+		u64								m_line_number = 0;
+
+		std::vector<block>				m_blocks{};					// open blocks, innermost last
+		std::vector<pending_event>		m_pending{};				// events produced by the current line
+		size_t							m_pending_index = 0;
+		std::string_view				m_text{};
+	};
+
+}
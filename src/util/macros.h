@@ -13,6 +13,23 @@
 #endif
 
 
+// ---------------------------------------------------------------------------------------------------------------------------------------
+// variadic helpers
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+// Applies [macro] to every following argument and joins the results with commas (supports up to 256 arguments)
+// e.g. MACRO_FOR_EACH(F, a, b, c)  =>  F(a), F(b), F(c)
+#define MACRO_FOR_EACH(macro, ...)								__VA_OPT__(MACRO_EXPAND(MACRO_FOR_EACH_HELPER(macro, __VA_ARGS__)))
+#define MACRO_FOR_EACH_HELPER(macro, first, ...)				macro(first) __VA_OPT__(, MACRO_FOR_EACH_AGAIN MACRO_PARENS (macro, __VA_ARGS__))
+#define MACRO_FOR_EACH_AGAIN()									MACRO_FOR_EACH_HELPER
+#define MACRO_PARENS											()
+
+#define MACRO_EXPAND(...)										MACRO_EXPAND_4(MACRO_EXPAND_4(MACRO_EXPAND_4(MACRO_EXPAND_4(__VA_ARGS__))))
+#define MACRO_EXPAND_4(...)										MACRO_EXPAND_3(MACRO_EXPAND_3(MACRO_EXPAND_3(MACRO_EXPAND_3(__VA_ARGS__))))
+#define MACRO_EXPAND_3(...)										MACRO_EXPAND_2(MACRO_EXPAND_2(MACRO_EXPAND_2(MACRO_EXPAND_2(__VA_ARGS__))))
+#define MACRO_EXPAND_2(...)										MACRO_EXPAND_1(MACRO_EXPAND_1(MACRO_EXPAND_1(MACRO_EXPAND_1(__VA_ARGS__))))
+#define MACRO_EXPAND_1(...)										__VA_ARGS__
+
 // ---------------------------------------------------------------------------------------------------------------------------------------
 // implisite casting
 // ---------------------------------------------------------------------------------------------------------------------------------------
@@ -902,8 +902,9 @@ namespace AT::UI {
 		std::string buffer = search_text;
 		buffer.resize(256);
 
+		// reports every edit, so results can follow the typing
 		ImGui::SetNextItemAllowOverlap();
-		if (ImGui::InputTextWithHint(label, "Search", buffer.data(), 255, ImGuiInputTextFlags_EnterReturnsTrue)) {
+		if (ImGui::InputTextWithHint(label, "Search", buffer.data(), 255)) {
 
 			buffer.resize(strlen(buffer.c_str()));
 			search_text = buffer;
@@ -920,6 +921,7 @@ namespace AT::UI {
 
 				LOG(Trace, "Trigger clear button")
 				search_text = "";
+				return true;
 			}
 		}
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "util/pch.h"
+#include "util/data_structures/string_manipulation.h"
+
+// Reference copy of the line-based section parser [serializer::yaml] used before keys were indexed in
+// [util::flat_string_map]. Only used by the differential fuzz driver, which compares its key/value results
+// against the current parser on the stored corpus. Kept as close to the original as possible, so do not "fix" it.
+namespace AT::fuzz::legacy {
+
+    // @brief Mirrors the old [yaml::extract_key_value].
+    inline void extract_key_value(std::string& key, std::string& value, const std::string& line) {
+
+        std::istringstream iss(line);
+        std::getline(iss, key, ':');
+        std::getline(iss, value);
+
+        if (const u32 indentation = util::measure_indentation(key, 1); indentation > 0)
+            key = key.substr(indentation);
+
+        if (!value.empty() && value.front() == ' ')
+            value.erase(0, 1);
+    }
+
+    // @brief Mirrors the old [yaml::deserialize]: returns the direct key/value pairs of [section_name].
+    // @param [content] The whole YAML document.
+    // @param [section_name] The top-level section to read.
+    // @return The key/value pairs of the section, empty if the section is missing.
+    inline std::unordered_map<std::string, std::string> parse_section(const std::string& content, const std::string& section_name) {
+
+        constexpr u32 NUM_OF_INDENTING_SPACES = 2;
+        constexpr u32 SECTION_INDENTATION = 0;
+
+        std::unordered_map<std::string, std::string> key_value_pares{};
+        std::istringstream stream(content);
+        bool found_section = false;
+        std::string line;
+        while (std::getline(stream, line)) {
+
+            if (line.empty() || line.front() == '#')
+                continue;
+
+            if (line.find(section_name + ":") != std::string::npos && util::measure_indentation(line, NUM_OF_INDENTING_SPACES) == 0) {
+
+                found_section = true;
+                while (std::getline(stream, line) && (util::measure_indentation(line, NUM_OF_INDENTING_SPACES) > SECTION_INDENTATION)) {
+
+                    line = line.substr(NUM_OF_INDENTING_SPACES);
+                    if (line.empty())                       // the original called line.back() here (undefined behavior)
+                        continue;
+
+                    if ((util::measure_indentation(line, NUM_OF_INDENTING_SPACES) > SECTION_INDENTATION) || line.back() == ':' || line.front() == '-')
+                        continue;
+
+                    std::string key, value;
+                    extract_key_value(key, value, line);
+                    key_value_pares[key] = value;
+                }
+            }
+
+            if (found_section)
+                break;
+        }
+        return key_value_pares;
+    }
+
+}
@@ -0,0 +1,380 @@
+
+// Fuzz and differential test harness for [serializer::yaml].
+//
+// Built with clang and -fsanitize=fuzzer (define AT_LIBFUZZER) this file is a libFuzzer target. Otherwise it
+// is a deterministic driver that runs a seeded random corpus, compares the current parser against the legacy
+// reference parser on the stored corpus and reports the parse time of both:
+//
+//   yaml_fuzz [iterations] [seed] [corpus_directory]
+//
+// Every input is checked in one of two ways (selected by the first byte):
+//   - structured: the bytes drive the generation of a [fuzz_project], which is saved, loaded and compared.
+//   - raw:        the bytes are used as a YAML document, the loaded [fuzz_project] is saved and loaded again
+//                 and both loads have to match (the parser must not crash and loading must be idempotent).
+
+#include "util/pch.h"
+#include "util/io/io.h"
+#include "util/io/serializer_yaml.h"
+#include "util/timing/stopwatch.h"
+
+#include "legacy_yaml_parser.h"
+
+namespace AT::fuzz {
+
+    // ================================================== data ==================================================
+
+    struct fuzz_module {
+        std::string                 name{};
+        u64                         id = 0;
+        bool                        enabled = false;
+        std::vector<std::string>    files{};
+
+        bool operator==(const fuzz_module&) const = default;
+    };
+
+    // Mirrors the shape of [project_data]: reflected fields, an inline list, a sub_section and a vector of sections.
+    struct fuzz_project {
+        u64                         ID = 0;
+        std::string                 name{};
+        std::string                 display_name{};
+        std::string                 description{};
+        std::filesystem::path       project_path{};
+        int64                       project_version = 0;
+        f32                         scale = 0.f;
+        bool                        favorite = false;
+        std::vector<std::string>    tags{};
+        u32                         width = 0;
+        u32                         height = 0;
+        std::string                 start_world{};
+        std::vector<fuzz_module>    modules{};
+
+        SERIALIZABLE(fuzz_project, ID, name, display_name, description, project_path, project_version, scale, favorite);
+
+        bool operator==(const fuzz_project& other) const {
+
+            const f32 tolerance = 1e-5f + std::abs(scale) * 1e-6f;          // [scale] is written with 6 decimals
+            return ID == other.ID && name == other.name && display_name == other.display_name && description == other.description
+                && project_path == other.project_path && project_version == other.project_version && std::abs(scale - other.scale) <= tolerance
+                && favorite == other.favorite && tags == other.tags && width == other.width && height == other.height
+                && start_world == other.start_world && modules == other.modules;
+        }
+    };
+
+    static void serialize(const std::filesystem::path& file, fuzz_project& data, const serializer::option option) {
+
+        serializer::yaml(file, "project_data", option)
+            .fields(data)
+            .entry("tags", data.tags)
+            .sub_section("settings", [&](serializer::yaml& section) {
+                section.entry("width", data.width)
+                    .entry("height", data.height)
+                    .entry("start_world", data.start_world);
+            })
+            .vector("modules", data.modules, [&](serializer::yaml& element, const u64 x) {
+                element.entry("name", data.modules[x].name)
+                    .entry("id", data.modules[x].id)
+                    .entry("enabled", data.modules[x].enabled)
+                    .entry("files", data.modules[x].files);
+            });
+    }
+
+    // ================================================== input ==================================================
+
+    // Consumes the fuzz input byte by byte, returns zeros once it is exhausted.
+    class byte_reader {
+    public:
+
+        byte_reader(const u8* data, const size_t size)
+            : m_data(data), m_size(size) {}
+
+        u64 next(const u64 max) {
+
+            u64 value = 0;
+            for (u64 range = max; range > 0 && m_position < m_size; range >>= 8)
+                value = (value << 8) | m_data[m_position++];
+            return (max == std::numeric_limits<u64>::max()) ? value : value % (max + 1);
+        }
+
+        // Strings the format can represent: no '$' (it encodes new-lines), no '\r' and no trailing ':' (would read as a section header)
+        std::string next_string(const u64 max_length) {
+
+            static constexpr std::string_view CHARSET = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 -_:#./\\\"'\t\n{}[]!?%&*";
+            std::string result(static_cast<size_t>(next(max_length)), ' ');
+            for (auto& character : result)
+                character = CHARSET[next(CHARSET.size() - 1)];
+
+            while (!result.empty() && result.back() == ':')
+                result.pop_back();
+            return result;
+        }
+
+    private:
+
+        const u8*       m_data;
+        size_t          m_size;
+        size_t          m_position = 0;
+    };
+
+    static fuzz_project generate_project(byte_reader& input) {
+
+        fuzz_project project{};
+        project.ID = input.next(std::numeric_limits<u64>::max());
+        project.name = input.next_string(24);
+        project.display_name = input.next_string(32);
+        project.description = input.next_string(120);
+        project.project_path = "/home/user/projects/" + std::to_string(input.next(9999)) + "/project.gltproj";
+        project.project_version = static_cast<int64>(input.next(2'000'000)) - 1'000'000;
+        project.scale = static_cast<f32>(static_cast<int64>(input.next(8000)) - 4000) * 0.25f;
+        project.favorite = input.next(1) == 1;
+        project.tags.resize(static_cast<size_t>(input.next(6)));
+        for (auto& tag : project.tags)
+            tag = input.next_string(12);
+
+        project.width = static_cast<u32>(input.next(8192));
+        project.height = static_cast<u32>(input.next(8192));
+        project.start_world = input.next_string(40);
+        project.modules.resize(static_cast<size_t>(input.next(4)));
+        for (auto& module : project.modules) {
+
+            module.name = input.next_string(16);
+            module.id = input.next(std::numeric_limits<u32>::max());
+            module.enabled = input.next(1) == 1;
+            module.files.resize(static_cast<size_t>(input.next(3)));
+            for (auto& file : module.files)
+                file = input.next_string(20);
+        }
+        return project;
+    }
+
+    // ================================================== checks ==================================================
+
+    static const std::filesystem::path s_input_file = std::filesystem::temp_directory_path() / "at_yaml_fuzz_input.yml";
+    static const std::filesystem::path s_output_file = std::filesystem::temp_directory_path() / "at_yaml_fuzz_output.yml";
+
+    static void write_document(const std::filesystem::path& file, const std::string_view content) {
+
+        std::ofstream stream(file, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    static fuzz_project round_trip(fuzz_project& data) {
+
+        std::filesystem::remove(s_output_file);
+        serialize(s_output_file, data, serializer::option::save_to_file);
+
+        fuzz_project loaded{};
+        serialize(s_output_file, loaded, serializer::option::load_from_file);
+        return loaded;
+    }
+
+    static void report_failure(const char* check, const std::string_view input) {
+
+        std::cerr << "[yaml_fuzz] " << check << " failed for input (" << input.size() << " bytes):\n" << input << "\n--- written document:\n" << io::read_file(s_output_file) << std::endl;
+        std::abort();
+    }
+
+    // @brief Runs the structured or raw check for one input, aborts on a mismatch.
+    static void run_one(const u8* data, const size_t size) {
+
+        if (size == 0)
+            return;
+
+        if ((data[0] & 1) == 0) {                                       // structured round trip
+
+            byte_reader input(data + 1, size - 1);
+            fuzz_project original = generate_project(input);
+            if (!(round_trip(original) == original))
+                report_failure("structured round trip", std::string_view(reinterpret_cast<const char*>(data), size));
+
+        } else {                                                        // raw document, load must be idempotent
+
+            const std::string_view document(reinterpret_cast<const char*>(data + 1), size - 1);
+            write_document(s_input_file, document);
+
+            fuzz_project first{};
+            serialize(s_input_file, first, serializer::option::load_from_file);
+            if (!(round_trip(first) == first))
+                report_failure("raw document reload", document);
+        }
+    }
+
+    // ================================================== differential ==================================================
+
+    // @brief Compares the current parser against the legacy parser for every top-level section and key of [document].
+    // @return The number of keys whose values differ.
+    static u32 compare_with_legacy(const std::filesystem::path& file, const std::string& document) {
+
+        std::vector<std::string> sections{};
+        std::unordered_set<std::string> candidate_keys{};
+        std::istringstream stream(document);
+        for (std::string line; std::getline(stream, line); ) {
+
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (!line.empty() && line.front() != ' ' && line.front() != '#' && line.back() == ':')
+                sections.push_back(line.substr(0, line.size() - 1));
+
+            const size_t begin = line.find_first_not_of(" -");
+            const size_t separator = line.find(':');
+            if (begin != std::string::npos && separator != std::string::npos && separator > begin)
+                candidate_keys.insert(line.substr(begin, separator - begin));
+        }
+
+        u32 mismatches = 0;
+        for (const auto& section : sections) {
+
+            const auto legacy_values = legacy::parse_section(document, section);
+            serializer::yaml loader(file, section, serializer::option::load_from_file);
+            for (const auto& key : candidate_keys) {
+
+                static const std::string NOT_FOUND = "<not found>";
+                std::string current_value = NOT_FOUND;
+                loader.entry(key, current_value);
+
+                const auto legacy_iterator = legacy_values.find(key);
+                const std::string legacy_value = (legacy_iterator == legacy_values.end()) ? NOT_FOUND : util::from_string<std::string>(legacy_iterator->second);
+                if (current_value == legacy_value)
+                    continue;
+
+                mismatches++;
+                std::cerr << "[yaml_fuzz] " << file.filename().generic_string() << " [" << section << "." << key << "]: legacy [" << legacy_value << "] current [" << current_value << "]" << std::endl;
+            }
+        }
+        return mismatches;
+    }
+
+    // @brief Measures the average time both parsers need to read every section of [document].
+    static void measure_parse_time(const std::filesystem::path& file, const std::string& document, f32& legacy_time, f32& current_time) {
+
+        constexpr u32 REPETITIONS = 200;
+        std::vector<std::string> sections{};
+        std::istringstream stream(document);
+        for (std::string line; std::getline(stream, line); )
+            if (!line.empty() && line.front() != ' ' && line.front() != '#' && line.back() == ':')
+                sections.push_back(line.substr(0, line.size() - 1));
+
+        {
+            util::stopwatch timer(&legacy_time);
+            for (u32 x = 0; x < REPETITIONS; x++)
+                for (const auto& section : sections)
+                    legacy::parse_section(io::read_file(file), section);              // the legacy parser read the file for every section
+        }
+        {
+            util::stopwatch timer(&current_time);
+            for (u32 x = 0; x < REPETITIONS; x++)
+                for (const auto& section : sections)
+                    serializer::yaml(file, section, serializer::option::load_from_file);
+        }
+        legacy_time /= REPETITIONS;
+        current_time /= REPETITIONS;
+    }
+
+}
+
+
+#if defined(AT_LIBFUZZER)
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+
+    AT::fuzz::run_one(data, size);
+    return 0;
+}
+
+#else
+
+int main(int argc, char* argv[]) {
+
+    using namespace AT;
+
+    const u64 iterations = (argc > 1) ? std::stoull(argv[1]) : 5000;
+    const u64 seed = (argc > 2) ? std::stoull(argv[2]) : 42;
+    const std::filesystem::path corpus_directory = (argc > 3) ? std::filesystem::path(argv[3]) : std::filesystem::path(__FILE__).parent_path() / "corpus";
+
+    std::vector<std::filesystem::path> corpus_files{};
+    std::vector<std::string> corpus{};
+    std::error_code error_code;
+    if (std::filesystem::is_directory(corpus_directory, error_code))
+        for (const auto& entry : std::filesystem::directory_iterator(corpus_directory, error_code))
+            if (entry.is_regular_file()) {
+                corpus_files.push_back(entry.path());
+                corpus.push_back(io::read_file(entry.path()));
+            }
+
+    // ---------------------------------- seeded random inputs ----------------------------------
+    std::mt19937_64 generator(seed);
+    std::vector<u8> input{};
+    f32 fuzz_time = 0.f;
+    {
+        util::stopwatch timer(&fuzz_time);
+        for (u64 x = 0; x < iterations; x++) {
+
+            const u64 mode = generator() % 3;
+            input.clear();
+            if (mode == 0) {                                            // random bytes for structured or raw checks
+
+                input.resize(static_cast<size_t>(generator() % 512));
+                for (auto& byte : input)
+                    byte = static_cast<u8>(generator());
+
+            } else if (mode == 1 || corpus.empty()) {                   // raw document built from YAML-like tokens
+
+                static constexpr std::array<std::string_view, 24> TOKENS = {
+                    "project_data:\n", "settings:", "modules:", "tags:", "files:", "name:", "ID:", "description:", "width:", "id:", "enabled:",
+                    "\n", "\n  ", "\n    ", "\n  - ", "\n    - ", "- ", " ", ": ", "#", "\r", "$", "value", "42" };
+                static constexpr std::string_view HEADER = "\1project_data:\n  ";
+                input.assign(HEADER.begin(), HEADER.end());
+                for (u64 count = generator() % 96; count > 0; count--) {
+
+                    const std::string_view token = TOKENS[generator() % TOKENS.size()];
+                    input.insert(input.end(), token.begin(), token.end());
+                }
+
+            } else {                                                    // mutated corpus document as raw input
+
+                const std::string& document = corpus[generator() % corpus.size()];
+                input.push_back(1);
+                input.insert(input.end(), document.begin(), document.end());
+                for (u64 mutations = generator() % 8; mutations > 0 && input.size() > 1; mutations--) {
+
+                    const size_t position = 1 + static_cast<size_t>(generator() % (input.size() - 1));
+                    switch (generator() % 4) {
+                        case 0:  input[position] = static_cast<u8>(generator()); break;
+                        case 1:  input.insert(input.begin() + static_cast<std::ptrdiff_t>(position), static_cast<u8>(" :-\n#"[generator() % 5])); break;
+                        case 2:  input.erase(input.begin() + static_cast<std::ptrdiff_t>(position)); break;
+                        default: input.insert(input.begin() + static_cast<std::ptrdiff_t>(position), 2, ' '); break;
+                    }
+                }
+            }
+
+            fuzz::run_one(input.data(), input.size());
+        }
+    }
+    std::cout << "[yaml_fuzz] " << iterations << " random inputs passed (seed " << seed << ") in " << fuzz_time << " ms" << std::endl;
+
+    // ---------------------------------- differential on stored corpus ----------------------------------
+    if (corpus.empty()) {
+
+        std::cout << "[yaml_fuzz] no corpus in [" << corpus_directory.generic_string() << "], skipping the differential pass" << std::endl;
+        return 0;
+    }
+
+    u32 mismatches = 0;
+    for (size_t x = 0; x < corpus.size(); x++) {
+
+        const std::filesystem::path& file = corpus_files[x];
+        const std::string& document = corpus[x];
+        mismatches += fuzz::compare_with_legacy(file, document);
+
+        f32 legacy_time = 0.f, current_time = 0.f;
+        fuzz::measure_parse_time(file, document, legacy_time, current_time);
+        std::cout << "[yaml_fuzz] " << std::left << std::setw(28) << file.filename().generic_string()
+            << " legacy: " << std::fixed << std::setprecision(4) << legacy_time << " ms   current: " << current_time << " ms"
+            << ((current_time > legacy_time * 1.25f) ? "   <= REGRESSION" : "") << std::endl;
+    }
+
+    std::cout << "[yaml_fuzz] differential: " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+#endif
@@ -11,10 +11,32 @@
 #include "util/io/serializer_data.h"
 #include "util/io/serializer_yaml.h"
 #include "util/io/serializer_binary.h"
+#include "util/io/compression.h"
+#include "util/io/checksum.h"
+#include "util/io/atomic_file_writer.h"
+#include "util/io/io.h"
+#include "util/io/file_watcher.h"
+#include "util/io/directory_crawler.h"
+#include "util/io/package.h"
+#include "util/io/config.h"
+#include "util/io/yaml_reader.h"
 #include "util/timing/stopwatch.h"
+#include "project/project_index.h"
+#include "project/project_search.h"
+#include "project/project_query.h"
+#include "project/project_store.h"
+#include "project/project_conflicts.h"
+#include "project/project_creator.h"
+#include "project/project_statistics.h"
+#include "project/project_archiver.h"
+#include "project/dependency_graph.h"
+#include "util/data_structures/string_pool.h"
+#include "util/data_structures/lru_list.h"
 
 #if PLATFORM_WINDOWS
     #include <numeric> 
+#elif PLATFORM_LINUX
+    #include <sys/resource.h>
 #endif
 
 
@@ -821,6 +843,202 @@ TEST_CASE("YAML Serializer - Non-Existing Keys", "[serializer][yaml]") {
     REQUIRE(loaded_missing == 100); // Should remain unchanged
 }
 
+TEST_CASE("YAML Serializer - Reflected Fields", "[serializer][yaml]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_fields.yml";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    struct reflected_data {
+        int                     count = 0;
+        f32                     scale = 0.f;
+        std::string             label{};
+        std::filesystem::path   path{};
+
+        SERIALIZABLE(reflected_data, count, scale, label, path);
+    } test_data{7, 1.5f, "reflected", "/some/path"}, loaded_data;
+
+    static_assert(std::tuple_size_v<decltype(reflected_data::serializable_fields())> == 4);
+    static_assert(std::get<1>(reflected_data::serializable_fields()).name == "scale");
+    static_assert(std::get<1>(reflected_data::serializable_fields()).hash == AT::util::hash_string("scale"));
+    static_assert(AT::util::variable_name("m_data.title") == "title");
+
+    {
+        AT::serializer::yaml(test_file, "reflected", AT::serializer::option::save_to_file)
+            .fields(test_data);
+    }
+
+    {   // keys written by [fields] are plain member names and can be read back with [entry]
+        int loaded_count = 0;
+        AT::serializer::yaml(test_file, "reflected", AT::serializer::option::load_from_file)
+            .fields(loaded_data)
+            .entry("count", loaded_count);
+        REQUIRE(loaded_count == test_data.count);
+    }
+
+    REQUIRE(loaded_data.count == test_data.count);
+    REQUIRE(loaded_data.scale == Catch::Approx(test_data.scale));
+    REQUIRE(loaded_data.label == test_data.label);
+    REQUIRE(loaded_data.path == test_data.path);
+}
+
+TEST_CASE("YAML Serializer - Nested Vectors", "[serializer][yaml]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_nested_vectors.yml";
+
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    struct element {
+        int                         id = 0;
+        std::vector<int>            numbers{};
+        std::vector<std::string>    tags{};
+    };
+    std::vector<element> test_elements = { {1, {1, 2, 3}, {"a", "b"}}, {2, {}, {"c"}}, {3, {4}, {}} };
+    std::vector<element> loaded_elements{};
+    int test_id = 99, loaded_id = 0;
+
+    {
+        AT::serializer::yaml serializer(test_file, "nested_vectors", AT::serializer::option::save_to_file);
+        serializer.vector("elements", test_elements, [&](AT::serializer::yaml& yaml, const u64 x) {
+            yaml.entry("id", test_elements[x].id)
+                .entry("numbers", test_elements[x].numbers)
+                .vector("tags", test_elements[x].tags, [&](AT::serializer::yaml& inner, const u64 y) {
+                    inner.entry("tag", test_elements[x].tags[y]);
+                });
+        })
+        .entry("id", test_id);                          // same key as inside the elements, must not be mixed up
+    }
+
+    {
+        AT::serializer::yaml serializer(test_file, "nested_vectors", AT::serializer::option::load_from_file);
+        serializer.vector("elements", loaded_elements, [&](AT::serializer::yaml& yaml, const u64 x) {
+            yaml.entry("id", loaded_elements[x].id)
+                .entry("numbers", loaded_elements[x].numbers)
+                .vector("tags", loaded_elements[x].tags, [&](AT::serializer::yaml& inner, const u64 y) {
+                    inner.entry("tag", loaded_elements[x].tags[y]);
+                });
+        })
+        .entry("id", loaded_id);
+    }
+
+    REQUIRE(loaded_id == test_id);
+    REQUIRE(loaded_elements.size() == test_elements.size());
+    for (size_t x = 0; x < test_elements.size(); x++) {
+        REQUIRE(loaded_elements[x].id == test_elements[x].id);
+        REQUIRE(loaded_elements[x].numbers == test_elements[x].numbers);
+        REQUIRE(loaded_elements[x].tags == test_elements[x].tags);
+    }
+}
+
+TEST_CASE("YAML Serializer - Load Many", "[serializer][yaml]") {
+    const std::filesystem::path first_file = std::filesystem::temp_directory_path() / "test_load_many_0.yml";
+    const std::filesystem::path second_file = std::filesystem::temp_directory_path() / "test_load_many_1.yml";
+    for (const auto& file : { first_file, second_file })
+        if (std::filesystem::exists(file))
+            std::filesystem::remove(file);
+
+    constexpr int NUM_SECTIONS = 8;
+    std::vector<int> test_values(NUM_SECTIONS), loaded_values(NUM_SECTIONS, -1);
+    std::vector<std::string> test_names(NUM_SECTIONS), loaded_names(NUM_SECTIONS);
+    for (int x = 0; x < NUM_SECTIONS; x++) {
+        test_values[x] = x * 11;
+        test_names[x] = "section_" + std::to_string(x);
+        AT::serializer::yaml(x % 2 ? second_file : first_file, test_names[x], AT::serializer::option::save_to_file)
+            .entry("value", test_values[x])
+            .entry("name", test_names[x]);
+    }
+
+    std::vector<AT::serializer::load_job> jobs{};
+    for (int x = 0; x < NUM_SECTIONS; x++)
+        jobs.push_back({ x % 2 ? second_file : first_file, test_names[x], [&, x](AT::serializer::yaml& yaml) {
+            yaml.entry("value", loaded_values[x])
+                .entry("name", loaded_names[x]);
+        }});
+
+    AT::serializer::load_many(jobs);
+
+    REQUIRE(loaded_values == test_values);
+    REQUIRE(loaded_names == test_names);
+}
+
+TEST_CASE("YAML Reader - Events", "[serializer][yaml]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_reader.yml";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    std::string test_string = "hello";
+    std::vector<int> test_vector = {1, 2};
+    {
+        AT::serializer::yaml(test_file, "reader_data", AT::serializer::option::save_to_file)
+            .entry("test_string", test_string)
+            .entry("test_vector", test_vector);
+    }
+
+    using event = AT::serializer::yaml_reader::event;
+    std::vector<std::pair<event, std::string>> expected = {
+        {event::key, "reader_data"}, {event::mapping_start, ""},
+            {event::key, "test_string"}, {event::scalar, "hello"},
+            {event::key, "test_vector"}, {event::mapping_start, ""},
+                {event::sequence_item, ""}, {event::scalar, "1"}, {event::end, ""},
+                {event::sequence_item, ""}, {event::scalar, "2"}, {event::end, ""},
+            {event::end, ""},
+        {event::end, ""},
+        {event::document_end, ""},
+    };
+
+    // tiny buffer to force lines across buffer refills
+    AT::serializer::yaml_reader reader(test_file, 32);
+    REQUIRE(reader.is_open());
+    for (const auto& [expected_event, expected_text] : expected) {
+        REQUIRE(reader.next() == expected_event);
+        REQUIRE(reader.get_text() == expected_text);
+    }
+    REQUIRE(reader.next() == event::document_end);
+}
+
+
+TEST_CASE("YAML Reader - Large Document Memory", "[.][benchmark][serializer][yaml]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_reader_large.yml";
+
+    const u64 target_size = 100ull * 1024 * 1024;                   // 100 MB
+    u64 number_of_entries = 0;
+    {
+        std::ofstream stream(test_file, std::ios::binary | std::ios::trunc);
+        stream << "project_index:\n  projects:\n";
+        u64 written = 0;
+        while (written < target_size) {
+            std::string entry = "  - name: project_" + std::to_string(number_of_entries) + "\n    path: /home/user/workspace/project_" + std::to_string(number_of_entries) + "\n    tag: benchmark\n";
+            stream << entry;
+            written += entry.size();
+            number_of_entries++;
+        }
+    }
+
+    f32 duration = 0.f;
+    AT::util::stopwatch timer(&duration);
+    AT::serializer::yaml_reader reader(test_file);
+    u64 number_of_items = 0;
+    for (auto current = reader.next(); current != AT::serializer::yaml_reader::event::document_end; current = reader.next()) {
+        REQUIRE(current != AT::serializer::yaml_reader::event::error);
+        if (current == AT::serializer::yaml_reader::event::sequence_item)
+            number_of_items++;
+    }
+    timer.stop();
+
+    REQUIRE(number_of_items == number_of_entries);
+
+#if PLATFORM_LINUX
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    WARN("Parsed [" << number_of_items << "] items of a 100 MB document in [" << duration << " ms], peak RSS [" << usage.ru_maxrss / 1024 << " MB]");
+#else
+    WARN("Parsed [" << number_of_items << "] items of a 100 MB document in [" << duration << " ms]");
+#endif
+
+    std::filesystem::remove(test_file);
+}
+
 // ==============================================================================================================================
 // BINARY SERIALIZER
 // ==============================================================================================================================
@@ -1089,10 +1307,1811 @@ TEST_CASE("Binary Serializer - Mixed Data", "[serializer][binary]") {
     REQUIRE(loaded_path == test_path);
 }
 
+TEST_CASE("Binary Serializer - Reflected Fields", "[serializer][binary]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_fields.bin";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    struct reflected_data {
+        int                     count = 0;
+        std::string             label{};
+        std::vector<int>        values{};
+
+        SERIALIZABLE(reflected_data, count, label, values);
+    } test_data{3, "binary", {1, 2, 3}}, loaded_data;
+
+    {
+        AT::serializer::binary(test_file, "reflected", AT::serializer::option::save_to_file)
+            .fields(test_data);
+    }
+
+    {
+        AT::serializer::binary(test_file, "reflected", AT::serializer::option::load_from_file)
+            .fields(loaded_data);
+    }
+
+    REQUIRE(loaded_data.count == test_data.count);
+    REQUIRE(loaded_data.label == test_data.label);
+    REQUIRE(loaded_data.values == test_data.values);
+}
+
+TEST_CASE("Binary Serializer - Sections And Header", "[serializer][binary]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_sections.bin";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    u32 test_first = 0x01020304, loaded_first = 0;
+    std::string test_second = "second section", loaded_second;
+    std::vector<u64> test_third = {1, 2, 3}, loaded_third;
+
+    {
+        AT::serializer::binary(test_file, "first", AT::serializer::option::save_to_file)
+            .entry(test_first);
+    }
+    {
+        AT::serializer::binary(test_file, "second", AT::serializer::option::save_to_file)
+            .entry(test_second);
+    }
+    {   // overwriting a section keeps the others
+        test_first = 0x0A0B0C0D;
+        AT::serializer::binary(test_file, "first", AT::serializer::option::save_to_file)
+            .entry(test_first)
+            .entry(test_third);
+    }
+
+    {
+        AT::serializer::binary loader(test_file, "first", AT::serializer::option::load_from_file);
+        loader.entry(loaded_first)
+            .entry(loaded_third);
+        REQUIRE(loader.is_valid());
+    }
+    {
+        AT::serializer::binary(test_file, "second", AT::serializer::option::load_from_file)
+            .entry(loaded_second);
+    }
+
+    REQUIRE(loaded_first == test_first);
+    REQUIRE(loaded_second == test_second);
+    REQUIRE(loaded_third == test_third);
+
+    // header starts with the magic number and the values are stored little-endian
+    std::ifstream stream(test_file, std::ios::binary);
+    std::vector<u8> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    REQUIRE(bytes.size() > AT::serializer::binary::HEADER_SIZE);
+    REQUIRE(std::string(bytes.begin(), bytes.begin() + 4) == "ATBS");
+    const std::array<u8, 4> little_endian_value = {0x0D, 0x0C, 0x0B, 0x0A};
+    REQUIRE(std::search(bytes.begin(), bytes.end(), little_endian_value.begin(), little_endian_value.end()) != bytes.end());
+
+    {   // missing sections and reads past the end leave values untouched
+        int untouched = 7;
+        AT::serializer::binary missing(test_file, "missing", AT::serializer::option::load_from_file);
+        missing.entry(untouched);
+        REQUIRE_FALSE(missing.is_valid());
+        REQUIRE(untouched == 7);
+
+        std::string untouched_string = "untouched";
+        AT::serializer::binary short_section(test_file, "second", AT::serializer::option::load_from_file);
+        short_section.entry(loaded_second)
+            .entry(untouched_string);
+        REQUIRE_FALSE(short_section.is_valid());
+        REQUIRE(untouched_string == "untouched");
+    }
+}
+
+TEST_CASE("Binary Serializer - Memory Mapped Spans", "[serializer][binary]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_mapped.bin";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    struct alignas(16) vertex {
+        f32 position[3];
+        u32 color;
+    };
+
+    std::vector<vertex> test_vertices(1000);
+    for (size_t x = 0; x < test_vertices.size(); x++)
+        test_vertices[x] = { { static_cast<f32>(x), 1.f, 2.f }, static_cast<u32>(x * 3) };
+    std::vector<u8> test_bytes = {1, 2, 3, 4, 5};
+    const std::string test_name = "thumbnail cache";
+
+    {
+        std::span<const u8> bytes = test_bytes;
+        std::span<const vertex> vertices = test_vertices;
+        std::string name = test_name;
+        AT::serializer::binary(test_file, "cache", AT::serializer::option::save_to_file)
+            .span(bytes)                                    // leaves the following span unaligned without padding
+            .span(vertices)
+            .entry(name);
+    }
+
+    std::span<const vertex> mapped_vertices;
+    AT::ref<AT::io::mapped_file> mapping;
+    {
+        std::span<const u8> bytes;
+        std::string name;
+        AT::serializer::binary loader(test_file, "cache", AT::serializer::option::load_from_file, AT::serializer::binary::load_mode::memory_mapped);
+        loader.span(bytes)
+            .span(mapped_vertices)
+            .entry(name);
+        REQUIRE(loader.is_valid());
+        REQUIRE(std::equal(bytes.begin(), bytes.end(), test_bytes.begin(), test_bytes.end()));
+        REQUIRE(name == test_name);
+        mapping = loader.get_mapping();
+    }
+
+    // the view points into the mapping, is aligned and outlives the serializer through the shared handle
+    REQUIRE(mapping);
+    const auto file = mapping->get_data();
+    const auto* first = reinterpret_cast<const u8*>(mapped_vertices.data());
+    REQUIRE(first >= file.data());
+    REQUIRE(first + mapped_vertices.size_bytes() <= file.data() + file.size());
+    REQUIRE(reinterpret_cast<uintptr_t>(first) % alignof(vertex) == 0);
+    REQUIRE(mapped_vertices.size() == test_vertices.size());
+    REQUIRE(mapped_vertices[999].position[0] == 999.f);
+    REQUIRE(mapped_vertices[999].color == 999 * 3);
+
+    {   // the buffered mode reads the same layout
+        std::span<const u8> bytes;
+        std::span<const vertex> vertices;
+        AT::serializer::binary loader(test_file, "cache", AT::serializer::option::load_from_file);
+        loader.span(bytes)
+            .span(vertices);
+        REQUIRE(loader.is_valid());
+        REQUIRE(loader.get_mapping() == nullptr);
+        REQUIRE(vertices.size() == test_vertices.size());
+        REQUIRE(vertices[10].color == 30);
+    }
+
+    {   // a corrupted count is rejected instead of producing a view past the section
+        std::span<const u8> bytes;
+        std::span<const vertex> vertices;
+        std::span<const u64> too_large;
+        AT::serializer::binary loader(test_file, "cache", AT::serializer::option::load_from_file, AT::serializer::binary::load_mode::memory_mapped);
+        loader.span(bytes)
+            .span(vertices)
+            .span(too_large);
+        REQUIRE_FALSE(loader.is_valid());
+        REQUIRE(too_large.empty());
+    }
+}
+
+TEST_CASE("Binary Serializer - Vector Callbacks And Blocks", "[serializer][binary]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_vector_blocks.bin";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    struct project {
+        std::string name;
+        std::vector<u32> tags;
+        u64 size;
+    };
+
+    auto project_function = [](std::vector<project>& projects) {
+        return [&projects](AT::serializer::binary& serializer, const u64 iteration) {
+            serializer.entry(projects[iteration].name)
+                .entry(projects[iteration].tags)
+                .entry(projects[iteration].size);
+        };
+    };
+
+    // spans several blocks with a partial last block
+    std::vector<project> test_projects(AT::serializer::binary::VECTOR_BLOCK_SIZE * 3 + 17);
+    for (size_t x = 0; x < test_projects.size(); x++)
+        test_projects[x] = { "project_" + std::to_string(x), std::vector<u32>(x % 5, static_cast<u32>(x)), x * 1024 };
+    std::vector<project> empty_projects;
+    u32 test_trailer = 0xCAFE;
+
+    {
+        AT::serializer::binary(test_file, "projects", AT::serializer::option::save_to_file)
+            .vector(test_projects, project_function(test_projects))
+            .vector(empty_projects, project_function(empty_projects))
+            .entry(test_trailer);
+    }
+
+    auto equal = [&](const std::vector<project>& loaded) {
+        REQUIRE(loaded.size() == test_projects.size());
+        for (size_t x = 0; x < loaded.size(); x++) {
+            REQUIRE(loaded[x].name == test_projects[x].name);
+            REQUIRE(loaded[x].tags == test_projects[x].tags);
+            REQUIRE(loaded[x].size == test_projects[x].size);
+        }
+    };
+
+    SECTION("Sequential loading") {
+        std::vector<project> loaded, loaded_empty = {{"stale", {}, 0}};
+        u32 trailer = 0;
+        AT::serializer::binary loader(test_file, "projects", AT::serializer::option::load_from_file);
+        loader.vector(loaded, project_function(loaded))
+            .vector(loaded_empty, project_function(loaded_empty))
+            .entry(trailer);
+        REQUIRE(loader.is_valid());
+        equal(loaded);
+        REQUIRE(loaded_empty.empty());
+        REQUIRE(trailer == test_trailer);
+    }
+
+    SECTION("Parallel loading") {
+        std::vector<project> loaded;
+        u32 trailer = 0;
+        AT::serializer::binary loader(test_file, "projects", AT::serializer::option::load_from_file, AT::serializer::binary::load_mode::memory_mapped);
+        loader.vector(loaded, project_function(loaded), 4)
+            .skip_vector()
+            .entry(trailer);
+        REQUIRE(loader.is_valid());
+        equal(loaded);
+        REQUIRE(trailer == test_trailer);
+    }
+
+    SECTION("Skipping without parsing elements") {
+        u32 trailer = 0;
+        AT::serializer::binary loader(test_file, "projects", AT::serializer::option::load_from_file);
+        loader.skip_vector()
+            .skip_vector()
+            .entry(trailer);
+        REQUIRE(loader.is_valid());
+        REQUIRE(trailer == test_trailer);
+    }
+
+    SECTION("Callbacks reading past their block invalidate the section") {
+        std::vector<project> loaded;
+        AT::serializer::binary loader(test_file, "projects", AT::serializer::option::load_from_file);
+        loader.vector(loaded, [&loaded](AT::serializer::binary& serializer, const u64 iteration) {
+            serializer.entry(loaded[iteration].name)
+                .entry(loaded[iteration].tags)
+                .entry(loaded[iteration].size)
+                .entry(loaded[iteration].name);
+        });
+        REQUIRE_FALSE(loader.is_valid());
+    }
+}
+
+TEST_CASE("LZ4 Block Compression", "[io][compression]") {
+
+    auto round_trip = [](const std::vector<u8>& source) {
+        std::vector<u8> compressed = {0xAB};                // appends behind existing content
+        const size_t compressed_size = AT::io::lz4_compress(source, compressed);
+        REQUIRE(compressed_size == compressed.size() - 1);
+        REQUIRE(compressed_size <= AT::io::lz4_compress_bound(source.size()));
+
+        std::vector<u8> decompressed(source.size());
+        REQUIRE(AT::io::lz4_decompress(std::span<const u8>(compressed).subspan(1), decompressed));
+        REQUIRE(decompressed == source);
+        return compressed_size;
+    };
+
+    SECTION("Edge cases") {
+        round_trip({});
+        round_trip({42});
+        round_trip(std::vector<u8>(13, 7));
+        REQUIRE(round_trip(std::vector<u8>(100000, 7)) < 1000);      // long overlapping matches
+    }
+
+    SECTION("Mixed data") {
+        std::vector<u8> source(200000);
+        for (size_t x = 0; x < source.size(); x++)
+            source[x] = static_cast<u8>((x / 7) % 251) ^ static_cast<u8>(x % 13 == 0 ? x : 0);
+        REQUIRE(round_trip(source) < source.size());
+
+        std::mt19937 generator(42);
+        for (size_t x = 0; x < source.size(); x++)                   // incompressible
+            source[x] = static_cast<u8>(generator());
+        round_trip(source);
+    }
+
+    SECTION("Corrupted input is rejected") {
+        const std::string text = "the quick brown fox jumps over the lazy dog, the quick brown fox jumps over the lazy dog";
+        std::vector<u8> compressed;
+        AT::io::lz4_compress(std::span<const u8>(reinterpret_cast<const u8*>(text.data()), text.size()), compressed);
+
+        std::vector<u8> too_small(text.size() - 1), too_large(text.size() + 1);
+        REQUIRE_FALSE(AT::io::lz4_decompress(compressed, too_small));
+        REQUIRE_FALSE(AT::io::lz4_decompress(compressed, too_large));
+        std::vector<u8> output(text.size());
+        REQUIRE_FALSE(AT::io::lz4_decompress(std::span<const u8>(compressed).first(compressed.size() / 2), output));
+
+        const std::vector<u8> invalid_distance = {0x10, 'a', 0x05, 0x00, 0x00};     // match before the start of the output
+        output.resize(6);
+        REQUIRE_FALSE(AT::io::lz4_decompress(invalid_distance, output));
+    }
+}
+
+TEST_CASE("Binary Serializer - Compressed Sections", "[serializer][binary]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_compressed.bin";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    // several compression blocks, so loading decompresses in parallel
+    std::vector<std::string> test_names(20000);
+    for (size_t x = 0; x < test_names.size(); x++)
+        test_names[x] = "/home/user/projects/project_" + std::to_string(x % 100) + "/project.gltproj";
+    std::mt19937 generator(42);
+    std::vector<u32> test_noise(40000);
+    for (auto& value : test_noise)
+        value = static_cast<u32>(generator());
+    u64 test_trailer = 0x1122334455667788;
+
+    {
+        AT::serializer::binary(test_file, "plain", AT::serializer::option::save_to_file)
+            .entry(test_names);
+    }
+    const auto plain_size = std::filesystem::file_size(test_file);
+    {
+        AT::serializer::binary(test_file, "compressed", AT::serializer::option::save_to_file)
+            .set_compression(AT::serializer::binary::compression_mode::lz4)
+            .entry(test_names)
+            .entry(test_noise)
+            .entry(test_trailer);
+    }
+    // the compressed section is much smaller than the plain one even with incompressible data added
+    REQUIRE(std::filesystem::file_size(test_file) - plain_size < plain_size / 2 + test_noise.size() * sizeof(u32) + 1024);
+
+    for (const auto mode : {AT::serializer::binary::load_mode::buffered, AT::serializer::binary::load_mode::memory_mapped}) {
+        std::vector<std::string> names;
+        std::vector<u32> noise;
+        u64 trailer = 0;
+        AT::serializer::binary loader(test_file, "compressed", AT::serializer::option::load_from_file, mode);
+        loader.entry(names)
+            .entry(noise)
+            .entry(trailer);
+        REQUIRE(loader.is_valid());
+        REQUIRE(names == test_names);
+        REQUIRE(noise == test_noise);
+        REQUIRE(trailer == test_trailer);
+    }
+
+    {   // the uncompressed section is kept untouched
+        std::vector<std::string> names;
+        AT::serializer::binary(test_file, "plain", AT::serializer::option::load_from_file)
+            .entry(names);
+        REQUIRE(names == test_names);
+    }
+}
+
+TEST_CASE("CRC32C Checksum", "[io][checksum]") {
+
+    const std::string check = "123456789";
+    const std::span<const u8> check_bytes(reinterpret_cast<const u8*>(check.data()), check.size());
+    REQUIRE(AT::io::crc32c(check_bytes) == 0xE3069283);         // standard check value of CRC32C
+    REQUIRE(AT::io::crc32c({}) == 0);
+
+    std::vector<u8> data(100003);
+    for (size_t x = 0; x < data.size(); x++)
+        data[x] = static_cast<u8>(x * 31 + 7);
+
+    // computing in parts gives the same checksum, also with unaligned splits
+    const u32 full = AT::io::crc32c(data);
+    for (const size_t split : {size_t(0), size_t(1), size_t(7), size_t(4096), data.size()})
+        REQUIRE(AT::io::crc32c(std::span<const u8>(data).subspan(split), AT::io::crc32c(std::span<const u8>(data).first(split))) == full);
+
+    data[5000] ^= 0x10;
+    REQUIRE(AT::io::crc32c(data) != full);
+}
+
+TEST_CASE("Atomic File Writer", "[io]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_atomic_writer.txt";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    auto read = [&]() {
+        std::ifstream stream(test_file, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    };
+    auto leftover_files = [&]() {
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(test_file.parent_path()))
+            if (entry.path().filename().string().starts_with(test_file.filename().string() + "."))
+                count++;
+        return count;
+    };
+
+    {
+        AT::io::atomic_file_writer writer(test_file);
+        REQUIRE(writer.is_open());
+        REQUIRE(writer.write(std::string_view("first version")));
+        REQUIRE_FALSE(std::filesystem::exists(test_file));         // nothing is visible before commit()
+        REQUIRE(writer.commit());
+    }
+    REQUIRE(read() == "first version");
+
+    {   // without commit() the target keeps its content
+        AT::io::atomic_file_writer writer(test_file);
+        writer.write(std::string_view("lost"));
+    }
+    REQUIRE(read() == "first version");
+
+    {
+        AT::io::atomic_file_writer writer(test_file);
+        writer.write(std::string_view("second "));
+        writer.write(std::string_view("version"));
+        REQUIRE(writer.commit());
+    }
+    REQUIRE(read() == "second version");
+    REQUIRE(leftover_files() == 0);
+
+    {   // a missing directory fails without creating anything
+        AT::io::atomic_file_writer writer(test_file.parent_path() / "missing_directory" / "file.txt");
+        REQUIRE_FALSE(writer.is_open());
+        REQUIRE_FALSE(writer.write(std::string_view("data")));
+        REQUIRE_FALSE(writer.commit());
+    }
+}
+
+TEST_CASE("File Copy With Progress", "[io]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_file_copy";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    std::string content(40 * 1024 * 1024 + 123, '\0');                                 // more than one chunk
+    for (size_t x = 0; x < content.size(); x++)
+        content[x] = static_cast<char>(x * 31 + x / 4096);
+    {
+        std::ofstream stream(root / "source.bin", std::ios::binary);
+        stream.write(content.data(), content.size());
+    }
+
+    auto read = [](const std::filesystem::path& file) {
+        std::ifstream stream(file, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    };
+
+    SECTION("Copies the whole file") {
+        u64 last_progress = 0;
+        REQUIRE(AT::io::copy_file_contents(root / "source.bin", root / "target.bin", [&](const u64 copied) {
+            REQUIRE(copied >= last_progress);
+            last_progress = copied;
+            return true;
+        }));
+        REQUIRE(last_progress == content.size());
+        REQUIRE(read(root / "target.bin") == content);
+    }
+
+    SECTION("Cancelling removes the target") {
+        REQUIRE_FALSE(AT::io::copy_file_contents(root / "source.bin", root / "target.bin", [](const u64) { return false; }));
+        REQUIRE_FALSE(std::filesystem::exists(root / "target.bin"));
+    }
+
+    SECTION("Missing source") {
+        REQUIRE_FALSE(AT::io::copy_file_contents(root / "missing.bin", root / "target.bin"));
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Package", "[io]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_package";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "source" / "content");
+
+    std::string large(AT::io::package_writer::CHUNK_SIZE * 2 + 1234, '\0');              // three chunks, the last one partial
+    for (size_t x = 0; x < large.size(); x++)
+        large[x] = static_cast<char>((x * 7) % 13 + 'a');
+    std::ofstream(root / "source" / "content" / "large.bin", std::ios::binary) << large;
+    std::ofstream(root / "source" / "readme.md") << "readme";
+    std::ofstream(root / "source" / "empty.txt");
+
+    const std::filesystem::path package_file = root / "test.gltpkg";
+    {
+        AT::io::package_writer writer(package_file, 4);
+        REQUIRE(writer.add_file(root / "source" / "content" / "large.bin", "content/large.bin"));
+        REQUIRE(writer.add_file(root / "source" / "readme.md", "readme.md"));
+        REQUIRE(writer.add_file(root / "source" / "empty.txt", "empty.txt"));
+        const std::string note = "from memory";
+        REQUIRE(writer.add_data(std::span<const u8>(reinterpret_cast<const u8*>(note.data()), note.size()), "note.txt"));
+        REQUIRE_FALSE(std::filesystem::exists(package_file));                                   // written to a temporary file until finish()
+        REQUIRE(writer.finish());
+    }
+
+    SECTION("Random access by name") {
+        AT::io::package_reader reader(package_file);
+        REQUIRE(reader.is_valid());
+        REQUIRE(reader.get_entries().size() == 4);
+        REQUIRE(reader.get_entries()[0].chunk_count == 3);
+        REQUIRE_FALSE(reader.find("missing.txt").has_value());
+
+        std::vector<u8> content;
+        REQUIRE(reader.read(*reader.find("readme.md"), content));
+        REQUIRE(std::string(content.begin(), content.end()) == "readme");
+        REQUIRE(reader.read(*reader.find("content/large.bin"), content));
+        REQUIRE(std::string(content.begin(), content.end()) == large);
+        REQUIRE(reader.read(*reader.find("empty.txt"), content));
+        REQUIRE(content.empty());
+    }
+
+    SECTION("Extract selected files") {
+        AT::io::package_reader reader(package_file);
+        const std::vector<u32> selected = { *reader.find("content/large.bin"), *reader.find("note.txt") };
+        u64 reported = 0;
+        std::mutex reported_mutex;                                                              // called on the extracting threads
+        REQUIRE(reader.extract(selected, root / "extracted", 2, [&](const u64 bytes) { std::lock_guard lock(reported_mutex); reported = std::max(reported, bytes); return true; }));
+        REQUIRE(reported == large.size() + 11);
+        REQUIRE(std::filesystem::file_size(root / "extracted" / "content" / "large.bin") == large.size());
+        REQUIRE(std::filesystem::exists(root / "extracted" / "note.txt"));
+        REQUIRE_FALSE(std::filesystem::exists(root / "extracted" / "readme.md"));
+    }
+
+    SECTION("Unsafe names are rejected") {
+        AT::io::package_writer writer(root / "unsafe.gltpkg");
+        REQUIRE_FALSE(writer.add_file(root / "source" / "readme.md", "../outside.md"));
+        REQUIRE_FALSE(writer.finish());
+        REQUIRE_FALSE(std::filesystem::exists(root / "unsafe.gltpkg"));
+    }
+
+    SECTION("Corruption is detected") {
+        {
+            std::fstream stream(package_file, std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekp(AT::io::package_writer::HEADER_SIZE + 100);
+            stream.put('\x7f');
+        }
+        AT::io::package_reader reader(package_file);
+        REQUIRE(reader.is_valid());                                                             // the index is intact
+        std::vector<u8> content;
+        REQUIRE_FALSE(reader.read(*reader.find("content/large.bin"), content));
+        REQUIRE_FALSE(reader.extract(*reader.find("content/large.bin"), root / "corrupted.bin"));
+        REQUIRE_FALSE(std::filesystem::exists(root / "corrupted.bin"));
+
+        std::filesystem::resize_file(package_file, std::filesystem::file_size(package_file) - 1);  // truncated: no trailer
+        REQUIRE_FALSE(AT::io::package_reader(package_file).is_valid());
+    }
+
+    SECTION("Crafted indices are rejected") {
+        // one file "a.bin" of 16 bytes that do not compress, stored in one raw chunk
+        const std::filesystem::path crafted_file = root / "crafted.gltpkg";
+        {
+            AT::io::package_writer writer(crafted_file, 1);
+            const std::string content = "0123456789abcdef";
+            REQUIRE(writer.add_data(std::span<const u8>(reinterpret_cast<const u8*>(content.data()), content.size()), "a.bin"));
+            REQUIRE(writer.finish());
+        }
+        const std::string original = AT::io::read_file(crafted_file);
+        REQUIRE(AT::io::package_reader(crafted_file).is_valid());
+
+        // changes a value of the index and stores a matching index checksum, like a crafted package would
+        auto craft = [&](const size_t field, const u64 value, const size_t value_size) {
+            std::string content = original;
+            u64 index_offset = 0;
+            std::memcpy(&index_offset, content.data() + content.size() - AT::io::package_writer::TRAILER_SIZE, sizeof(u64));
+            const size_t name_end = static_cast<size_t>(index_offset) + 8 + 5;                 // file count, name length, "a.bin"
+            std::memcpy(content.data() + name_end + field, &value, value_size);
+
+            const size_t index_size = content.size() - AT::io::package_writer::TRAILER_SIZE - static_cast<size_t>(index_offset);
+            const u32 checksum = AT::io::crc32c(std::span<const u8>(reinterpret_cast<const u8*>(content.data()) + index_offset, index_size));
+            std::memcpy(content.data() + content.size() - AT::io::package_writer::TRAILER_SIZE + 16, &checksum, sizeof(u32));
+            std::ofstream(crafted_file, std::ios::binary | std::ios::trunc) << content;
+            return AT::io::package_reader(crafted_file).is_valid();
+        };
+
+        REQUIRE_FALSE(craft(12, ~u64(0) - 7, sizeof(u64)));                                      // offset + chunk size wraps around
+        REQUIRE_FALSE(craft(0, ~u64(0), sizeof(u64)));                                          // size + chunk size wraps around
+        REQUIRE_FALSE(craft(24, AT::io::package_writer::STORED_UNCOMPRESSED | 0x7FFFFFFF, sizeof(u32)));   // chunk past the index
+        REQUIRE(craft(0, 16, sizeof(u64)));                                                     // unchanged values are still accepted
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Binary Serializer - Checksums", "[serializer][binary]") {
+    std::filesystem::path test_file = std::filesystem::temp_directory_path() / "test_checksums.bin";
+    
+    if (std::filesystem::exists(test_file))
+        std::filesystem::remove(test_file);
+
+    std::string test_first = "first section content";
+    std::vector<u64> test_second(1000, 0x0102030405060708);
+    {
+        AT::serializer::binary(test_file, "first", AT::serializer::option::save_to_file)
+            .entry(test_first);
+    }
+    {
+        AT::serializer::binary(test_file, "second", AT::serializer::option::save_to_file)
+            .entry(test_second);
+    }
+
+    // flip one bit inside the payload of the second section
+    std::vector<u8> bytes;
+    {
+        std::ifstream stream(test_file, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    bytes[bytes.size() - 100] ^= 0x04;
+    {
+        std::ofstream stream(test_file, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    for (const auto mode : {AT::serializer::binary::load_mode::buffered, AT::serializer::binary::load_mode::memory_mapped}) {
+        std::vector<u64> second;
+        AT::serializer::binary loader(test_file, "second", AT::serializer::option::load_from_file, mode);
+        loader.entry(second);
+        REQUIRE_FALSE(loader.is_valid());
+        REQUIRE(second.empty());
+
+        std::string first;
+        AT::serializer::binary(test_file, "first", AT::serializer::option::load_from_file, mode)
+            .entry(first);
+        REQUIRE(first == test_first);
+    }
+
+    {   // saving drops the corrupted section and keeps the intact one
+        u32 test_third = 3;
+        AT::serializer::binary(test_file, "third", AT::serializer::option::save_to_file)
+            .entry(test_third);
+
+        std::string first;
+        std::vector<u64> second;
+        AT::serializer::binary(test_file, "first", AT::serializer::option::load_from_file)
+            .entry(first);
+        AT::serializer::binary missing(test_file, "second", AT::serializer::option::load_from_file);
+        missing.entry(second);
+        REQUIRE(first == test_first);
+        REQUIRE_FALSE(missing.is_valid());
+    }
+}
+
+TEST_CASE("Config Store", "[config]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_config_store";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / CONFIG_DIR);
+
+    const std::filesystem::path launcher_file = AT::config::get_filepath_from_configtype_ini(root, AT::config::file::launcher);
+    {
+        std::ofstream stream(launcher_file, std::ios::binary);
+        stream << "; comment is kept\r\n[window]\r\nwidth = 1280\r\nheight=720\r\n\r\n[theme]\r\nname=dark\r\n";
+    }
+    AT::config::init(root);
+
+    auto read = [](const std::filesystem::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    };
+
+    SECTION("Reads from memory") {
+        std::string value;
+        REQUIRE(AT::config::get(AT::config::file::launcher, "window", "width", value));
+        REQUIRE(value == "1280");
+        REQUIRE(AT::config::get(AT::config::file::launcher, "theme", "name", value));
+        REQUIRE(value == "dark");
+        REQUIRE_FALSE(AT::config::get(AT::config::file::launcher, "theme", "width", value));
+        REQUIRE(value == "dark");
+
+        std::vector<AT::config::entry> entries = {
+            { "window", "height" },
+            { "window", "missing", "default" },
+        };
+        REQUIRE(AT::config::get_many(AT::config::file::launcher, entries) == 1);
+        REQUIRE(entries[0].found);
+        REQUIRE(entries[0].value == "720");
+        REQUIRE_FALSE(entries[1].found);
+        REQUIRE(entries[1].value == "default");
+    }
+
+    SECTION("Writes are collected and flushed") {
+        const auto before = read(launcher_file);
+        AT::config::set(AT::config::file::launcher, "window", "width", "1920");
+        AT::config::set_many(AT::config::file::launcher, {
+            { "window", "height", "1080" },
+            { "fonts", "size", "15" },
+        });
+        REQUIRE(read(launcher_file) == before);                 // nothing is written before the flush delay
+
+        std::string value;
+        REQUIRE(AT::config::get(AT::config::file::launcher, "fonts", "size", value));
+        REQUIRE(value == "15");
+
+        AT::config::flush();
+        REQUIRE(read(launcher_file) == "; comment is kept\n[window]\nwidth=1920\nheight=1080\n\n[theme]\nname=dark\n[fonts]\nsize=15\n");
+    }
+
+    SECTION("Background flush after the delay") {
+        const auto before = read(launcher_file);
+        AT::config::set(AT::config::file::launcher, "general", "long_startup_process", "true");
+
+        const auto deadline = std::chrono::steady_clock::now() + AT::config::FLUSH_DELAY * 10;
+        while (read(launcher_file) == before && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(read(launcher_file).ends_with("[general]\nlong_startup_process=true\n"));
+    }
+
+    SECTION("YAML files are not stored") {
+        const std::filesystem::path ui_file = AT::config::get_filepath_from_configtype(root, AT::config::file::ui);
+        {
+            std::ofstream stream(ui_file, std::ios::binary);
+            stream << "theme:\n  name: dark\n";
+        }
+
+        std::string value = "unchanged";
+        REQUIRE_FALSE(AT::config::get(AT::config::file::ui, "theme", "name", value));
+        REQUIRE(value == "unchanged");
+        AT::config::set(AT::config::file::ui, "theme", "name", "light");
+        REQUIRE_FALSE(AT::config::check_for_configuration(AT::config::file::input, "keys", "jump", value, true));
+
+        AT::config::flush();
+        REQUIRE(read(ui_file) == "theme:\n  name: dark\n");   // owned by serializer::yaml
+        REQUIRE(read(AT::config::get_filepath_from_configtype(root, AT::config::file::input)).empty());
+    }
+
+    SECTION("check_for_configuration") {
+        std::string value = "fallback";
+        REQUIRE_FALSE(AT::config::check_for_configuration(AT::config::file::launcher, "keys", "jump", value, false));
+        REQUIRE(value == "fallback");                           // appended with the given value
+
+        value = "other";
+        REQUIRE(AT::config::check_for_configuration(AT::config::file::launcher, "keys", "jump", value, false));
+        REQUIRE(value == "fallback");
+
+        value = "space";
+        REQUIRE(AT::config::check_for_configuration(AT::config::file::launcher, "keys", "jump", value, true));
+        AT::config::get(AT::config::file::launcher, "keys", "jump", value);
+        REQUIRE(value == "space");
+    }
+
+    AT::config::shutdown();
+}
+
+TEST_CASE("Config Typed Keys", "[config]") {
+    namespace keys = AT::config::keys;
+    static_assert(std::is_same_v<decltype(AT::config::get(keys::dashboard::sidebar_width)), f32>);
+    static_assert(keys::dashboard::sidebar_width.hash == AT::config::hash_key("dashboard", "sidebar_width"));
+
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_config_typed_keys";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / CONFIG_DIR);
+
+    const std::filesystem::path launcher_file = AT::config::get_filepath_from_configtype_ini(root, AT::config::file::launcher);
+    {
+        std::ofstream stream(launcher_file, std::ios::binary);
+        stream << "[dashboard]\nsidebar_width = 96.5\nproject_card_width=wide\n";
+    }
+    AT::config::init(root);
+
+    SECTION("Values are parsed on load") {
+        REQUIRE(AT::config::get(keys::dashboard::sidebar_width) == 96.5f);
+        REQUIRE(AT::config::get(keys::dashboard::project_card_width) == keys::dashboard::project_card_width.default_value);     // invalid
+        REQUIRE(AT::config::get(keys::dashboard::project_card_height) == keys::dashboard::project_card_height.default_value);   // missing
+    }
+
+    SECTION("Both APIs update each other") {
+        AT::config::set(keys::dashboard::project_card_height, 300);
+        REQUIRE(AT::config::get(keys::dashboard::project_card_height) == 300.f);
+
+        std::string value;
+        REQUIRE(AT::config::get(AT::config::file::launcher, "dashboard", "project_card_height", value));
+        REQUIRE(value == "300");
+
+        AT::config::set(AT::config::file::launcher, "dashboard", "sidebar_width", "64.25");
+        REQUIRE(AT::config::get(keys::dashboard::sidebar_width) == 64.25f);
+
+        AT::config::flush();
+        std::ifstream stream(launcher_file, std::ios::binary);
+        const std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        REQUIRE(content == "[dashboard]\nsidebar_width=64.25\nproject_card_width=wide\nproject_card_height=300\n");
+    }
+
+    SECTION("Reading from many threads") {
+        const f32 before = AT::config::get(keys::dashboard::sidebar_width);
+        std::vector<std::thread> threads;
+        std::atomic<u32> mismatches = 0;
+        for (int x = 0; x < 4; x++)
+            threads.emplace_back([&]() {
+                for (int y = 0; y < 10000; y++) {
+                    const f32 width = AT::config::get(keys::dashboard::sidebar_width);
+                    if (width != before && width != 120.f)
+                        mismatches++;
+                }
+            });
+        AT::config::set(keys::dashboard::sidebar_width, 120.f);
+        for (auto& thread : threads)
+            thread.join();
+        REQUIRE(mismatches == 0);
+        REQUIRE(AT::config::get(keys::dashboard::sidebar_width) == 120.f);
+    }
+
+    AT::config::shutdown();
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("File Watcher", "[io]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_file_watcher";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    auto write = [](const std::filesystem::path& path, const std::string& content) {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        stream << content;
+    };
+
+    // waits up to [timeout] for [counter] to reach [expected], then a little longer to catch extra notifications
+    auto wait_for = [](const std::atomic<u32>& counter, const u32 expected, const std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (counter < expected && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        return counter.load();
+    };
+
+    SECTION("Bursts of writes are reported once") {
+        const std::filesystem::path file = root / "burst.txt";
+        write(file, "initial");
+
+        std::atomic<u32> calls = 0;
+        AT::io::file_watcher watcher(std::chrono::milliseconds(100));
+        const u32 id = watcher.watch(file, [&](const std::filesystem::path& changed) {
+            if (changed == file.lexically_normal())                 // assertions are not made on the watcher thread
+                calls++;
+        });
+        REQUIRE(id != 0);
+
+        for (int x = 0; x < 5; x++)
+            write(file, "content " + std::to_string(x));
+        write(root / "unrelated.txt", "not watched");
+        REQUIRE(wait_for(calls, 1) == 1);
+
+        AT::io::atomic_file_writer writer(file);              // replaced by a rename
+        writer.write(std::string_view("replaced"));
+        REQUIRE(writer.commit());
+        REQUIRE(wait_for(calls, 2) == 2);
+
+        watcher.unwatch(id);
+        write(file, "after unwatch");
+        REQUIRE(wait_for(calls, 3, std::chrono::milliseconds(300)) == 2);
+    }
+
+    SECTION("Files that do not exist yet") {
+        const std::filesystem::path file = root / "created_later.txt";
+        std::atomic<u32> calls = 0;
+        AT::io::file_watcher watcher(std::chrono::milliseconds(50));
+        REQUIRE(watcher.watch(file, [&](const std::filesystem::path&) { calls++; }) != 0);
+        REQUIRE(watcher.watch(root / "missing_directory" / "file.txt", [](const std::filesystem::path&) {}) == 0);
+
+        write(file, "created");
+        REQUIRE(wait_for(calls, 1) == 1);
+    }
+
+    SECTION("Config subscriptions") {
+        std::filesystem::create_directories(root / CONFIG_DIR);
+        AT::config::init(root);
+        const std::filesystem::path launcher_file = AT::config::get_filepath_from_configtype_ini(root, AT::config::file::launcher);
+        const std::filesystem::path ui_file = AT::config::get_filepath_from_configtype(root, AT::config::file::ui);
+        write(ui_file, "theme:\n  name: dark\n");
+
+        std::atomic<u32> calls = 0;
+        const u32 id = AT::config::subscribe(AT::config::file::launcher, [&](AT::config::file changed) {
+            if (changed == AT::config::file::launcher)
+                calls++;
+        });
+        REQUIRE(id != 0);
+
+        std::atomic<u32> ui_calls = 0;
+        const u32 ui_id = AT::config::subscribe(AT::config::file::ui, [&](AT::config::file) { ui_calls++; });
+        REQUIRE(ui_id != 0);
+
+        AT::config::set(AT::config::file::launcher, "theme", "name", "dark");
+        AT::config::flush();
+        REQUIRE(wait_for(calls, 1, std::chrono::milliseconds(400)) == 0);     // own writes are not reported
+
+        write(launcher_file, "[theme]\nname=light\n");                      // edited by another program
+        REQUIRE(wait_for(calls, 1) == 1);
+
+        std::string value;
+        REQUIRE(AT::config::get(AT::config::file::launcher, "theme", "name", value));
+        REQUIRE(value == "light");
+
+        write(ui_file, "theme:\n  name: light\n");                          // YAML files are only reported
+        REQUIRE(wait_for(ui_calls, 1) == 1);
+        REQUIRE(AT::io::read_file(ui_file) == "theme:\n  name: light\n");
+
+        AT::config::unsubscribe(ui_id);
+        AT::config::unsubscribe(id);
+        AT::config::shutdown();
+    }
+
+    SECTION("Directory trees") {
+        const std::filesystem::path project = root / "project";
+        std::filesystem::create_directories(project / "content" / "meshes");
+        std::filesystem::create_directories(project / ".git");
+
+        std::atomic<u32> calls = 0;
+        AT::io::file_watcher watcher(std::chrono::milliseconds(100));
+        const u32 id = watcher.watch_directory(project, true, [&](const std::filesystem::path& changed) {
+            if (changed == project.lexically_normal())
+                calls++;
+        }, { ".git" });
+        REQUIRE(id != 0);
+        REQUIRE(watcher.watch_directory(root / "missing_directory", true, [](const std::filesystem::path&) {}) == 0);
+
+        // many changes in several directories (like a checkout) are reported once
+        for (int x = 0; x < 20; x++)
+            write(project / "content" / "meshes" / ("mesh_" + std::to_string(x) + ".bin"), "data");
+        write(project / "project.gltproj", "changed");
+        REQUIRE(wait_for(calls, 1) == 1);
+
+        write(project / ".git" / "index", "skipped");
+        REQUIRE(wait_for(calls, 2, std::chrono::milliseconds(300)) == 1);
+
+        // directories created after watch_directory() are watched as well
+        std::filesystem::create_directories(project / "content" / "textures");
+        REQUIRE(wait_for(calls, 2) == 2);
+        write(project / "content" / "textures" / "albedo.png", "data");
+        REQUIRE(wait_for(calls, 3) == 3);
+
+        std::filesystem::remove(project / "project.gltproj");
+        REQUIRE(wait_for(calls, 4) == 4);
+
+        watcher.unwatch(id);
+        write(project / "content" / "after_unwatch.txt", "data");
+        REQUIRE(wait_for(calls, 5, std::chrono::milliseconds(300)) == 4);
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Directory Crawler", "[io]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_directory_crawler";
+    std::filesystem::remove_all(root);
+
+    // a wide and deep tree, with matches in skipped folders that must not be reported
+    std::set<std::filesystem::path> expected;
+    for (int x = 0; x < 20; x++) {
+        std::filesystem::path directory = root / ("folder_" + std::to_string(x));
+        for (int depth = 0; depth < x % 5; depth++)
+            directory /= "level_" + std::to_string(depth);
+        std::filesystem::create_directories(directory);
+
+        for (int y = 0; y < 30; y++)
+            std::ofstream(directory / ("file_" + std::to_string(y) + ".txt")) << "data";
+
+        std::ofstream(directory / ("project_" + std::to_string(x) + ".gltproj")) << "project";
+        expected.insert((directory / ("project_" + std::to_string(x) + ".gltproj")).lexically_normal());
+    }
+    for (const char* skipped : { ".git", "bin", "build" }) {
+        std::filesystem::create_directories(root / "folder_0" / skipped / "nested");
+        std::ofstream(root / "folder_0" / skipped / "nested" / "hidden.gltproj") << "project";
+    }
+#if defined(PLATFORM_LINUX)
+    std::filesystem::create_directory_symlink(root, root / "folder_1" / "loop");     // not followed
+#endif
+
+    auto is_project = [](std::string_view name) { return name.ends_with(".gltproj"); };
+
+    SECTION("Finds all matches on several threads") {
+        std::mutex mutex;
+        std::set<std::filesystem::path> found;
+        AT::io::directory_crawler crawler(4);
+        REQUIRE(crawler.start({ root }, is_project, [&](const std::filesystem::path& file) {
+            std::lock_guard lock(mutex);
+            found.insert(file);
+        }));
+        crawler.wait();
+
+        REQUIRE_FALSE(crawler.is_running());
+        REQUIRE(found == expected);
+
+        const auto statistics = crawler.get_statistics();
+        REQUIRE(statistics.matches == expected.size());
+        REQUIRE(statistics.files == expected.size() + 20 * 30);
+        REQUIRE(statistics.errors == 0);
+    }
+
+    SECTION("Skipped directories can be changed") {
+        std::atomic<u32> count = 0;
+        AT::io::directory_crawler crawler(2);
+        crawler.set_skipped_directories({ "bin" });
+        crawler.start({ root / "folder_0" }, is_project, [&](const std::filesystem::path&) { count++; });
+        crawler.wait();
+        REQUIRE(count == 3);                                    // the project, .git and build
+    }
+
+    SECTION("Cancel and restart") {
+        std::atomic<u32> count = 0;
+        AT::io::directory_crawler crawler(2);
+        crawler.start({ root }, is_project, [&](const std::filesystem::path&) { count++; });
+        if (crawler.is_running())
+            REQUIRE_FALSE(crawler.start({ root }, is_project, [](const std::filesystem::path&) {}));
+        crawler.cancel();
+        crawler.wait();
+        REQUIRE_FALSE(crawler.is_running());
+
+        count = 0;
+        REQUIRE(crawler.start({ root, root / "missing" }, is_project, [&](const std::filesystem::path&) { count++; }));
+        crawler.wait();
+        REQUIRE(count == expected.size());
+    }
+
+    SECTION("Finishing without roots is reported on a crawler thread") {
+        std::atomic<bool> finished = false;
+        std::thread::id finished_thread{};
+        AT::io::directory_crawler crawler(2);
+        REQUIRE(crawler.start({ root / "missing" }, is_project, [](const std::filesystem::path&) {}, [&]() {
+            finished_thread = std::this_thread::get_id();
+            finished = true;
+        }));
+        crawler.wait();
+        REQUIRE(finished);
+        REQUIRE(finished_thread != std::this_thread::get_id());
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+// ==============================================================================================================================
+// PROJECT INDEX
+// ==============================================================================================================================
+
+// Fields of a [project_data] for the project tests, the fields that are left empty are derived from [display_name].
+struct test_project {
+    std::string                     display_name{};
+    std::string                     name{};                         // [display_name] if empty
+    std::filesystem::path           project_path{};                 // "/projects/<name>" if empty
+    std::vector<std::string>        tags{};
+    AT::version                     engine_version{ 0, 3, 1 };
+    u16                             day = 1;                        // of [last_modified] in March 2025
+    u64                             id = 0;                         // a random ID if 0
+};
+
+static AT::project_data make_project(test_project values) {
+    AT::project_data data{};
+    data.display_name = values.display_name;
+    data.name = values.name.empty() ? values.display_name : values.name;
+    data.project_path = values.project_path.empty() ? std::filesystem::path("/projects/" + data.name) : values.project_path;
+    data.tags = std::move(values.tags);
+    data.engine_version = values.engine_version;
+    data.last_modified = { 2025, 3, static_cast<u8>(values.day), 0, 12, 0, 0, 0 };
+    if (values.id)
+        data.ID = AT::UUID(values.id);
+    return data;
+}
+
+TEST_CASE("Project Index", "[project]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_project_index";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    const std::filesystem::path index_file = root / "project_index.bin";
+
+    auto write_project = [&](const std::string& name, const std::string& display_name) {
+        std::filesystem::create_directories(root / name);
+        AT::project_data data{};
+        data.name = name;
+        data.display_name = display_name;
+        data.tags = { "tag_" + name, "demo" };
+        const std::filesystem::path project_file = root / name / (name + PROJECT_EXTENTION);
+        data.serialize_project_file(project_file, AT::serializer::option::save_to_file);
+        return project_file;
+    };
+
+    const std::filesystem::path first = write_project("first", "First Project");
+    const std::filesystem::path second = write_project("second", "Second Project");
+
+    {
+        AT::project_index index(index_file);
+        REQUIRE_FALSE(index.load());                            // no index yet
+
+        index.begin_scan();
+        const auto parsed = index.update(first);
+        REQUIRE(parsed.has_value());
+        REQUIRE(parsed->display_name == "First Project");
+        REQUIRE(parsed->project_path == root / "first");
+        REQUIRE(index.update(second).has_value());
+        REQUIRE_FALSE(index.update(first).has_value());         // stamp unchanged, not parsed again
+        REQUIRE_FALSE(index.update(root / "missing.gltproj").has_value());
+        index.save();
+    }
+
+    SECTION("Loads without parsing project files") {
+        AT::project_index index(index_file);
+        REQUIRE(index.load());
+        REQUIRE(index.get_project_count() == 2);
+
+        auto projects = index.get_projects();
+        std::sort(projects.begin(), projects.end(), [](const AT::project_data& a, const AT::project_data& b) { return a.name < b.name; });
+        REQUIRE(projects[0].display_name == "First Project");
+        REQUIRE(projects[0].tags == std::vector<std::string>{ "tag_first", "demo" });
+        REQUIRE(projects[1].display_name == "Second Project");
+
+        index.begin_scan();
+        REQUIRE_FALSE(index.update(first).has_value());
+        REQUIRE_FALSE(index.update(second).has_value());
+    }
+
+    SECTION("Rescans only report changes") {
+        AT::project_index index(index_file);
+        REQUIRE(index.load());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        write_project("second", "Renamed Project");             // changed
+        const std::filesystem::path third = write_project("third", "Third Project");
+        std::filesystem::remove(first);                         // deleted
+
+        const u32 scan = index.begin_scan();
+        REQUIRE(index.update(third).has_value());               // found by the scan
+
+        std::vector<AT::project_data> changed;
+        std::vector<std::filesystem::path> removed;
+        index.finish_scan(scan, changed, removed);              // [second] was not found by the scan but still exists
+        REQUIRE(changed.size() == 1);
+        REQUIRE(changed[0].display_name == "Renamed Project");
+        REQUIRE(removed == std::vector<std::filesystem::path>{ root / "first" });
+        REQUIRE(index.get_project_count() == 2);
+
+        index.save();
+        AT::project_index reloaded(index_file);
+        REQUIRE(reloaded.load());
+        REQUIRE(reloaded.get_project_count() == 2);
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Project Search", "[project]") {
+    std::vector<AT::project_data> projects = {
+        make_project({ .display_name = "Space Shooter", .name = "space_shooter", .project_path = "/home/user/projects/space_shooter", .tags = { "arcade" } }),
+        make_project({ .display_name = "Forest Walk", .name = "forest_walk", .project_path = "/home/user/projects/forest_walk" }),
+        make_project({ .display_name = "Spaceship Editor", .name = "ship_editor", .project_path = "/home/user/tools/ship_editor", .tags = { "tool" } }),
+        make_project({ .display_name = "Puzzle", .name = "puzzle", .project_path = "/home/user/projects/puzzle", .tags = { "casual" } }),
+    };
+
+    AT::project_search search;
+    search.rebuild(projects);
+    auto results = [&](std::string_view query) {
+        const std::span<const u32> found = search.search(query);
+        return std::vector<u32>(found.begin(), found.end());
+    };
+
+    SECTION("Empty query returns all projects in order") {
+        REQUIRE(results("") == std::vector<u32>{ 0, 1, 2, 3 });
+        REQUIRE(results("   ") == std::vector<u32>{ 0, 1, 2, 3 });
+    }
+
+    SECTION("Fuzzy matches are ranked") {
+        REQUIRE(results("xyz").empty());
+        REQUIRE(results("SPACE") == std::vector<u32>{ 0, 2 });            // case is ignored, equal scores keep the list order
+        REQUIRE(results("spsh").front() == 0);                            // word starts: "SPace SHooter"
+        REQUIRE(results("arcade") == std::vector<u32>{ 0 });              // tags are searched
+        REQUIRE(results("tools") == std::vector<u32>{ 2 });               // and the path
+
+        // word starts and consecutive characters score higher than scattered ones
+        const auto boundary = AT::project_search::score("space shooter", std::vector<u8>(13, 0).data(), "ss");
+        REQUIRE(boundary.has_value());
+        REQUIRE(!AT::project_search::score("forest", std::vector<u8>(6, 0).data(), "tf").has_value());
+        REQUIRE(AT::project_search::score("abc", std::vector<u8>(3, 0).data(), "abc") > AT::project_search::score("a_b_c", std::vector<u8>(5, 0).data(), "abc"));
+    }
+
+    SECTION("Negative scores rank below positive ones") {
+        const std::string long_gap = "a" + std::string(200, 'x') + "z";
+        REQUIRE(AT::project_search::score(long_gap, std::vector<u8>(long_gap.size(), 0).data(), "az") < 0);
+
+        std::vector<AT::project_data> gaps = {
+            make_project({ .display_name = "Gap", .name = "gap", .project_path = "/g" }),
+            make_project({ .display_name = "Gap Two", .name = "gap_two", .project_path = "/g2" }),
+            make_project({ .display_name = "Az", .name = "az", .project_path = "/az" }),
+        };
+        gaps[0].description = long_gap;
+        gaps[1].description = "a" + std::string(400, 'x') + "z";         // longer gap, lower score
+        search.rebuild(gaps);
+        REQUIRE(results("az") == std::vector<u32>{ 2, 0, 1 });
+    }
+
+    SECTION("Typing narrows the previous results") {
+        REQUIRE(results("s").size() == 4);                                // every path contains an 's'
+        const size_t short_query = results("sp").size();
+        REQUIRE(results("spa").size() <= short_query);
+        REQUIRE(results("spacesh") == std::vector<u32>{ 2, 0 });          // "Spacesh" is one run in "Spaceship Editor"
+        REQUIRE(results("sp").size() == short_query);                     // removing a character searches all projects again
+    }
+
+    SECTION("Incremental updates") {
+        REQUIRE(results("lava").empty());
+        search.append(make_project({ .display_name = "Lava Caves", .name = "lava_caves", .project_path = "/home/user/projects/lava_caves" }));
+        REQUIRE(results("lava") == std::vector<u32>{ 4 });
+
+        search.erase(1);                                                  // indices follow the project list
+        REQUIRE(results("lava") == std::vector<u32>{ 3 });
+
+        search.set(0, make_project({ .display_name = "Lava Racer", .name = "lava_racer", .project_path = "/home/user/projects/lava_racer" }));
+        REQUIRE(results("lava") == std::vector<u32>{ 0, 3 });
+        REQUIRE(search.size() == 4);
+    }
+
+    SECTION("10k projects") {
+        std::vector<AT::project_data> many;
+        for (u32 x = 0; x < 10000; x++)
+            many.push_back(make_project({ .display_name = "Project " + std::to_string(x), .name = "project_" + std::to_string(x), .project_path = "/home/user/projects/project_" + std::to_string(x), .tags = { x % 2 ? "odd" : "even" } }));
+        search.rebuild(many);
+        REQUIRE(results("project").size() == 10000);
+        REQUIRE(results("project 9999").front() == 9999);
+        REQUIRE(results("odd").size() == 5000);
+    }
+}
+
+TEST_CASE("Project Query", "[project]") {
+    const std::vector<AT::project_data> projects = {
+        make_project({ .display_name = "Delta", .tags = { "arcade" }, .engine_version = { 0, 2, 0 }, .day = 4 }),
+        make_project({ .display_name = "alpha", .tags = { "arcade", "demo" }, .day = 9 }),
+        make_project({ .display_name = "Charlie" }),
+        make_project({ .display_name = "Bravo", .tags = { "demo" }, .engine_version = { 0, 2, 0 }, .day = 7 }),
+    };
+
+    AT::project_store store;
+    store.assign(projects);
+    AT::project_query query;
+    query.rebuild(store);
+    auto execute = [&](const AT::project_query::parameters& parameters) {
+        const std::span<const u32> result = query.execute(parameters);
+        return std::vector<u32>(result.begin(), result.end());
+    };
+
+    SECTION("Packed keys keep the order") {
+        const AT::system_time earlier{ 2024, 12, 31, 2, 23, 59, 59, 999 };
+        const AT::system_time later{ 2025, 1, 1, 3, 0, 0, 0, 0 };
+        REQUIRE(earlier < later);
+        REQUIRE(AT::project_query::pack(earlier) < AT::project_query::pack(later));
+        REQUIRE(AT::project_query::pack(AT::version(1, 0, 0)) > AT::project_query::pack(AT::version(0, 65535, 65535)));
+    }
+
+    SECTION("Sorting") {
+        AT::project_query::parameters parameters{};
+        REQUIRE(execute(parameters) == std::vector<u32>{ 1, 3, 0, 2 });                 // newest first
+
+        parameters.sort = AT::project_query::sort_key::name;
+        parameters.descending = false;
+        REQUIRE(execute(parameters) == std::vector<u32>{ 1, 3, 2, 0 });                 // case is ignored
+
+        parameters.sort = AT::project_query::sort_key::engine_version;
+        REQUIRE(execute(parameters) == std::vector<u32>{ 0, 3, 1, 2 });                 // equal keys keep the list order
+    }
+
+    SECTION("Filters and facets") {
+        AT::project_query::parameters parameters{};
+        parameters.required_tags = { "demo" };
+        REQUIRE(execute(parameters) == std::vector<u32>{ 1, 3 });
+        REQUIRE(query.matches(1));
+        REQUIRE(!query.matches(0));
+
+        const auto tags = query.get_tag_facets();
+        REQUIRE(tags.size() == 2);
+        REQUIRE(tags[0].label == "arcade");
+        REQUIRE(tags[0].count == 1);
+        REQUIRE(tags[1].count == 2);
+
+        parameters.engine_version = AT::project_query::pack(AT::version(0, 2, 0));
+        REQUIRE(execute(parameters) == std::vector<u32>{ 3 });
+
+        const auto engines = query.get_engine_version_facets();
+        REQUIRE(engines.size() == 2);
+        REQUIRE(engines[0].label == "0.3.1");                                           // new to old
+        REQUIRE(engines[0].count == 0);
+        REQUIRE(engines[1].count == 1);
+
+        parameters.required_tags = { "unknown" };
+        REQUIRE(execute(parameters).empty());
+    }
+
+    SECTION("Grouping") {
+        AT::project_query::parameters parameters{};
+        parameters.group = AT::project_query::group_key::tag;
+        REQUIRE(execute(parameters) == std::vector<u32>{ 1, 0, 1, 3, 2 });              // projects with two tags are listed twice
+
+        const auto groups = query.get_groups();
+        REQUIRE(groups.size() == 3);
+        REQUIRE(groups[0].label == "arcade");
+        REQUIRE(groups[0].count == 2);
+        REQUIRE(groups[1].first == 2);
+        REQUIRE(groups[2].label == "No tags");
+
+        parameters.group = AT::project_query::group_key::engine_version;
+        REQUIRE(execute(parameters) == std::vector<u32>{ 1, 2, 3, 0 });
+        REQUIRE(query.get_groups().size() == 2);
+        REQUIRE(query.get_groups()[0].label == "0.3.1");
+    }
+
+    SECTION("50k projects") {
+        std::vector<AT::project_data> many;
+        many.reserve(50000);
+        for (u32 x = 0; x < 50000; x++)
+            many.push_back(make_project({ .display_name = "Project " + std::to_string(x), .tags = { "tag_" + std::to_string(x % 100) }, .engine_version = { 0, static_cast<u16>(x % 5), 0 }, .day = static_cast<u16>(1 + x % 28) }));
+        store.assign(many);
+        query.rebuild(store);
+
+        AT::project_query::parameters parameters{};
+        parameters.group = AT::project_query::group_key::tag;
+        REQUIRE(query.execute(parameters).size() == 50000);
+        REQUIRE(query.get_groups().size() == 100);
+
+        parameters.required_tags = { "tag_7" };
+        parameters.sort = AT::project_query::sort_key::name;
+        REQUIRE(query.execute(parameters).size() == 500);
+    }
+}
+
+TEST_CASE("Project Store", "[project]") {
+    AT::project_store store;
+    store.add(make_project({ .display_name = "alpha", .tags = { "arcade", "demo" } }));
+    store.add(make_project({ .display_name = "bravo", .tags = { "demo" } }));
+    store.add(make_project({ .display_name = "charlie" }));
+
+    SECTION("Add, find and erase") {
+        REQUIRE(store.size() == 3);
+        REQUIRE(store.find("/projects/bravo") == 1u);
+        REQUIRE(!store.find("/projects/delta").has_value());
+        REQUIRE(std::string(store.get_display_name(2)) == "charlie");
+
+        store.erase(0);
+        REQUIRE(store.size() == 2);
+        REQUIRE(store.find("/projects/charlie") == 1u);
+        REQUIRE(!store.find("/projects/alpha").has_value());
+    }
+
+    SECTION("Find by ID") {
+        const AT::UUID bravo_id = store.get_id(1);
+        REQUIRE(store.find(bravo_id) == 1u);
+        REQUIRE(!store.find(AT::UUID()).has_value());
+
+        store.erase(0);
+        REQUIRE(store.find(bravo_id) == 0u);                                            // indices behind the erased project move
+
+        AT::project_data replaced = make_project({ .display_name = "bravo" });                            // the project file was replaced by another project
+        store.set(0, replaced);
+        REQUIRE(!store.find(bravo_id).has_value());
+        REQUIRE(store.find(replaced.ID) == 0u);
+
+        store.clear();
+        REQUIRE(!store.find(replaced.ID).has_value());
+    }
+
+    SECTION("Set replaces a project") {
+        AT::project_data renamed = make_project({ .display_name = "bravo", .tags = { "arcade" } });
+        renamed.display_name = "Bravo Two";
+        store.set(1, renamed);
+        REQUIRE(store.size() == 3);
+        REQUIRE(std::string(store.get_display_name(1)) == "Bravo Two");
+        REQUIRE(store.get_tag_bits(1)[0] == 1);                                        // only "arcade"
+    }
+
+    SECTION("Tags are interned") {
+        REQUIRE(store.get_tag_count() == 2);
+        REQUIRE(store.get_tag(0) == "arcade");
+        REQUIRE(store.get_tag_bits(0)[0] == 3);
+        REQUIRE(store.get_tag_bits(1)[0] == 2);
+        REQUIRE(store.get_tag_bits(2)[0] == 0);
+
+        std::vector<std::string> tags;
+        for (u32 x = 0; x < 70; x++)
+            tags.push_back("tag_" + std::to_string(x));
+        store.add(make_project({ .display_name = "delta", .tags = tags }));                                        // more tags than bits in a word
+        REQUIRE(store.get_tag_words() == 2);
+        REQUIRE(store.get_tag_bits(0)[0] == 3);                                        // existing bits survive widening
+        REQUIRE(store.get_tag_bits(3)[1] != 0);
+    }
+
+    SECTION("Data round trip") {
+        const AT::project_data data = store.get_data(0);
+        REQUIRE(data.name == "alpha");
+        REQUIRE(data.project_path == std::filesystem::path("/projects/alpha"));
+        REQUIRE(data.tags == std::vector<std::string>{ "arcade", "demo" });
+        REQUIRE(AT::project_query::pack(data.engine_version) == AT::project_query::pack(AT::version(0, 3, 1)));
+        REQUIRE(std::string(store.c_str(store.get_cold(0).engine_version_text)) == "0-3-1");
+        REQUIRE(std::string(store.get_cold(0).last_modified_text) == "2025-3-1 12:0:0");
+    }
+
+    SECTION("Replaced strings are freed") {
+        AT::project_data edited = make_project({ .display_name = "alpha", .tags = { "arcade", "demo" } });
+        for (u32 x = 0; x < 2000; x++) {                                                // e.g. a long session editing one project
+            edited.description = "description " + std::to_string(x) + std::string(200, 'x');
+            edited.last_modified.secund = static_cast<u8>(x % 60);
+            store.set(0, edited);
+            store.set_last_modified(1, edited.last_modified);
+        }
+
+        REQUIRE(store.get_strings_used_bytes() < 256 * 1024);                          // 2000 descriptions would need ~430KB
+        REQUIRE(store.get_data(0).description == edited.description);
+        REQUIRE(store.get_data(1).name == "bravo");
+        REQUIRE(store.find("/projects/charlie") == 2u);
+        REQUIRE(store.find(edited.ID) == 0u);
+        REQUIRE(store.get_tag(0) == "arcade");                                         // tag ids are kept
+        REQUIRE(store.get_tag_bits(0)[0] == 3);
+        REQUIRE(store.get_tag_bits(1)[0] == 2);
+    }
+
+    SECTION("String pool") {
+        AT::util::string_pool pool;
+        const auto first = pool.intern("first");
+        const char* characters = pool.c_str(first);
+        for (u32 x = 0; x < 20000; x++)                                                 // several blocks
+            pool.intern("string " + std::to_string(x));
+        pool.intern(std::string(100000, 'x'));                                          // a dedicated block
+
+        REQUIRE(pool.intern("first") == first);
+        REQUIRE(pool.c_str(first) == characters);                                       // characters never move
+        REQUIRE(pool.get(pool.intern("string 123")) == "string 123");
+        REQUIRE(pool.find("") == AT::util::string_pool::EMPTY);
+        REQUIRE(!pool.find("missing").has_value());
+
+        pool.clear();
+        REQUIRE(pool.size() == 1);
+        REQUIRE(!pool.find("first").has_value());
+    }
+}
+
+TEST_CASE("Project Conflicts", "[project]") {
+    // the same steps as add_user_project() and remove_user_project(), without the views that mirror the store
+    AT::project_store store;
+    AT::project_conflicts conflicts;
+    std::function<void(const AT::project_data&)> add;
+    auto remove = [&](const std::filesystem::path& project_path) {
+        const std::optional<u32> listed = store.find(project_path);
+        std::optional<AT::UUID> id{};
+        if (listed) {
+            id = store.get_id(*listed);
+            store.erase(*listed);
+        }
+        if (const std::optional<AT::project_data> promoted = conflicts.remove(project_path, id))
+            add(*promoted);
+    };
+    add = [&](const AT::project_data& data) {
+        if (const auto listed_path = AT::project_conflicts::find_original(store, data)) {
+            remove(data.project_path);
+            conflicts.add(data, *listed_path);
+        } else if (const auto listed = store.find(data.project_path))
+            store.set(*listed, data);
+        else
+            store.add(data);
+    };
+
+    std::vector<AT::project_data> loaded = { make_project({ .display_name = "project", .project_path = "/projects/first", .id = 1 }), make_project({ .display_name = "project", .project_path = "/projects/copy_a", .id = 1 }), make_project({ .display_name = "project", .project_path = "/projects/other", .id = 2 }), make_project({ .display_name = "project", .project_path = "/projects/copy_b", .id = 1 }) };
+    conflicts.assign(loaded);
+    store.assign(loaded);
+
+    SECTION("Copies are not listed when loaded") {
+        REQUIRE(loaded.size() == 2);
+        REQUIRE(loaded[0].project_path == "/projects/first");
+        REQUIRE(loaded[1].project_path == "/projects/other");
+        REQUIRE(conflicts.size() == 2);
+        for (const auto& conflict : conflicts.get())
+            REQUIRE(conflict.listed_path == "/projects/first");
+
+        REQUIRE_FALSE(AT::project_conflicts::find_original(store, make_project({ .display_name = "project", .project_path = "/projects/first", .id = 1 })).has_value());      // a listed project that changed
+        REQUIRE_FALSE(AT::project_conflicts::find_original(store, make_project({ .display_name = "project", .project_path = "/projects/new", .id = 3 })).has_value());
+        REQUIRE(AT::project_conflicts::find_original(store, make_project({ .display_name = "project", .project_path = "/projects/copy_c", .id = 2 })) == std::filesystem::path("/projects/other"));
+    }
+
+    SECTION("A project file replaced by a copy is not listed") {
+        add(make_project({ .display_name = "project", .project_path = "/projects/other", .id = 1 }));                          // "other" now has the ID of "first"
+        REQUIRE(store.size() == 1);
+        REQUIRE_FALSE(store.find("/projects/other").has_value());
+        REQUIRE(conflicts.size() == 3);
+        REQUIRE(conflicts.get().back().data.project_path == "/projects/other");
+        REQUIRE(conflicts.get().back().listed_path == "/projects/first");
+
+        add(make_project({ .display_name = "project", .project_path = "/projects/other", .id = 1 }));                          // found again: the conflict is replaced
+        REQUIRE(conflicts.size() == 3);
+    }
+
+    SECTION("Removing the listed project lists its first copy") {
+        remove("/projects/first");
+        REQUIRE(store.size() == 2);
+        REQUIRE(store.find(AT::UUID(1)) == store.find("/projects/copy_a"));
+        REQUIRE(conflicts.size() == 1);
+        REQUIRE(conflicts.get()[0].data.project_path == "/projects/copy_b");
+        REQUIRE(conflicts.get()[0].listed_path == "/projects/copy_a");  // the other copies refer to the listed one
+
+        remove("/projects/copy_a");
+        REQUIRE(store.find(AT::UUID(1)) == store.find("/projects/copy_b"));
+        REQUIRE(conflicts.empty());
+    }
+
+    SECTION("Removing a copy keeps the listed project") {
+        remove("/projects/copy_a");
+        REQUIRE(store.size() == 2);
+        REQUIRE(conflicts.size() == 1);
+        REQUIRE(conflicts.get()[0].data.project_path == "/projects/copy_b");
+    }
+}
+
+TEST_CASE("Project Statistics", "[project]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_project_statistics";
+    std::filesystem::remove_all(root);
+    const std::filesystem::path project_path = root / "project";
+    std::filesystem::create_directories(project_path / CONTENT_DIR / "meshes");
+    std::filesystem::create_directories(project_path / CONTENT_DIR / "textures" / "ui");
+    std::filesystem::create_directories(project_path / PROJECT_TEMP_DLL_PATH);
+
+    auto write = [](const std::filesystem::path& file, const size_t size) { std::ofstream(file, std::ios::binary) << std::string(size, 'x'); };
+    write(project_path / CONTENT_DIR / "meshes" / "tree.glb", 5000);
+    write(project_path / CONTENT_DIR / "textures" / "bark.PNG", 3000);
+    write(project_path / CONTENT_DIR / "textures" / "ui" / "button.png", 100);
+    write(project_path / CONTENT_DIR / "bark.mat", 10);
+    write(project_path / CONTENT_DIR / "notes.txt", 10);
+    write(project_path / PROJECT_TEMP_DLL_PATH / "project.so", 10);
+
+    AT::project_data data{};
+    data.name = "project";
+    const std::filesystem::path project_file = project_path / "project.gltproj";
+    data.serialize_project_file(project_file, AT::serializer::option::save_to_file);
+
+    SECTION("Asset types") {
+        using type = AT::project_statistics_indexer::asset_type;
+        REQUIRE(AT::project_statistics_indexer::get_asset_type("tree.GLTF") == type::mesh);
+        REQUIRE(AT::project_statistics_indexer::get_asset_type("a.b.ktx2") == type::texture);
+        REQUIRE(AT::project_statistics_indexer::get_asset_type("wood.material") == type::material);
+        REQUIRE(AT::project_statistics_indexer::get_asset_type("readme") == type::other);
+        REQUIRE(AT::project_statistics_indexer::get_asset_type("file.verylongextension") == type::other);
+    }
+
+    SECTION("Computed in the background") {
+        AT::project_statistics_indexer indexer(2);
+        indexer.request(project_path, {});
+        indexer.request(project_path, {});                                              // queued once
+
+        std::vector<AT::project_statistics_indexer::result> results;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (results.empty() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            indexer.collect(results);
+        }
+        REQUIRE(results.size() == 1);
+
+        const AT::project_statistics& statistics = results[0].statistics;
+        REQUIRE(results[0].project_file == project_file);
+        REQUIRE(statistics.valid);
+        REQUIRE(statistics.file_count == 5);
+        REQUIRE(statistics.mesh_count == 1);
+        REQUIRE(statistics.texture_count == 2);
+        REQUIRE(statistics.material_count == 1);
+        REQUIRE(statistics.disk_usage >= 8000);
+        REQUIRE(statistics.last_build > 0);
+    }
+
+    SECTION("Cached in the project index") {
+        const std::filesystem::path index_file = root / "project_index.bin";
+        AT::project_statistics statistics{};
+        statistics.disk_usage = 1234;
+        statistics.mesh_count = 3;
+        statistics.valid = true;
+        {
+            AT::project_index index(index_file);
+            REQUIRE(index.update(project_file).has_value());
+            REQUIRE(index.set_statistics(project_file, statistics));
+            index.save();
+        }
+
+        AT::project_index index(index_file);
+        REQUIRE(index.load());
+        REQUIRE(index.get_projects()[0].statistics.disk_usage == 1234);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        data.description = "changed";
+        data.serialize_project_file(project_file, AT::serializer::option::save_to_file);
+        const auto changed = index.update(project_file);                                // parsed again, the statistics are kept
+        REQUIRE(changed.has_value());
+        REQUIRE(changed->statistics.mesh_count == 3);
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Project Creator", "[project]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_project_creator";
+    std::filesystem::remove_all(root);
+    const std::filesystem::path template_path = root / "template";
+    std::filesystem::create_directories(template_path / "content" / "worlds");
+    std::filesystem::create_directories(template_path / ".git");
+    std::ofstream(template_path / "content" / "worlds" / "start.world") << "world data";
+    std::ofstream(template_path / "readme.md") << "template readme";
+    std::ofstream(template_path / ".git" / "HEAD") << "ref";                             // skipped like the discovery does
+    std::ofstream(template_path / "template.gltproj") << "not copied";
+
+    AT::project_data data{};
+    data.name = "new_project";
+    data.display_name = "New Project";
+    data.project_path = root / "new_project";
+
+    AT::project_creator creator;
+    std::filesystem::path created_file{};
+
+    SECTION("Creates the project from the template") {
+        REQUIRE(creator.start(data, template_path, [&](const std::filesystem::path& project_file) { created_file = project_file; }));
+        creator.wait();
+
+        const auto progress = creator.get_progress();
+        REQUIRE(progress.state == AT::project_creator::stage::finished);
+        REQUIRE(progress.total_files == 2);
+        REQUIRE(progress.copied_bytes == progress.total_bytes);
+        REQUIRE(progress.get_fraction() == 1.f);
+        REQUIRE(created_file == data.project_path / "new_project.gltproj");
+
+        REQUIRE(std::filesystem::is_directory(data.project_path / CONTENT_DIR));
+        REQUIRE(std::filesystem::is_directory(data.project_path / SOURCE_DIR));
+        REQUIRE(std::filesystem::is_directory(data.project_path / CONFIG_DIR));
+        REQUIRE(std::filesystem::exists(data.project_path / "content" / "worlds" / "start.world"));
+        REQUIRE_FALSE(std::filesystem::exists(data.project_path / ".git"));
+        REQUIRE_FALSE(std::filesystem::exists(data.project_path / "template.gltproj"));
+
+        AT::project_data loaded{};
+        loaded.serialize_project_file(created_file, AT::serializer::option::load_from_file);
+        REQUIRE(loaded.display_name == "New Project");
+        REQUIRE(loaded.project_path == data.project_path);
+    }
+
+    SECTION("Only empty folders are used") {
+        std::filesystem::create_directories(data.project_path);
+        std::ofstream(data.project_path / "existing.txt") << "keep";
+        REQUIRE_FALSE(creator.start(data, template_path));
+        REQUIRE_FALSE(creator.is_running());
+        REQUIRE(std::filesystem::exists(data.project_path / "existing.txt"));
+    }
+
+    SECTION("A failed creation removes what it created") {
+        REQUIRE(creator.start(data, template_path));
+        creator.cancel();
+        creator.wait();
+
+        const auto state = creator.get_progress().state;
+        REQUIRE((state == AT::project_creator::stage::cancelled || state == AT::project_creator::stage::finished));
+        if (state == AT::project_creator::stage::cancelled)
+            REQUIRE_FALSE(std::filesystem::exists(data.project_path));
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Project Archiver", "[project]") {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "test_project_archiver";
+    std::filesystem::remove_all(root);
+    for (const std::string name : { "alpha", "bravo" }) {
+        std::filesystem::create_directories(root / "projects" / name / "content");
+        std::filesystem::create_directories(root / "projects" / name / ".git");
+        std::ofstream(root / "projects" / name / (name + ".gltproj")) << name;
+        std::ofstream(root / "projects" / name / "content" / "level.world") << "world of " << name;
+        std::ofstream(root / "projects" / name / ".git" / "HEAD") << "ref";                     // skipped like the discovery does
+    }
+
+    const std::filesystem::path package_file = root / "projects.gltpkg";
+    AT::project_archiver archiver;
+    REQUIRE(archiver.start_export({ root / "projects" / "alpha", root / "projects" / "bravo" }, package_file));
+    archiver.wait();
+    REQUIRE(archiver.get_progress().state == AT::project_archiver::stage::finished);
+    REQUIRE(archiver.get_progress().total_files == 4);
+    REQUIRE(AT::project_archiver::list_projects(package_file) == std::vector<std::string>{ "alpha", "bravo" });
+
+    SECTION("Imports the selected projects") {
+        std::vector<std::filesystem::path> imported{};
+        REQUIRE(archiver.start_import(package_file, root / "imported", { "bravo" }, [&](const std::vector<std::filesystem::path>& project_files) { imported = project_files; }));
+        archiver.wait();
+
+        REQUIRE(archiver.get_progress().state == AT::project_archiver::stage::finished);
+        REQUIRE(imported == std::vector<std::filesystem::path>{ root / "imported" / "bravo" / "bravo.gltproj" });
+        REQUIRE(std::filesystem::exists(root / "imported" / "bravo" / "content" / "level.world"));
+        REQUIRE_FALSE(std::filesystem::exists(root / "imported" / "bravo" / ".git"));
+        REQUIRE_FALSE(std::filesystem::exists(root / "imported" / "alpha"));
+    }
+
+    SECTION("Existing projects are not overwritten") {
+        std::filesystem::create_directories(root / "imported" / "alpha");
+        std::ofstream(root / "imported" / "alpha" / "keep.txt") << "keep";
+        REQUIRE(archiver.start_import(package_file, root / "imported"));
+        archiver.wait();
+
+        REQUIRE(archiver.get_progress().state == AT::project_archiver::stage::failed);
+        REQUIRE(std::filesystem::exists(root / "imported" / "alpha" / "keep.txt"));
+        REQUIRE_FALSE(std::filesystem::exists(root / "imported" / "bravo"));
+    }
+
+    std::filesystem::remove_all(root);
+}
+
 // ==============================================================================================================================
 // STOPWATCH
 // ==============================================================================================================================
 
+TEST_CASE("Dependency Graph", "[project]") {
+    auto define = [](const std::string& name, std::vector<std::string> dependencies, AT::version min_engine = {}, AT::version max_engine = {}) {
+        AT::dependency_definition definition{};
+        definition.name = name;
+        definition.dependencies = std::move(dependencies);
+        definition.min_engine_version = min_engine;
+        definition.max_engine_version = max_engine;
+        return definition;
+    };
+
+    AT::dependency_graph graph;
+    graph.set_definitions({
+        define("physics", { "core", "math" }),
+        define("core", {}, AT::version(1, 0, 0), AT::version(1, 9, 9)),
+        define("math", { "core" }),
+        define("audio", { "core" }),
+        define("network", { "core" }, AT::version(2, 0, 0)),
+        define("loop_a", { "loop_b" }),
+        define("loop_b", { "loop_a" }),
+        define("uses_loop", { "loop_a" }),
+        define("broken", { "unknown" }),
+        define("core", { "audio" }),                            // defined twice, ignored
+    });
+    graph.set_engine_versions({ AT::version(1, 2, 0), AT::version(2, 1, 0) });
+    REQUIRE(graph.get_definition_count() == 9);
+
+    auto project = [](std::vector<std::string> plugins, std::vector<std::string> libraries = {}, AT::version engine = AT::version(1, 2, 0)) {
+        AT::project_data data{};
+        data.engine_version = engine;
+        data.engine_plugins = std::move(plugins);
+        data.external_libraries = std::move(libraries);
+        return data;
+    };
+
+    auto names = [&graph](const std::vector<u32>& ids) {
+        std::vector<std::string> result;
+        for (const u32 id : ids)
+            result.push_back(graph.get_definition(id).name);
+        return result;
+    };
+
+    SECTION("Orders dependencies before their users") {
+        const AT::project_data data = project({ "physics", "audio" }, { "math" });
+        const auto& resolution = graph.resolve(data);
+        REQUIRE(resolution.is_resolved());
+        const std::vector<std::string> order = names(resolution.load_order);
+        REQUIRE(order.size() == 4);
+        REQUIRE(order.front() == "core");
+        auto position = [&order](const std::string& name) { return std::find(order.begin(), order.end(), name) - order.begin(); };
+        REQUIRE(position("math") < position("physics"));
+    }
+
+    SECTION("Reports problems") {
+        REQUIRE(graph.resolve(project({ "network" })).state == AT::dependency_graph::status::incompatible);
+        REQUIRE(graph.resolve(project({ "network" }, {}, AT::version(2, 1, 0))).state == AT::dependency_graph::status::incompatible);     // [core] ends at 1.9.9
+        REQUIRE(graph.resolve(project({ "uses_loop", "audio" })).state == AT::dependency_graph::status::cycle);
+        REQUIRE(graph.resolve(project({ "audio" }, { "broken" })).state == AT::dependency_graph::status::missing);
+        REQUIRE(graph.resolve(project({ "not_defined" })).state == AT::dependency_graph::status::missing);
+        REQUIRE(graph.resolve(project({ "audio" }, {}, AT::version(1, 3, 0))).state == AT::dependency_graph::status::engine_not_installed);
+
+        const auto& resolution = graph.resolve(project({ "network", "not_defined" }));
+        REQUIRE(resolution.state == AT::dependency_graph::status::missing);                                                         // the worst problem
+        REQUIRE(resolution.problems.size() == 2);
+    }
+
+    SECTION("Resolves unchanged projects once") {
+        std::vector<AT::project_data> projects;
+        for (u32 x = 0; x < 300; x++)
+            projects.push_back(project(x % 2 ? std::vector<std::string>{ "physics" } : std::vector<std::string>{ "audio", "math" }));
+
+        for (const auto& data : projects)
+            REQUIRE(graph.resolve(data).is_resolved());
+        REQUIRE(graph.get_resolve_count() == 300);
+
+        for (const auto& data : projects)
+            graph.resolve(data);
+        REQUIRE(graph.get_resolve_count() == 300);              // all cached
+
+        projects[7].engine_plugins.push_back("network");
+        REQUIRE_FALSE(graph.resolve(projects[7]).is_resolved());
+        REQUIRE(graph.get_resolve_count() == 301);              // only the changed project
+
+        graph.set_engine_versions({ AT::version(1, 2, 0) });
+        graph.resolve(projects[0]);
+        REQUIRE(graph.get_resolve_count() == 302);
+    }
+
+    SECTION("Catalog round trip") {
+        const std::filesystem::path catalog = std::filesystem::temp_directory_path() / "test_dependency_catalog.yml";
+        graph.save_catalog(catalog);
+
+        AT::dependency_graph loaded;
+        REQUIRE(loaded.load_catalog(catalog));
+        REQUIRE(loaded.get_definition_count() == 9);
+        REQUIRE(loaded.get_engine_versions().size() == 2);
+        const std::optional<u32> physics = loaded.find("physics");
+        REQUIRE(physics.has_value());
+        REQUIRE(loaded.get_definition(*physics).dependencies == std::vector<std::string>{ "core", "math" });
+        REQUIRE(loaded.get_definition(*loaded.find("core")).max_engine_version.minor == 9);
+        REQUIRE(loaded.resolve(project({ "physics" })).is_resolved());
+        std::filesystem::remove(catalog);
+    }
+}
+
+
 TEST_CASE("Stopwatch functionality", "[stopwatch][timing]") {
 
     SECTION("Basic timing functionality") {
@@ -1387,6 +3406,54 @@ TEST_CASE("DeletionQueue - Thread Safety", "[deletion_queue][thread]") {
 }
 
 
+TEST_CASE("LRU List", "[lru_list]") {
+    AT::util::lru_list<u32> list(3);
+
+    SECTION("Orders by last use") {
+        REQUIRE(list.touch(1));
+        REQUIRE(list.touch(2));
+        REQUIRE(list.touch(3));
+        REQUIRE_FALSE(list.touch(1));                           // already in the list, moved to the front
+        REQUIRE(list.get_keys() == std::vector<u32>{ 1, 3, 2 });
+        REQUIRE(*list.begin() == 1);
+    }
+
+    SECTION("Evicts the least recently used key") {
+        list.touch(1);
+        list.touch(2);
+        list.touch(3);
+        list.touch(1);
+        REQUIRE(list.touch(4));                                 // evicts [2]
+        REQUIRE(list.size() == 3);
+        REQUIRE_FALSE(list.contains(2));
+        REQUIRE(list.get_keys() == std::vector<u32>{ 4, 1, 3 });
+    }
+
+    SECTION("Erase and reuse") {
+        list.touch(1);
+        list.touch(2);
+        list.touch(3);
+        REQUIRE(list.erase(2));
+        REQUIRE_FALSE(list.erase(2));
+        REQUIRE(list.get_keys() == std::vector<u32>{ 3, 1 });
+        REQUIRE(list.erase(3));                                 // head
+        REQUIRE(list.erase(1));                                 // tail
+        REQUIRE(list.empty());
+        REQUIRE(list.begin() == list.end());
+
+        for (u32 x = 10; x < 20; x++)
+            list.touch(x);
+        REQUIRE(list.get_keys() == std::vector<u32>{ 19, 18, 17 });
+
+        list.clear();
+        REQUIRE(list.empty());
+        REQUIRE(list.capacity() == 3);
+        REQUIRE(list.touch(5));
+        REQUIRE(list.get_keys() == std::vector<u32>{ 5 });
+    }
+}
+
+
 
 
 /*